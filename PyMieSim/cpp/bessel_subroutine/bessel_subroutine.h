@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <complex>
+#include <algorithm>
 
 #include "errors.cpp"
 #include "fortran_linkage.cpp"
@@ -499,6 +500,83 @@ namespace Special_ {
     }
 
 
+    inline void compute_Jn_array(int n, const double *x, double *bj, size_t size) {
+
+        // =====================================================
+        // Purpose: Compute Jn(x) of integer order at many real
+        //          arguments at once
+        // Input :  n    --- Order of Jn(x)  ( n >= 0 )
+        //          x    --- Arguments  ( x >= 0 )
+        //          size --- Number of arguments
+        // Output:  BJ(i) --- Jn(x(i))
+        // Method:  Miller's backward recurrence, as in
+        //          compute_Jn_Yn_range, normalized with
+        //          J0 + 2 (J2 + J4 + ...) = 1. The recurrence
+        //          starts at a single order, chosen for the
+        //          largest argument, and runs over blocks of
+        //          arguments so that it vectorizes.
+        // =====================================================
+
+        constexpr size_t block_size = 64;
+
+        double x_max = 0.0;
+        for (size_t i = 0; i < size; ++i)
+            x_max = std::max(x_max, x[i]);
+
+        int m = 0;
+        if (x_max >= 1.0e-100) {
+            m = find_backward_start_Jn_amplitude(x_max, 200);
+            if (m < n) {
+                // Jn is below 1e-200 at every argument
+                for (size_t i = 0; i < size; ++i)
+                    bj[i] = 0.0;
+                m = -1;
+            }
+            else
+                m = std::max(find_backward_start_Jn_accuracy(x_max, std::max(n, 1), 15), n + 1);
+        }
+
+        for (size_t start = 0; start < size && m >= 0; start += block_size) {
+            const size_t count = std::min(block_size, size - start);
+
+            double inv_x[block_size], f1[block_size], f2[block_size], sum[block_size], value[block_size];
+
+            for (size_t i = 0; i < count; ++i) {
+                inv_x[i] = x[start + i] < 1.0e-100 ? 0.0 : 1.0 / x[start + i];
+                f1[i] = 1.0e-100;
+                f2[i] = 0.0;
+                sum[i] = 0.0;
+                value[i] = 0.0;
+            }
+
+            for (int k = m; k >= 0; --k) {
+                const double weight = (k % 2 == 0) ? (k == 0 ? 1.0 : 2.0) : 0.0;
+
+                for (size_t i = 0; i < count; ++i) {
+                    double f = 2.0 * (k + 1.0) * inv_x[i] * f1[i] - f2[i];
+                    double v = (k == n) ? f : value[i];
+                    double s = sum[i] + weight * f;
+                    double f_1 = f1[i];
+
+                    // Small arguments grow the recurrence by 2k / x per order, it is rescaled before overflowing
+                    const double scale = std::abs(f) > 1.0e200 ? 1.0e-200 : 1.0;
+                    f2[i] = f_1 * scale;
+                    f1[i] = f * scale;
+                    sum[i] = s * scale;
+                    value[i] = v * scale;
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                bj[start + i] = inv_x[i] == 0.0 ? (n == 0 ? 1.0 : 0.0) : value[i] / sum[i];
+        }
+
+        if (x_max < 1.0e-100)
+            for (size_t i = 0; i < size; ++i)
+                bj[i] = (n == 0) ? 1.0 : 0.0;
+    }
+
+
     inline void compute_Jn_Yn_with_derivatives(int n, double x, double *bjn, double *djn, double *fjn, double *byn, double *dyn, double *fyn) {
 
         // ===========================================================
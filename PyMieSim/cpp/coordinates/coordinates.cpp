@@ -1,6 +1,41 @@
 #include "coordinates.h"
 
 
+// ---------- Rotation matrices ----------------
+Matrix3 get_axis_rotation_matrix(const char axis, const double angle) {
+    const double c = std::cos(angle), s = std::sin(angle);
+
+    switch (axis) {
+        case 'x':
+            return {{{1, 0, 0}, {0, c, -s}, {0, s, c}}};
+        case 'y':
+            return {{{c, 0, s}, {0, 1, 0}, {-s, 0, c}}};
+        case 'z':
+            return {{{c, -s, 0}, {s, c, 0}, {0, 0, 1}}};
+        default:
+            throw std::invalid_argument("Invalid axis for rotation.");
+    }
+}
+
+Matrix3 compose_rotations(const Matrix3& second, const Matrix3& first) {
+    Matrix3 output{};
+
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            output[i][j] = second[i][0] * first[0][j] + second[i][1] * first[1][j] + second[i][2] * first[2][j];
+
+    return output;
+}
+
+std::array<double, 3> apply_matrix(const Matrix3& matrix, const std::array<double, 3>& vector) {
+    return {
+        matrix[0][0] * vector[0] + matrix[0][1] * vector[1] + matrix[0][2] * vector[2],
+        matrix[1][0] * vector[0] + matrix[1][1] * vector[1] + matrix[1][2] * vector[2],
+        matrix[2][0] * vector[0] + matrix[2][1] * vector[1] + matrix[2][2] * vector[2]
+    };
+}
+
+
 // ---------- Vector Field ----------------
 VectorField::VectorField(const std::vector<double>& vector)
 : sampling(1), shape({1, 3}), data(vector) {}
@@ -52,35 +87,14 @@ void VectorField::normalize() {
 
 // Rotate the vector field about a given axis by an angle
 void VectorField::rotate_about_axis(const char axis, const double angle) {
-    const double c = std::cos(angle);
-    const double s = std::sin(angle);
-    std::vector<std::vector<double>> matrix(3, std::vector<double>(3));
-
-    switch (axis) {
-        case 'x':
-            matrix = {{1, 0, 0}, {0, c, -s}, {0, s, c}};
-            break;
-        case 'y':
-            matrix = {{c, 0, s}, {0, 1, 0}, {-s, 0, c}};
-            break;
-        case 'z':
-            matrix = {{c, -s, 0}, {s, c, 0}, {0, 0, 1}};
-            break;
-        default:
-            throw std::invalid_argument("Invalid axis for rotation.");
-    }
-
-    apply_matrix(matrix);
+    this->apply_matrix(get_axis_rotation_matrix(axis, angle));
 }
 
 // Apply a 3x3 rotation matrix to all vectors in the field
-void VectorField::apply_matrix(const std::vector<std::vector<double>>& matrix) {
-    std::array<double, 3> temp;
+void VectorField::apply_matrix(const Matrix3& matrix) {
     for (size_t i = 0; i < sampling; ++i) {
-        for (size_t j = 0; j < 3; ++j) {
-            temp[j] = matrix[j][0] * at(i, 0) + matrix[j][1] * at(i, 1) + matrix[j][2] * at(i, 2);
-        }
-        std::copy(temp.begin(), temp.end(), &data[i * 3]);
+        const std::array<double, 3> rotated = ::apply_matrix(matrix, {at(i, 0), at(i, 1), at(i, 2)});
+        std::copy(rotated.begin(), rotated.end(), &data[i * 3]);
     }
 }
 
@@ -106,45 +120,39 @@ void Cartesian::set_coordinates_py(const std::vector<double> &x_values, const st
 }
 
 Spherical Cartesian::to_spherical() const {
-    Spherical sph(x.size());
-    for (size_t i = 0; i < x.size(); ++i) {
-        sph.r.push_back(std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]));
-        sph.theta.push_back(std::atan2(y[i], x[i]));
-        sph.phi.push_back(std::asin(z[i] / sph.r[i]));
+    const size_t n_points = x.size();
+
+    Spherical sph;
+    sph.r.resize(n_points);
+    sph.phi.resize(n_points);
+    sph.theta.resize(n_points);
+
+    for (size_t i = 0; i < n_points; ++i) {
+        sph.r[i] = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+        sph.theta[i] = std::atan2(y[i], x[i]);
+        sph.phi[i] = std::asin(z[i] / sph.r[i]);
     }
+
     return sph;
 }
 
 void Cartesian::rotate_about_axis(const char axis, const double angle) {
-    const double c = std::cos(angle), s = std::sin(angle);
-    std::vector<std::vector<double>> matrix;
-
-    switch (axis) {
-        case 'x':
-            matrix = {{1, 0, 0}, {0, c, -s}, {0, s, c}};
-            break;
-        case 'y':
-            matrix = {{c, 0, s}, {0, 1, 0}, {-s, 0, c}};
-            break;
-        case 'z':
-            matrix = {{c, -s, 0}, {s, c, 0}, {0, 0, 1}};
-            break;
-        default:
-            throw std::invalid_argument("Invalid axis for rotation.");
-    }
-    apply_matrix(matrix);
+    this->apply_matrix(get_axis_rotation_matrix(axis, angle));
 }
 
-void Cartesian::apply_matrix(const std::vector<std::vector<double>>& matrix) {
-    double tempx, tempy, tempz;
-    for (size_t i = 0; i < x.size(); i++){
+void Cartesian::apply_matrix(const Matrix3& matrix) {
+    const double
+        m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2],
+        m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2],
+        m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
 
-        tempx = matrix[0][0] * x[i] + matrix[0][1] * y[i] + matrix[0][2] * z[i];
-        tempy = matrix[1][0] * x[i] + matrix[1][1] * y[i] + matrix[1][2] * z[i];
-        tempz = matrix[2][0] * x[i] + matrix[2][1] * y[i] + matrix[2][2] * z[i];
+    double *px = x.data(), *py = y.data(), *pz = z.data();
+
+    for (size_t i = 0; i < x.size(); i++){
+        const double xi = px[i], yi = py[i], zi = pz[i];
 
-        x[i] = tempx;
-        y[i] = tempy;
-        z[i] = tempz;
+        px[i] = m00 * xi + m01 * yi + m02 * zi;
+        py[i] = m10 * xi + m11 * yi + m12 * zi;
+        pz[i] = m20 * xi + m21 * yi + m22 * zi;
     }
 }
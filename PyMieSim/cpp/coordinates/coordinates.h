@@ -5,6 +5,32 @@
 #include <stdexcept>
 
 
+typedef std::array<std::array<double, 3>, 3> Matrix3;  // row-major 3x3 matrix
+
+/**
+ * @brief Returns the matrix of a rotation about one of the coordinate axes.
+ * @param axis The axis to rotate about ('x', 'y', or 'z').
+ * @param angle The angle to rotate by (in radians).
+ * @return The rotation matrix.
+ */
+Matrix3 get_axis_rotation_matrix(const char axis, const double angle);
+
+/**
+ * @brief Composes two rotations into one matrix.
+ * @param second The rotation applied last.
+ * @param first The rotation applied first.
+ * @return The product second * first.
+ */
+Matrix3 compose_rotations(const Matrix3& second, const Matrix3& first);
+
+/**
+ * @brief Applies a matrix to a single vector.
+ * @param matrix The matrix.
+ * @param vector The vector.
+ * @return The product matrix * vector.
+ */
+std::array<double, 3> apply_matrix(const Matrix3& matrix, const std::array<double, 3>& vector);
+
 struct SphericalCoordinate {
     double r = 0.0, phi = 0.0, theta = 0.0;
 };
@@ -103,7 +129,7 @@ struct VectorField {
      * @brief Apply a 3x3 rotation matrix to all vectors in the field.
      * @param matrix The rotation matrix to apply.
      */
-    void apply_matrix(const std::vector<std::vector<double>>& matrix);
+    void apply_matrix(const Matrix3& matrix);
 };
 
 struct Spherical {
@@ -159,9 +185,9 @@ struct Cartesian {
     void rotate_about_axis(const char axis, const double angle);
 
     /**
-     * @brief Apply a 3x3 rotation matrix to all vectors in the field.
-     * @param matrix The rotation matrix to apply.
+     * @brief Apply a 3x3 rotation matrix to all the points in a single pass.
+     * @param matrix The rotation matrix to apply, chained rotations being composed beforehand with compose_rotations.
      */
-    void apply_matrix(const std::vector<std::vector<double>>& matrix);
+    void apply_matrix(const Matrix3& matrix);
 
 };
@@ -1,5 +1,9 @@
 #include "detector.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 
 // ------------------------- Initialization Function -------------------------
 void Detector::initialize(const double &medium_refractive_index) {
@@ -12,21 +16,31 @@ void Detector::initialize(const double &medium_refractive_index) {
     if (this->max_angle < this->min_angle)
         throw std::invalid_argument("Cache NA cannot be larger than detector NA.");
 
+    if (this->quadrature != "fibonacci" && this->quadrature != "gauss_legendre")
+        throw std::invalid_argument("Quadrature must be either 'fibonacci' or 'gauss_legendre'.");
 
-    this->fibonacci_mesh = FibonacciMesh(
-        this->sampling,
-        this->max_angle,
-        this->min_angle,
-        this->phi_offset,
-        this->gamma_offset,
-        this->rotation
-    );
+    this->geometry = DetectorGeometryCache::get_instance().get_geometry(this->get_geometry_key());
+}
 
-    this->scalar_field = this->mode_field.get_unstructured(
-        this->fibonacci_mesh.base_cartesian.x,
-        this->fibonacci_mesh.base_cartesian.y
-    );
+DetectorGeometryKey Detector::get_geometry_key() const {
+    DetectorGeometryKey key;
+    key.sampling = this->sampling;
+    key.max_angle = this->max_angle;
+    key.min_angle = this->min_angle;
+    key.phi_offset = this->phi_offset;
+    key.gamma_offset = this->gamma_offset;
+    key.rotation = this->rotation;
+    key.quadrature = this->quadrature;
+    key.mode_id = this->mode_id;
+
+    return key;
+}
+
+void Detector::set_scalar_field(std::vector<complex128> scalar_field) {
+    if (scalar_field.size() != this->get_scalar_field().size())
+        throw std::invalid_argument("Scalar field must hold one value per mesh point.");
 
+    this->geometry = std::make_shared<const DetectorGeometry>(this->geometry->mesh, std::move(scalar_field));
 }
 
 // ------------------------- Utils Functions -------------------------
@@ -55,71 +69,6 @@ double Detector::numercical_aperture_to_angle(double numerical_aperture) const {
     return 1.0;
 }
 
-template <class T> inline
-double Detector::get_norm1_squared(const std::vector<T> &array) const
-{
-    T sum  = 0.0;
-
-    for (auto v : array)
-        sum += v;
-
-    return pow(abs(sum), 2);
-}
-
-template <class T> inline
-double Detector::get_norm2_squared(const std::vector<T> &array) const
-{
-    T sum  = 0.0;
-
-    for (auto v : array)
-    sum += pow( abs(v), 2 );
-
-    return abs(sum);
-}
-
-
-template <class T> inline
-void Detector::square_array(std::vector<T> &array)
-{
-    for (T &v : array)
-        v = pow( abs(v), 2);
-}
-
-
-std::tuple<std::vector<complex128>, std::vector<complex128>>
-Detector::get_projected_farfields(const std::vector<complex128> &theta_field, const std::vector<complex128> &phi_field) const
-{
-
-    std::vector<complex128>
-        horizontal_projection(theta_field.size()),
-        vertical_projection(theta_field.size());
-
-    for (size_t i=0; i<theta_field.size(); ++i)
-    {
-        vertical_projection[i] =
-            theta_field[i] * this->fibonacci_mesh.vertical_perpendicular_projection[i] +
-            phi_field[i] * this->fibonacci_mesh.vertical_parallel_projection[i] ;  // new_version
-
-
-
-        horizontal_projection[i] =
-            theta_field[i] * this->fibonacci_mesh.horizontal_perpendicular_projection[i] +
-            phi_field[i] * this->fibonacci_mesh.horizontal_parallel_projection[i] ; // new_version
-    }
-
-    return std::make_tuple(horizontal_projection, vertical_projection);
-
-}
-
-
-void Detector::apply_scalar_field(std::vector<complex128> &field0, std::vector<complex128> &field1) const //Theta = Para
-{
-    for (size_t i=0; i<field0.size(); i++) {
-        field0[i] *= this->scalar_field[i];
-        field1[i] *= this->scalar_field[i];
-    }
-}
-
 template <typename T> inline
 void Detector::apply_polarization_filter(T &coupling_theta, T &coupling_phi, double polarization_filter) const
 {
@@ -172,7 +121,7 @@ std::vector<complex128> Detector::get_structured_scalarfield(const size_t sampli
 }
 
 std::vector<double> Detector::get_poynting_field(const BaseScatterer& scatterer, double distance) const {
-    auto [Ephi, Etheta] = scatterer.compute_unstructured_farfields(this->fibonacci_mesh, distance);
+    auto [Ephi, Etheta] = scatterer.compute_unstructured_farfields(this->get_mesh(), distance, this->interpolation_tolerance);
 
     double electric_field_norm = 0.0;
     double magnetic_field_norm = 0.0;
@@ -191,32 +140,92 @@ std::vector<double> Detector::get_poynting_field(const BaseScatterer& scatterer,
 
 double Detector::get_energy_flow(const BaseScatterer& scatterer, double distance) const {
     std::vector<double> poynting_vector = this->get_poynting_field(scatterer, distance);
+    const std::vector<double>& weights = this->get_mesh().quadrature_weights;
 
-    double dA = distance * distance * this->fibonacci_mesh.dOmega;  // units of m^2
+    // Each point covers distance^2 times its solid angle, in m^2
+    double energy_flow = 0.0;
+    for (size_t i = 0; i < poynting_vector.size(); ++i)
+        energy_flow += poynting_vector[i] * weights[i];
 
-    return 0.5 * trapz(poynting_vector, dA); // units of W
+    return 0.5 * distance * distance * energy_flow; // units of W
 }
 
 // ------------------------- Coupling Function -------------------------
 double Detector::get_coupling(const BaseScatterer& scatterer) const {
+    if (this->coupling_tolerance > 0.0)
+        return this->get_adaptive_coupling(scatterer).coupling;
+
     if (this->is_coherent)
         return this->mean_coupling ? get_coupling_mean_coherent(scatterer) : get_coupling_point_coherent(scatterer);
     else
         return this->mean_coupling ? get_coupling_mean_no_coherent(scatterer) : get_coupling_point_no_coherent(scatterer);
 }
 
+double Detector::get_coupling(const BaseScatterer& scatterer, const std::vector<complex128>& S1, const std::vector<complex128>& S2) const {
+    if (this->is_coherent)
+        return this->get_coupling_coherent(scatterer, S1, S2, !this->mean_coupling);
+    else
+        return this->get_coupling_no_coherent(scatterer, S1, S2);
+}
+
+double Detector::get_coupling(const BaseScatterer& scatterer, const complex128 horizontal_sum, const complex128 vertical_sum) const {
+    const double propagator_norm = std::norm(scatterer.get_propagator(1.0));
+
+    double
+        coupling_theta = propagator_norm * std::norm(horizontal_sum),
+        coupling_phi = propagator_norm * std::norm(vertical_sum);
+
+    this->apply_polarization_filter(
+        coupling_theta,
+        coupling_phi,
+        this->polarization_filter
+    );
+
+    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) / this->get_mesh().dOmega;
+}
+
+bool Detector::uses_mesh_amplitudes(const BaseScatterer& scatterer) const {
+    if (this->coupling_tolerance > 0.0)
+        return false;
+
+    if (!scatterer.has_spherical_amplitudes())
+        return true;
+
+    // Point coherent couplings go through the coherent weights, on-axis photodiodes through the exact quadrature
+    return this->is_coherent ? this->mean_coupling : !this->is_on_axis();
+}
+
 
 double Detector::get_coupling_mean_coherent(const BaseScatterer &scatterer) const
 {
-    auto [theta_field, phi_field] = scatterer.compute_unstructured_farfields(this->fibonacci_mesh, 1.0);
+    auto [S1, S2] = scatterer.compute_mesh_amplitudes(this->get_mesh(), this->interpolation_tolerance);
+
+    return this->get_coupling_coherent(scatterer, S1, S2, false);
+}
+
+
+double Detector::get_coupling_mean_no_coherent(const BaseScatterer &scatterer) const
+{
+    return get_coupling_point_no_coherent(scatterer);
+}
+
+double Detector::get_coupling_point_coherent(const BaseScatterer &scatterer) const
+{
+    if (scatterer.has_spherical_amplitudes())
+        return this->get_coupling_point_coherent_spherical(scatterer);
+
+    auto [S1, S2] = scatterer.compute_mesh_amplitudes(this->get_mesh(), this->interpolation_tolerance);
 
-    auto [horizontal_projection, vertical_projection] = this->get_projected_farfields(theta_field, phi_field);
+    return this->get_coupling_coherent(scatterer, S1, S2, true);
+}
 
-    this->apply_scalar_field(horizontal_projection, vertical_projection);
+double Detector::get_coupling_coherent(const BaseScatterer &scatterer, const std::vector<complex128> &S1, const std::vector<complex128> &S2, const bool coherent_sum) const
+{
+    const std::array<double, 2> coupling = this->get_mesh_coupling(scatterer, S1, S2, coherent_sum);
 
     double
-        coupling_theta = this->get_norm2_squared(horizontal_projection),
-        coupling_phi = this->get_norm2_squared(vertical_projection);
+        coupling_theta = coupling[0],
+        coupling_phi = coupling[1];
 
     this->apply_polarization_filter(
         coupling_theta,
@@ -224,26 +233,102 @@ double Detector::get_coupling_mean_coherent(const BaseScatterer &scatterer) cons
         this->polarization_filter
     );
 
-    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) * this->fibonacci_mesh.dOmega / this->fibonacci_mesh.Omega;
+    // Point: |sum of w E m|^2 / dOmega, the mode being normalized to a unit sum of w / dOmega |m|^2
+    // Mean: sum of w |E m|^2 / Omega
+    const double normalization = coherent_sum ? this->get_mesh().dOmega : this->get_mesh().Omega;
+
+    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) / normalization;
 }
 
+std::array<double, 2> Detector::get_mesh_coupling(const BaseScatterer &scatterer, const std::vector<complex128> &S1, const std::vector<complex128> &S2, const bool coherent_sum) const
+{
+    const JonesVector& jones_vector = scatterer.source.jones_vector;
+    const std::vector<double>& real_scalar_field = this->geometry->real_scalar_field;
+    const std::vector<complex128>& scalar_field = this->get_scalar_field();
+    const bool is_real = !real_scalar_field.empty();
 
-double Detector::get_coupling_mean_no_coherent(const BaseScatterer &scatterer) const
+    std::array<double, 2> coupling = coherent_sum
+        ? (is_real ? this->get_projected_coupling<true>(S1, S2, jones_vector, real_scalar_field) : this->get_projected_coupling<true>(S1, S2, jones_vector, scalar_field))
+        : (is_real ? this->get_projected_coupling<false>(S1, S2, jones_vector, real_scalar_field) : this->get_projected_coupling<false>(S1, S2, jones_vector, scalar_field));
+
+    // The propagator is common to every point
+    const double propagator_norm = std::norm(scatterer.get_propagator(1.0));
+    coupling[0] *= propagator_norm;
+    coupling[1] *= propagator_norm;
+
+    return coupling;
+}
+
+template <bool coherent_sum, typename ModeType>
+std::array<double, 2> Detector::get_projected_coupling(
+    const std::vector<complex128> &S1,
+    const std::vector<complex128> &S2,
+    const JonesVector &jones_vector,
+    const std::vector<ModeType> &mode) const
 {
-    return get_coupling_point_no_coherent(scatterer);
+    const FibonacciMesh& mesh = this->get_mesh();
+    const std::vector<double>& theta = mesh.spherical.theta;
+    const std::vector<double>& weights = mesh.quadrature_weights;
+
+    complex128 horizontal_sum = 0.0, vertical_sum = 0.0;
+    double horizontal_norm = 0.0, vertical_norm = 0.0;
+
+    for (size_t i = 0; i < theta.size(); ++i) {
+        const double cos_theta = cos(theta[i]), sin_theta = sin(theta[i]);
+
+        // Fields of BaseScatterer::compute_unstructured_farfields, without the propagator
+        const complex128
+            perpendicular_field = S1[i] * (jones_vector[0] * cos_theta + jones_vector[1] * sin_theta),
+            parallel_field = S2[i] * (jones_vector[0] * sin_theta - jones_vector[1] * cos_theta);
+
+        const ModeType
+            horizontal_perpendicular = mode[i] * mesh.horizontal_perpendicular_projection[i],
+            horizontal_parallel = mode[i] * mesh.horizontal_parallel_projection[i],
+            vertical_perpendicular = mode[i] * mesh.vertical_perpendicular_projection[i],
+            vertical_parallel = mode[i] * mesh.vertical_parallel_projection[i];
+
+        const complex128
+            horizontal = perpendicular_field * horizontal_perpendicular + parallel_field * horizontal_parallel,
+            vertical = perpendicular_field * vertical_perpendicular + parallel_field * vertical_parallel;
+
+        if constexpr (coherent_sum) {
+            horizontal_sum += weights[i] * horizontal;
+            vertical_sum += weights[i] * vertical;
+        } else {
+            horizontal_norm += weights[i] * std::norm(horizontal);
+            vertical_norm += weights[i] * std::norm(vertical);
+        }
+    }
+
+    if constexpr (coherent_sum)
+        return {std::norm(horizontal_sum), std::norm(vertical_sum)};
+    else
+        return {horizontal_norm, vertical_norm};
 }
 
-double Detector::get_coupling_point_coherent(const BaseScatterer &scatterer) const
+double Detector::get_coupling_point_coherent_spherical(const BaseScatterer &scatterer) const
 {
-    auto [theta_field, phi_field] = scatterer.compute_unstructured_farfields(this->fibonacci_mesh, 1.0);
+    scatterer.ensure_coefficients();
 
-    auto [horizontal_projection, vertical_projection] = this->get_projected_farfields(theta_field, phi_field);
+    const CoherentWeights& coherent_weights = this->get_coherent_weights(scatterer.max_order);
 
-    this->apply_scalar_field(horizontal_projection, vertical_projection);
+    // sums[2 * projection + component], the Jones vector is applied once at the end
+    std::array<complex128, 4> sums = {0., 0., 0., 0.};
+
+    for (size_t m = 0; m < scatterer.max_order; ++m) {
+        const complex128 *weights = &coherent_weights.weights[8 * m];
+        const complex128 a = scatterer.an[m], b = scatterer.bn[m];
+
+        for (size_t k = 0; k < 4; ++k)
+            sums[k] += a * weights[2 * k] + b * weights[2 * k + 1];
+    }
+
+    const JonesVector& jones_vector = scatterer.source.jones_vector;
+    const complex128 propagator = scatterer.get_propagator(1.0);
 
     double
-        coupling_theta = get_norm1_squared(horizontal_projection),
-        coupling_phi = get_norm1_squared(vertical_projection);
+        coupling_theta = std::norm(propagator * (jones_vector[0] * sums[0] + jones_vector[1] * sums[1])),
+        coupling_phi = std::norm(propagator * (jones_vector[0] * sums[2] + jones_vector[1] * sums[3]));
 
     this->apply_polarization_filter(
         coupling_theta,
@@ -251,16 +336,190 @@ double Detector::get_coupling_point_coherent(const BaseScatterer &scatterer) con
         this->polarization_filter
     );
 
-    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) * this->fibonacci_mesh.dOmega;
+    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) / this->get_mesh().dOmega;
+}
+
+const CoherentWeights& Detector::get_coherent_weights(const size_t max_order) const
+{
+    return this->geometry->coherent_weights.get(
+        [&](const CoherentWeights& weights) {return weights.max_order >= max_order;},
+        [&](const CoherentWeights* weights) {
+            return this->compute_coherent_weights(std::max(max_order, weights ? 2 * weights->max_order : size_t(0)));
+        }
+    );
+}
+
+CoherentWeights Detector::compute_coherent_weights(const size_t max_order) const
+{
+    constexpr size_t block_size = 64;
+    const FibonacciMesh& mesh = this->get_mesh();
+    const std::vector<complex128>& scalar_field = this->get_scalar_field();
+    const std::vector<double>
+        &phi = mesh.spherical.phi,
+        &theta = mesh.spherical.theta;
+    const size_t n_points = phi.size();
+
+    CoherentWeights output;
+    output.max_order = max_order;
+    output.weights.assign(8 * max_order, 0.0);
+
+    // Mode-weighted projections of the S1 (u) and S2 (v) contributions, [2 * projection + component][point]
+    std::array<std::array<complex128, block_size>, 4> u, v;
+    std::array<double, block_size> mu, pi_previous, pi_current;
+
+    for (size_t start = 0; start < n_points; start += block_size) {
+        const size_t width = std::min(block_size, n_points - start);
+
+        for (size_t i = 0; i < block_size; ++i) {
+            if (i >= width) {  // padded lanes contribute nothing
+                mu[i] = 0.0;
+                for (size_t k = 0; k < 4; ++k)
+                    u[k][i] = v[k][i] = 0.0;
+                continue;
+            }
+
+            const size_t p = start + i;
+            const complex128 mode = scalar_field[p] * mesh.quadrature_weights[p];
+            const double cos_theta = cos(theta[p]), sin_theta = sin(theta[p]);
+
+            // The S1 field carries jones[0] cos(theta) + jones[1] sin(theta), the S2 field jones[0] sin(theta) - jones[1] cos(theta)
+            u[0][i] = mode * cos_theta * mesh.horizontal_perpendicular_projection[p];
+            u[1][i] = mode * sin_theta * mesh.horizontal_perpendicular_projection[p];
+            u[2][i] = mode * cos_theta * mesh.vertical_perpendicular_projection[p];
+            u[3][i] = mode * sin_theta * mesh.vertical_perpendicular_projection[p];
+            v[0][i] = mode * sin_theta * mesh.horizontal_parallel_projection[p];
+            v[1][i] = -mode * cos_theta * mesh.horizontal_parallel_projection[p];
+            v[2][i] = mode * sin_theta * mesh.vertical_parallel_projection[p];
+            v[3][i] = -mode * cos_theta * mesh.vertical_parallel_projection[p];
+
+            mu[i] = cos(phi[p] - PI / 2.0);
+        }
+
+        for (size_t m = 0; m < max_order; ++m) {
+            const double
+                c0 = (m == 0) ? 0. : (2. * m + 1.) / m,
+                c1 = (m == 0) ? 0. : (m + 1.) / m,
+                t0 = m + 1., t1 = m + 2.;
+
+            std::array<complex128, 8> sums = {};
+
+            for (size_t i = 0; i < block_size; ++i) {
+                // pi_1 = 1, tau_1 = mu, then the recurrence of BaseScatterer::compute_direct_spherical_s1s2
+                const double pi_n = (m == 0) ? 1.0 : c0 * mu[i] * pi_current[i] - c1 * pi_previous[i];
+                const double tau_n = (m == 0) ? mu[i] : t0 * mu[i] * pi_n - t1 * pi_current[i];
+
+                pi_previous[i] = (m == 0) ? 0.0 : pi_current[i];
+                pi_current[i] = pi_n;
+
+                for (size_t k = 0; k < 4; ++k) {
+                    sums[2 * k] += u[k][i] * pi_n + v[k][i] * tau_n;
+                    sums[2 * k + 1] += u[k][i] * tau_n + v[k][i] * pi_n;
+                }
+            }
+
+            for (size_t k = 0; k < 8; ++k)
+                output.weights[8 * m + k] += sums[k];
+        }
+    }
+
+    for (size_t m = 0; m < max_order; ++m) {
+        const double n = static_cast<double>(m + 1);
+        const double prefactor = (2. * n + 1.) / (n * (n + 1.));
+
+        for (size_t k = 0; k < 8; ++k)
+            output.weights[8 * m + k] *= prefactor;
+    }
+
+    return output;
+}
+
+bool Detector::is_on_axis() const
+{
+    // The rotation turns the mesh about its first point, which is on the axis unless the center of the cap is cut out
+    return this->phi_offset == 0.0 && this->gamma_offset == 0.0 && (this->rotation == 0.0 || this->min_angle == 0.0);
+}
+
+double Detector::get_coupling_point_no_coherent_on_axis(const BaseScatterer &scatterer) const
+{
+    scatterer.ensure_coefficients();
+
+    const PhotodiodeQuadrature& quadrature = this->get_photodiode_quadrature(scatterer.max_order);
+
+    auto [S1, S2] = scatterer.compute_spherical_s1s2(quadrature.phi);
+
+    double integral_S1 = 0.0, integral_S2 = 0.0;
+    for (size_t k = 0; k < quadrature.weights.size(); ++k) {
+        integral_S1 += quadrature.weights[k] * std::norm(S1[k]);
+        integral_S2 += quadrature.weights[k] * std::norm(S2[k]);
+    }
+
+    // Azimuthal integral of |jones[0] cos + jones[1] sin|^2, and of |jones[0] sin - jones[1] cos|^2
+    const JonesVector& jones_vector = scatterer.source.jones_vector;
+    const double azimuthal_factor = PI * (std::norm(jones_vector[0]) + std::norm(jones_vector[1]));
+    const double propagator_norm = std::norm(scatterer.get_propagator(1.0));
+
+    double
+        coupling_theta = propagator_norm * azimuthal_factor * integral_S1,
+        coupling_phi = propagator_norm * azimuthal_factor * integral_S2;
+
+    this->apply_polarization_filter(
+        coupling_theta,
+        coupling_phi,
+        this->polarization_filter
+    );
+
+    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi);
+}
+
+const PhotodiodeQuadrature& Detector::get_photodiode_quadrature(const size_t max_order) const
+{
+    // |S1|^2 has degree 2 max_order in mu, exact with max_order + 1 nodes
+    return this->geometry->photodiode_quadrature.get(
+        [&](const PhotodiodeQuadrature& quadrature) {return quadrature.weights.size() >= max_order + 1;},
+        [&](const PhotodiodeQuadrature* quadrature) {
+            const size_t n_nodes = std::max(max_order + 1, quadrature ? 2 * quadrature->weights.size() : size_t(0));
+            auto [mu, weights] = get_gauss_legendre_rule(n_nodes, cos(this->max_angle), cos(this->min_angle));
+
+            // Mesh convention of the scatterer amplitudes, mu = cos(phi - pi / 2)
+            std::vector<double> phi(n_nodes);
+            for (size_t k = 0; k < n_nodes; ++k)
+                phi[k] = asin(mu[k]);
+
+            return PhotodiodeQuadrature{std::move(phi), std::move(weights)};
+        }
+    );
 }
 
 double Detector::get_coupling_point_no_coherent(const BaseScatterer &scatterer) const
 {
-    auto [theta_field, phi_field] = scatterer.compute_unstructured_farfields(this->fibonacci_mesh, 1.0);
+    if (scatterer.has_spherical_amplitudes() && this->is_on_axis())
+        return this->get_coupling_point_no_coherent_on_axis(scatterer);
+
+    auto [S1, S2] = scatterer.compute_mesh_amplitudes(this->get_mesh(), this->interpolation_tolerance);
+
+    return this->get_coupling_no_coherent(scatterer, S1, S2);
+}
+
+double Detector::get_coupling_no_coherent(const BaseScatterer &scatterer, const std::vector<complex128> &S1, const std::vector<complex128> &S2) const
+{
+    const JonesVector& jones_vector = scatterer.source.jones_vector;
+    const std::vector<double>& theta = this->get_mesh().spherical.theta;
+    const std::vector<double>& weights = this->get_mesh().quadrature_weights;
+
+    // Intensities of the fields of BaseScatterer::compute_unstructured_farfields, integrated in a single pass
+    double sum_S1 = 0.0, sum_S2 = 0.0;
+    for (size_t i = 0; i < theta.size(); ++i) {
+        const double cos_theta = cos(theta[i]), sin_theta = sin(theta[i]);
+
+        sum_S1 += weights[i] * std::norm(S1[i]) * std::norm(jones_vector[0] * cos_theta + jones_vector[1] * sin_theta);
+        sum_S2 += weights[i] * std::norm(S2[i]) * std::norm(jones_vector[0] * sin_theta - jones_vector[1] * cos_theta);
+    }
+
+    const double propagator_norm = std::norm(scatterer.get_propagator(1.0));
 
     double
-        coupling_theta = this->get_norm2_squared(theta_field),
-        coupling_phi = this->get_norm2_squared(phi_field);
+        coupling_theta = propagator_norm * sum_S1,
+        coupling_phi = propagator_norm * sum_S2;
 
     this->apply_polarization_filter(
         coupling_theta,
@@ -268,5 +527,126 @@ double Detector::get_coupling_point_no_coherent(const BaseScatterer &scatterer)
         this->polarization_filter
     );
 
-    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi) * this->fibonacci_mesh.dOmega;
+    return 0.5 * EPSILON0 * LIGHT_SPEED * (coupling_theta + coupling_phi);
+}
+
+// ------------------------- Adaptive Coupling -------------------------
+void Detector::refine_amplitudes(const BaseScatterer &scatterer, const FejerMesh &mesh, std::vector<complex128> &S1, std::vector<complex128> &S2) const
+{
+    const size_t n_points = mesh.spherical.phi.size();
+    const size_t n_coarse = S1.size();
+
+    std::vector<complex128> fine_S1(n_points), fine_S2(n_points);
+    std::vector<bool> is_known(n_points, false);
+
+    for (size_t i = 0; i < n_coarse; ++i) {
+        const size_t index = mesh.get_nested_index(i);
+        fine_S1[index] = S1[i];
+        fine_S2[index] = S2[i];
+        is_known[index] = true;
+    }
+
+    std::vector<size_t> new_index;
+    std::vector<double> new_phi;
+    new_index.reserve(n_points - n_coarse);
+    new_phi.reserve(n_points - n_coarse);
+
+    for (size_t i = 0; i < n_points; ++i)
+        if (!is_known[i]) {
+            new_index.push_back(i);
+            new_phi.push_back(mesh.spherical.phi[i]);
+        }
+
+    auto [new_S1, new_S2] = scatterer.compute_mesh_amplitudes(new_phi, this->interpolation_tolerance);
+
+    for (size_t k = 0; k < new_index.size(); ++k) {
+        fine_S1[new_index[k]] = new_S1[k];
+        fine_S2[new_index[k]] = new_S2[k];
+    }
+
+    S1 = std::move(fine_S1);
+    S2 = std::move(fine_S2);
+}
+
+AdaptiveCoupling Detector::get_adaptive_coupling(const BaseScatterer& scatterer) const
+{
+    return this->get_adaptive_coupling(scatterer, {});
+}
+
+std::vector<std::shared_ptr<const DetectorGeometry>> Detector::get_adaptive_geometries() const
+{
+    std::vector<std::shared_ptr<const DetectorGeometry>> levels;
+
+    if (this->is_coherent && this->mean_coupling)
+        return levels;
+
+    DetectorGeometryKey key = this->get_geometry_key();
+    key.quadrature = "fejer";
+    key.sampling = 0;
+
+    for (size_t level = 0; level == 0 || FejerMesh::get_sampling(level, this->max_angle, this->min_angle) <= this->max_sampling; ++level) {
+        key.level = level;
+        levels.push_back(DetectorGeometryCache::get_instance().get_geometry(key));
+    }
+
+    return levels;
+}
+
+AdaptiveCoupling Detector::get_adaptive_coupling(
+    const BaseScatterer& scatterer, const std::vector<std::shared_ptr<const DetectorGeometry>>& levels) const
+{
+    if (!this->is_coherent && scatterer.has_spherical_amplitudes() && this->is_on_axis())
+        return {this->get_coupling_point_no_coherent_on_axis(scatterer), 0.0, 0};
+
+    if (this->is_coherent && this->mean_coupling) {
+        Detector detector = *this;
+        detector.coupling_tolerance = 0.0;
+        return {detector.get_coupling(scatterer), std::numeric_limits<double>::quiet_NaN(), this->sampling};
+    }
+
+    const bool use_coherent_weights = this->is_coherent && scatterer.has_spherical_amplitudes();
+
+    DetectorGeometryKey key = this->get_geometry_key();
+    key.quadrature = "fejer";
+    key.sampling = 0;
+
+    Detector detector = *this;
+    detector.coupling_tolerance = 0.0;
+
+    std::vector<complex128> S1, S2;
+    AdaptiveCoupling output;
+    output.error = std::numeric_limits<double>::infinity();
+
+    for (size_t level = 0; ; ++level) {
+        const size_t sampling = FejerMesh::get_sampling(level, this->max_angle, this->min_angle);
+
+        if (level > 0 && sampling > this->max_sampling)
+            break;
+
+        key.level = level;
+        detector.geometry = (level < levels.size()) ? levels[level] : DetectorGeometryCache::get_instance().get_geometry(key);
+        const FejerMesh& mesh = static_cast<const FejerMesh&>(detector.get_mesh());
+
+        double coupling;
+        if (use_coherent_weights)
+            coupling = detector.get_coupling_point_coherent_spherical(scatterer);
+        else {
+            detector.refine_amplitudes(scatterer, mesh, S1, S2);
+
+            coupling = this->is_coherent
+                ? detector.get_coupling_coherent(scatterer, S1, S2, true)
+                : detector.get_coupling_no_coherent(scatterer, S1, S2);
+        }
+
+        if (level > 0)
+            output.error = (coupling == output.coupling) ? 0.0 : std::abs(coupling - output.coupling) / std::abs(coupling);
+
+        output.coupling = coupling;
+        output.sampling = sampling;
+
+        if (output.error <= this->coupling_tolerance)
+            break;
+    }
+
+    return output;
 }
@@ -1,19 +1,32 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <complex>
+#include <memory>
+#include <mutex>
 #include <cmath> // For std::isnan and std::pow
 #include <stdexcept>
 #include <fibonacci/fibonacci.h>
 #include <scatterer/base_scatterer/base_scatterer.h>
 #include <mode_field/mode_field.h>
 #include <utils/math.h>
+#include "detector_geometry.h"
 
 using complex128 = std::complex<double>;
 #define EPSILON0 (double)8.854187817620389e-12  // Farad/Meter
 #define LIGHT_SPEED (double)299792458.0 // Meter/Second
 
 
+/**
+ * @brief Coupling of an adaptive mesh refinement along with its error estimate.
+ */
+struct AdaptiveCoupling {
+    double coupling = 0.0;
+    double error = 0.0;  // relative change of the coupling over the last refinement
+    size_t sampling = 0;  // points of the finest mesh, zero when the coupling is integrated exactly
+};
+
 class Detector {
     public:
         std::string mode_number;
@@ -29,9 +42,12 @@ class Detector {
         double medium_refractive_index;
         double max_angle = 0;
         double min_angle = 0;
-        std::vector<complex128> scalar_field;
-        FibonacciMesh fibonacci_mesh;
-        std::vector<size_t> indices;
+        double interpolation_tolerance = 0.0;  // S1/S2 interpolated from a 1-D angular grid when > 0
+        std::string quadrature = "fibonacci";  // mesh of the detector, "fibonacci" or "gauss_legendre"
+        double coupling_tolerance = 0.0;  // the mesh is refined until the coupling converges to this relative tolerance when > 0
+        size_t max_sampling = 100000;  // largest mesh of the adaptive refinement
+        std::shared_ptr<const DetectorGeometry> geometry;  // mesh and mode field, shared by the detectors of same parameters
+        IndexTuple indices;
 
         ModeID mode_id;
         ModeField mode_field;
@@ -49,7 +65,8 @@ class Detector {
             const double _rotation,
             const bool _is_coherent,
             const bool _mean_coupling,
-            const double _medium_refractive_index = 1.0)
+            const double _medium_refractive_index = 1.0,
+            const std::string &_quadrature = "fibonacci")
         :   mode_number(_mode_number),
             sampling(_sampling),
             numerical_aperture(_numerical_aperture),
@@ -60,7 +77,8 @@ class Detector {
             rotation(_rotation),
             is_coherent(_is_coherent),
             mean_coupling(_mean_coupling),
-            medium_refractive_index(_medium_refractive_index)
+            medium_refractive_index(_medium_refractive_index),
+            quadrature(_quadrature)
         {
             this->initialize(medium_refractive_index);
         }
@@ -73,6 +91,68 @@ class Detector {
          */
         double get_coupling(const BaseScatterer& scatterer) const;
 
+        /**
+         * @brief Computes the coupling coefficient from S1 and S2 already evaluated at the mesh points.
+         * @param scatterer The scatterer, for its source and propagator.
+         * @param S1 The S1 scattering amplitudes at the mesh points.
+         * @param S2 The S2 scattering amplitudes at the mesh points.
+         * @return The coupling coefficient.
+         * @note Used by DetectorGroup, which evaluates the amplitudes of all its detectors at once.
+         */
+        double get_coupling(const BaseScatterer& scatterer, const std::vector<complex128>& S1, const std::vector<complex128>& S2) const;
+
+        /**
+         * @brief Computes the coherent point coupling from the sums over the mesh of the projected far field weighted by the mode.
+         * @param scatterer The scatterer, for its propagator.
+         * @param horizontal_sum The sum of the horizontal projections, weighted by the mode and the quadrature weights.
+         * @param vertical_sum The sum of the vertical projections, weighted likewise.
+         * @return The coupling coefficient.
+         * @note Used by DetectorGroup, which computes the sums of the detectors differing only by their mode as a single
+         * matrix-vector product.
+         */
+        double get_coupling(const BaseScatterer& scatterer, const complex128 horizontal_sum, const complex128 vertical_sum) const;
+
+        /**
+         * @brief Returns the parameters of the mesh and mode field of the detector.
+         */
+        DetectorGeometryKey get_geometry_key() const;
+
+        /**
+         * @brief Returns whether the coupling with the scatterer is integrated from S1 and S2 at the mesh points.
+         * @param scatterer The scatterer.
+         * @note False for the couplings computed from the coefficients of spherical scatterers, and for the adaptive couplings,
+         * which choose their own meshes.
+         */
+        bool uses_mesh_amplitudes(const BaseScatterer& scatterer) const;
+
+        /**
+         * @brief Computes the coupling on nested meshes refined until it changes by less than coupling_tolerance.
+         * @param scatterer The scatterer for which the coupling coefficient is computed.
+         * @return The coupling, its relative change over the last refinement and the number of points of the last mesh.
+         * @note The meshes are the levels of FejerMesh, whatever the quadrature of the detector, and are shared through
+         * the DetectorGeometryCache. S1 and S2 are only evaluated at the points added by each level. The refinement
+         * stops before the mesh exceeds max_sampling, the error then being above the tolerance. The mean coherent
+         * coupling depends on the sampling by construction, it is computed on the mesh of the detector with a NaN error.
+         */
+        AdaptiveCoupling get_adaptive_coupling(const BaseScatterer& scatterer) const;
+
+        /**
+         * @brief Computes the adaptive coupling on level geometries resolved beforehand.
+         * @param scatterer The scatterer for which the coupling coefficient is computed.
+         * @param levels The geometries of the successive FejerMesh levels, see get_adaptive_geometries.
+         * @return The coupling, its relative change over the last refinement and the number of points of the last mesh.
+         * @note Levels beyond the given ones are fetched from the DetectorGeometryCache.
+         */
+        AdaptiveCoupling get_adaptive_coupling(
+            const BaseScatterer& scatterer, const std::vector<std::shared_ptr<const DetectorGeometry>>& levels) const;
+
+        /**
+         * @brief Returns the geometries of every FejerMesh level the adaptive coupling may refine to.
+         * @note Empty for the mean coherent coupling, which does not refine. Holding the levels spares a sweep the
+         * lookups in the DetectorGeometryCache, whose entries its many detectors would otherwise evict from each other.
+         */
+        std::vector<std::shared_ptr<const DetectorGeometry>> get_adaptive_geometries() const;
+
         /**
          * @brief Computes the structured scalar field for the detector.
          * @param sampling The number of samples to use for the structured scalar field.
@@ -97,6 +177,22 @@ class Detector {
          */
         double get_energy_flow(const BaseScatterer& scatterer, double distance = 1) const;
 
+        const FibonacciMesh& get_mesh() const {return *this->geometry->mesh;}
+
+        const std::vector<complex128>& get_scalar_field() const {return this->geometry->scalar_field;}
+
+        /**
+         * @brief Replaces the mode field sampled on the mesh.
+         * @param scalar_field The new samples, one per mesh point.
+         * @note The detector gets a geometry of its own, keeping the mesh but not the weights of the shared one.
+         */
+        void set_scalar_field(std::vector<complex128> scalar_field);
+
+        /**
+         * @brief Tells whether the detector is centered on the propagation axis, its coupling to spherical scatterers then being integrated exactly.
+         */
+        bool is_on_axis() const;
+
     private:
         /**
          * @brief Computes the coupling coefficient for a given scatterer, considering coherent or non-coherent modes.
@@ -130,6 +226,76 @@ class Detector {
          */
         double get_coupling_mean_coherent(const BaseScatterer& scatterer) const;
 
+        /**
+         * @brief Computes the coherent coupling on the mesh from the scattering amplitudes at its points.
+         * @param scatterer The scatterer, for its source and propagator.
+         * @param S1 The S1 scattering amplitudes at the mesh points.
+         * @param S2 The S2 scattering amplitudes at the mesh points.
+         * @param coherent_sum Whether the point (true) or mean (false) coupling is computed.
+         * @return The coupling coefficient.
+         */
+        double get_coupling_coherent(const BaseScatterer& scatterer, const std::vector<complex128>& S1, const std::vector<complex128>& S2, const bool coherent_sum) const;
+
+        /**
+         * @brief Computes the non-coherent coupling on the mesh from the scattering amplitudes at its points.
+         * @param scatterer The scatterer, for its source and propagator.
+         * @param S1 The S1 scattering amplitudes at the mesh points.
+         * @param S2 The S2 scattering amplitudes at the mesh points.
+         * @return The coupling coefficient.
+         */
+        double get_coupling_no_coherent(const BaseScatterer& scatterer, const std::vector<complex128>& S1, const std::vector<complex128>& S2) const;
+
+        /**
+         * @brief Extends S1 and S2 from the points of a nested mesh to those of the next level.
+         * @param scatterer The scatterer.
+         * @param mesh The mesh of the next level.
+         * @param S1 The S1 amplitudes of the previous level, empty for the first one, replaced by those of mesh.
+         * @param S2 The S2 amplitudes of the previous level, empty for the first one, replaced by those of mesh.
+         * @note Only the points added by the level are evaluated.
+         */
+        void refine_amplitudes(const BaseScatterer& scatterer, const FejerMesh& mesh, std::vector<complex128>& S1, std::vector<complex128>& S2) const;
+
+        /**
+         * @brief Computes the coherent point coupling of a spherical scatterer from its coefficients and the coherent weights.
+         * @param scatterer The scatterer, its has_spherical_amplitudes() must be true.
+         * @return The coupling coefficient.
+         * @note Costs O(max_order) per scatterer instead of O(max_order * sampling) for the far field on the mesh. The result
+         * is exact, the interpolation tolerance does not apply.
+         */
+        double get_coupling_point_coherent_spherical(const BaseScatterer& scatterer) const;
+
+        /**
+         * @brief Returns coherent weights covering at least max_order orders, computing them on first use.
+         * @param max_order The number of orders required.
+         * @return Weights held by the geometry, which remain valid when other threads extend them.
+         * @note The weights are extended to at least twice their previous order, so that scatterers of increasing size
+         * rebuild them a logarithmic number of times. Only the rebuilds take a lock (see GrowingValue).
+         */
+        const CoherentWeights& get_coherent_weights(const size_t max_order) const;
+
+        /**
+         * @brief Computes the coherent weights of the mesh and mode field.
+         * @param max_order The number of orders to compute.
+         * @return The weights, see CoherentWeights for their layout.
+         */
+        CoherentWeights compute_coherent_weights(const size_t max_order) const;
+
+        /**
+         * @brief Computes the non-coherent coupling of a spherical scatterer as an exact integral over the cap of an on-axis detector.
+         * @param scatterer The scatterer, its has_spherical_amplitudes() must be true.
+         * @return The coupling coefficient.
+         * @note Independent of the sampling: S1 and S2 are evaluated on max_order + 1 Gauss-Legendre nodes or more,
+         * instead of the mesh points.
+         */
+        double get_coupling_point_no_coherent_on_axis(const BaseScatterer& scatterer) const;
+
+        /**
+         * @brief Returns a photodiode quadrature exact for scatterers of up to max_order orders, computing it on first use.
+         * @param max_order The number of orders of the scatterer.
+         * @return A quadrature held by the geometry, extended like the coherent weights.
+         */
+        const PhotodiodeQuadrature& get_photodiode_quadrature(const size_t max_order) const;
+
             /**
          * @brief Converts numerical aperture to angle in radians.
          * @param NA The numerical aperture to convert.
@@ -141,7 +307,8 @@ class Detector {
         /**
          * @brief Initializes the detector with the given medium refractive index.
          * @param medium_refractive_index The refractive index of the medium in which the detector operates.
-         * @note This function sets up the mode field and Fibonacci mesh based on the provided parameters.
+         * @note The mesh and the mode field sampled on it are taken from the DetectorGeometryCache.
+         * @throws std::invalid_argument if the quadrature is neither "fibonacci" nor "gauss_legendre".
          */
         void initialize(const double &medium_refractive_index);
 
@@ -154,49 +321,36 @@ class Detector {
         void parse_mode(const std::string& mode_number);
 
         /**
-         * @brief Computes the projected fields based on the theta and phi fields.
-         * @param theta_field The field in the theta direction.
-         * @param phi_field The field in the phi direction.
-         * @return A tuple containing the horizontal and vertical projections of the fields.
-         * @note This function computes the projections based on the spherical coordinates of the Fibonacci mesh.
-         */
-        std::tuple<std::vector<complex128>, std::vector<complex128>>
-        get_projected_farfields(const std::vector<complex128>& theta_field, const std::vector<complex128>& phi_field) const;
-
-
-        /**
-         * @brief Applies a scalar field to the horizontal and vertical projections of the coupling coefficients.
-         * @param field0 The horizontal projection field.
-         * @param field1 The vertical projection field.
-         * @note This function modifies the input fields in place, applying the scalar field to both projections.
-         */
-        void apply_scalar_field(std::vector<complex128> &field0, std::vector<complex128> &field1) const;
-
-        /**
-         * @brief Computes the squared norm of a 1-norm vector.
-         * @tparam T Type of the elements in the vector.
-         * @param array The input vector.
-         * @return The squared norm of the vector.
-         * @note This function computes the squared 1-norm, which is the square of the absolute value of the sum of the elements.
-         */
-        template <typename T> inline double get_norm1_squared(const std::vector<T>& array) const;
-
-        /**
-         * @brief Computes the squared norm of a 2-norm vector.
-         * @tparam T Type of the elements in the vector.
-         * @param array The input vector.
-         * @return The squared norm of the vector.
-         * @note This function computes the squared 2-norm, which is the sum of the squares of the absolute values of the elements.
+         * @brief Computes the couplings of the far field on the mesh, projected on the detector and weighted by its mode.
+         * @param scatterer The scatterer for which the coupling is computed.
+         * @param S1 The S1 scattering amplitudes at the mesh points.
+         * @param S2 The S2 scattering amplitudes at the mesh points.
+         * @param coherent_sum Whether the weighted projections are summed before taking their squared norm (point coupling)
+         * or after (mean coupling).
+         * @return The horizontal and vertical couplings, before the polarization filter and the 0.5 epsilon0 c factor. The point
+         * coupling is divided by dOmega, the mean coupling by Omega.
+         * @note The fields, projections and sums are evaluated point by point in get_projected_coupling, without
+         * full-size temporaries.
          */
-        template <typename T> inline double get_norm2_squared(const std::vector<T>& array) const;
+        std::array<double, 2> get_mesh_coupling(const BaseScatterer& scatterer, const std::vector<complex128>& S1, const std::vector<complex128>& S2, const bool coherent_sum) const;
 
         /**
-         * @brief Squares each element in the input vector.
-         * @tparam T Type of the elements in the vector.
-         * @param array The input vector to be squared.
-         * @note This function modifies the input vector in place, squaring each element.
+         * @brief Fused kernel of get_mesh_coupling, building the field of each mesh point, projecting it, weighting it by the mode and accumulating it.
+         * @tparam coherent_sum Whether the weighted projections are summed before taking their squared norm.
+         * @tparam ModeType double for real mode fields (LP, HG), which then take real multiplications, complex128 otherwise.
+         * @param S1 The S1 scattering amplitudes at the mesh points.
+         * @param S2 The S2 scattering amplitudes at the mesh points.
+         * @param jones_vector The Jones vector of the source.
+         * @param mode The mode field at the mesh points.
+         * @return The horizontal and vertical couplings, without the propagator.
+         * @note Every point is weighted by its solid angle, from the quadrature weights of the mesh.
          */
-        template <typename T> inline void square_array(std::vector<T>& array);
+        template <bool coherent_sum, typename ModeType>
+        std::array<double, 2> get_projected_coupling(
+            const std::vector<complex128>& S1,
+            const std::vector<complex128>& S2,
+            const JonesVector& jones_vector,
+            const std::vector<ModeType>& mode) const;
 
         /**
          * @brief Applies a polarization filter to the coupling coefficients.
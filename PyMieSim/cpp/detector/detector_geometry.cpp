@@ -0,0 +1,144 @@
+#include "detector_geometry.h"
+
+#include <algorithm>
+
+
+// ---------------------- DetectorGeometry ---------------------------------------
+DetectorGeometry::DetectorGeometry(const DetectorGeometryKey& key, std::shared_ptr<const FibonacciMesh> mesh)
+:   mesh(std::move(mesh))
+{
+    // Geometries differing only by their mode share the mesh of the first one built
+    if (!this->mesh) {
+        if (key.quadrature == "gauss_legendre")
+            this->mesh = std::make_shared<const GaussLegendreMesh>(
+                key.sampling, key.max_angle, key.min_angle, key.phi_offset, key.gamma_offset, key.rotation
+            );
+        else if (key.quadrature == "fejer")
+            this->mesh = std::make_shared<const FejerMesh>(
+                key.level, key.max_angle, key.min_angle, key.phi_offset, key.gamma_offset, key.rotation
+            );
+        else
+            this->mesh = std::make_shared<const FibonacciMesh>(
+                key.sampling, key.max_angle, key.min_angle, key.phi_offset, key.gamma_offset, key.rotation
+            );
+    }
+
+    if (key.quadrature != "fibonacci") {
+        // ModeField scales the points by the largest radius, reached at the edge of the cap by the Fibonacci spiral.
+        // The rings stop short of it, the edge is appended for the scaling and its sample dropped.
+        std::vector<double> x = this->mesh->base_cartesian.x, y = this->mesh->base_cartesian.y;
+        x.push_back(sin(std::clamp(PI / 2.0, key.min_angle, key.max_angle)));
+        y.push_back(0.0);
+
+        this->scalar_field = ModeField(key.mode_id).get_unstructured(x, y);
+        this->scalar_field.pop_back();
+        this->normalize_scalar_field();
+    }
+    else
+        this->scalar_field = ModeField(key.mode_id).get_unstructured(this->mesh->base_cartesian.x, this->mesh->base_cartesian.y);
+
+    this->compute_real_scalar_field();
+}
+
+DetectorGeometry::DetectorGeometry(std::shared_ptr<const FibonacciMesh> mesh, std::vector<complex128> scalar_field)
+:   mesh(std::move(mesh)), scalar_field(std::move(scalar_field))
+{
+    this->compute_real_scalar_field();
+}
+
+void DetectorGeometry::normalize_scalar_field()
+{
+    // ModeField normalizes the sum of |field|^2 over the points, here weighted by their solid angle relative to dOmega
+    double norm = 0.0;
+    for (size_t i = 0; i < this->scalar_field.size(); ++i)
+        norm += this->mesh->quadrature_weights[i] * std::norm(this->scalar_field[i]);
+
+    norm = std::sqrt(norm / this->mesh->dOmega);
+
+    if (norm == 0.0)
+        return;
+
+    for (complex128& value : this->scalar_field)
+        value /= norm;
+}
+
+void DetectorGeometry::compute_real_scalar_field()
+{
+    const bool is_real = std::all_of(
+        this->scalar_field.begin(), this->scalar_field.end(), [](const complex128& value) {return value.imag() == 0.0;}
+    );
+
+    if (!is_real)
+        return;
+
+    this->real_scalar_field.reserve(this->scalar_field.size());
+    for (const complex128& value : this->scalar_field)
+        this->real_scalar_field.push_back(value.real());
+}
+
+// ---------------------- DetectorGeometryCache ---------------------------------------
+std::shared_ptr<const DetectorGeometry>
+DetectorGeometryCache::get_geometry(const DetectorGeometryKey& key) {
+    std::shared_ptr<const FibonacciMesh> mesh;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->key == key) {
+                entries.splice(entries.begin(), entries, it);
+                ++statistics.hits;
+                return entries.front().geometry;
+            }
+
+            if (!mesh && it->key.has_same_mesh(key))
+                mesh = it->geometry->mesh;
+        }
+
+        ++statistics.misses;
+    }
+
+    std::shared_ptr<const DetectorGeometry> geometry = std::make_shared<const DetectorGeometry>(key, std::move(mesh));
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (capacity == 0)
+        return geometry;
+
+    for (const Entry& entry : entries)
+        if (entry.key == key)
+            return entry.geometry;
+
+    entries.push_front({key, geometry});
+    this->evict();
+
+    return geometry;
+}
+
+void DetectorGeometryCache::evict() {
+    while (entries.size() > capacity) {
+        entries.pop_back();
+        ++statistics.evictions;
+    }
+}
+
+DetectorGeometryCache::Statistics DetectorGeometryCache::get_statistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Statistics output = statistics;
+    output.size = entries.size();
+    output.capacity = capacity;
+    return output;
+}
+
+void DetectorGeometryCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    statistics = Statistics();
+}
+
+void DetectorGeometryCache::configure(const size_t _capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = _capacity;
+    this->evict();
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <complex>
+#include <fibonacci/fibonacci.h>
+#include <fibonacci/gauss_legendre.h>
+#include <mode_field/mode_field.h>
+#include <utils/shared_instance.h>
+
+using complex128 = std::complex<double>;
+
+
+/**
+ * @brief Weights turning the coherent point coupling of a spherical scatterer into a dot product with its coefficients.
+ *
+ * The far field projected on the detector and weighted by its mode is linear in (a_n, b_n) and in the two
+ * components of the source Jones vector, with factors that only depend on the mesh, its quadrature weights and the mode field.
+ * @note weights[8 * m + 4 * projection + 2 * component + coefficient] holds the factor of order m + 1, for the
+ * horizontal (0) or vertical (1) projection, the Jones vector component (0 or 1) and a_n (0) or b_n (1).
+ */
+struct CoherentWeights {
+    size_t max_order = 0;
+    std::vector<complex128> weights;
+};
+
+/**
+ * @brief Gauss-Legendre rule in mu, the cosine of the scattering angle, over the cap of an on-axis detector.
+ *
+ * The intensity collected by an on-axis detector is the integral of |S1|^2 and |S2|^2 over [cos(max_angle), cos(min_angle)],
+ * the azimuthal integral of the polarization factors being pi |jones|^2. These are polynomials of degree at most 2 max_order
+ * in mu, integrated exactly by a rule holding more nodes than orders.
+ * @note Only the nodes are stored, in the mesh convention (mu = cos(phi - pi/2)). S1 and S2 are evaluated on them per
+ * scatterer, so the memory stays linear in the number of nodes.
+ */
+struct PhotodiodeQuadrature {
+    std::vector<double> phi;
+    std::vector<double> weights;
+};
+
+
+/**
+ * @brief Value computed on first use and replaced by larger versions when a caller needs more, read without lock.
+ *
+ * Readers load the current version atomically and only take the mutex when it does not cover their needs.
+ * The versions replaced stay alive as long as the holder, since other threads may still be reading them:
+ * each version being at least twice the size of the previous one, they take less memory than the last one.
+ */
+template <typename T>
+class GrowingValue {
+    public:
+        /**
+         * @brief Returns the current version if it is sufficient, building and publishing a new one otherwise.
+         * @param is_sufficient Callable telling whether a version covers the needs of the caller.
+         * @param build Callable returning the new version from the current one, nullptr on first use.
+         * @return A version valid as long as the holder.
+         */
+        template <typename IsSufficient, typename Build>
+        const T& get(IsSufficient&& is_sufficient, Build&& build) const {
+            const T* value = current.load(std::memory_order_acquire);
+
+            if (value && is_sufficient(*value))
+                return *value;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            value = current.load(std::memory_order_relaxed);
+
+            if (!value || !is_sufficient(*value)) {
+                versions.push_back(std::make_unique<const T>(build(value)));
+                value = versions.back().get();
+                current.store(value, std::memory_order_release);
+            }
+
+            return *value;
+        }
+
+    private:
+        mutable std::mutex mutex;
+        mutable std::atomic<const T*> current{nullptr};
+        mutable std::vector<std::unique_ptr<const T>> versions;
+};
+
+
+/**
+ * @brief Parameters fully determining the mesh and the mode field of a detector.
+ */
+struct DetectorGeometryKey {
+    size_t sampling = 0;
+    double max_angle = 0.0;
+    double min_angle = 0.0;
+    double phi_offset = 0.0;
+    double gamma_offset = 0.0;
+    double rotation = 0.0;
+    std::string quadrature = "fibonacci";  // "fibonacci", "gauss_legendre" or "fejer", the nested meshes of adaptive couplings
+    size_t level = 0;  // refinement level of the "fejer" meshes, which ignore the sampling
+    ModeID mode_id;
+
+    /**
+     * @brief Tells whether the two keys describe the same mesh, whatever their modes.
+     */
+    bool has_same_mesh(const DetectorGeometryKey& other) const {
+        return sampling == other.sampling && max_angle == other.max_angle && min_angle == other.min_angle
+            && phi_offset == other.phi_offset && gamma_offset == other.gamma_offset && rotation == other.rotation
+            && quadrature == other.quadrature && level == other.level;
+    }
+
+    bool operator==(const DetectorGeometryKey& other) const {
+        return this->has_same_mesh(other)
+            && mode_id.mode_family == other.mode_id.mode_family && mode_id.number_0 == other.mode_id.number_0
+            && mode_id.number_1 == other.mode_id.number_1;
+    }
+};
+
+
+/**
+ * @brief Mesh and mode field sampled on it, shared by every detector built with the same parameters.
+ *
+ * The samples are immutable once built. The coupling weights derived from them are computed on first use
+ * and extended when a larger scatterer needs it, so that identical detectors, including the copies made by
+ * Experiment, also share their coherent weights and photodiode quadrature.
+ */
+class DetectorGeometry {
+    public:
+        std::shared_ptr<const FibonacciMesh> mesh;
+        std::vector<complex128> scalar_field;
+        std::vector<double> real_scalar_field;  // scalar_field when none of its values has an imaginary part, empty otherwise
+
+        GrowingValue<CoherentWeights> coherent_weights;
+        GrowingValue<PhotodiodeQuadrature> photodiode_quadrature;
+
+        /**
+         * @brief Builds the mesh of the key and samples its mode field on it.
+         * @param key The parameters of the detector.
+         * @param mesh The mesh of the key when another geometry already holds it, built otherwise.
+         * @note On the product meshes the mode field is normalized with the quadrature weights relative to dOmega,
+         * the couplings then reducing to those of the Fibonacci mesh, where every point weighs dOmega.
+         */
+        explicit DetectorGeometry(const DetectorGeometryKey& key, std::shared_ptr<const FibonacciMesh> mesh = nullptr);
+
+        /**
+         * @brief Wraps an existing mesh with another scalar field.
+         * @param mesh The mesh, shared with the geometry it comes from.
+         * @param scalar_field The mode field at the mesh points.
+         */
+        DetectorGeometry(std::shared_ptr<const FibonacciMesh> mesh, std::vector<complex128> scalar_field);
+
+    private:
+        void compute_real_scalar_field();
+        void normalize_scalar_field();
+};
+
+
+/**
+ * @brief Process-wide cache of DetectorGeometry keyed on the detector parameters.
+ *
+ * Experiments build the same detectors on every call and in every thread. The geometries are looked
+ * up here instead of regenerating the Fibonacci mesh, its projections and the mode field, and the least
+ * recently used ones are dropped beyond the capacity. Detectors hold their geometry through a shared
+ * pointer, an evicted geometry lives as long as a detector uses it.
+ * @note The instance is a SharedInstance, the single detectors and those built by Setup use the same cache.
+ */
+class DetectorGeometryCache {
+    public:
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            size_t size = 0;
+            size_t capacity = 0;
+        };
+
+        /**
+         * @brief Returns the process-wide cache.
+         */
+        static DetectorGeometryCache& get_instance() {return SharedInstance<DetectorGeometryCache>::get();}
+
+        /**
+         * @brief Returns the geometry of the given parameters, building it on a miss.
+         * @param key The parameters of the detector.
+         * @return A shared geometry.
+         * @note Geometries are built outside the lock. Threads missing the same key concurrently build it
+         * each, the first one inserted being kept. A geometry differing from a cached one only by its mode
+         * reuses the mesh of the latter, the modes of a multi-mode detector then sharing a single mesh.
+         */
+        std::shared_ptr<const DetectorGeometry> get_geometry(const DetectorGeometryKey& key);
+
+        /**
+         * @brief Returns the hit, miss and eviction counters along with the current size and capacity.
+         */
+        Statistics get_statistics();
+
+        /**
+         * @brief Removes every cached geometry and resets the counters.
+         */
+        void clear();
+
+        /**
+         * @brief Sets the number of geometries kept, dropping the least recently used ones beyond it.
+         * @param capacity The maximum number of geometries, zero disables the cache.
+         */
+        void configure(const size_t capacity);
+
+    private:
+        struct Entry {
+            DetectorGeometryKey key;
+            std::shared_ptr<const DetectorGeometry> geometry;
+        };
+
+        std::mutex mutex;
+        std::list<Entry> entries;  // most recently used first
+        size_t capacity = 64;
+        Statistics statistics;
+
+        DetectorGeometryCache() = default;
+        friend class SharedInstance<DetectorGeometryCache>;
+
+        void evict();
+};
@@ -0,0 +1,262 @@
+#include "detector_group.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+
+DetectorGroup::DetectorGroup(std::vector<Detector> _detectors)
+:   detectors(std::move(_detectors))
+{
+    constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    std::vector<DetectorGeometryKey> keys;
+
+    for (size_t k = 0; k < this->detectors.size(); ++k) {
+        const DetectorGeometryKey key = this->detectors[k].get_geometry_key();
+
+        size_t b = 0;
+        while (b < keys.size() && !keys[b].has_same_mesh(key))
+            ++b;
+
+        if (b == keys.size()) {
+            keys.push_back(key);
+            this->bundles.emplace_back();
+        }
+
+        this->bundle_index.push_back(b);
+        this->bundle_position.push_back(this->bundles[b].members.size());
+        this->bundles[b].members.push_back(k);
+    }
+
+    for (MeshBundle& bundle : this->bundles) {
+        std::vector<size_t> coherent_members;
+        bool is_real = true;
+
+        for (const size_t k : bundle.members) {
+            const Detector& detector = this->detectors[k];
+
+            if (detector.is_coherent && !detector.mean_coupling) {
+                coherent_members.push_back(k);
+                is_real = is_real && !detector.geometry->real_scalar_field.empty();
+            }
+        }
+
+        // A single mode gains nothing from the matrix, it keeps the kernel of its detector
+        if (coherent_members.size() < 2) {
+            bundle.rows.assign(bundle.members.size(), npos);
+            continue;
+        }
+
+        const size_t n_points = this->detectors[bundle.members.front()].get_mesh().spherical.phi.size();
+        bundle.n_modes = coherent_members.size();
+
+        if (is_real)
+            bundle.real_modes.reserve(bundle.n_modes * n_points);
+        else
+            bundle.modes.reserve(bundle.n_modes * n_points);
+
+        for (const size_t k : bundle.members) {
+            const Detector& detector = this->detectors[k];
+
+            if (!detector.is_coherent || detector.mean_coupling) {
+                bundle.rows.push_back(npos);
+                continue;
+            }
+
+            bundle.rows.push_back(is_real ? bundle.real_modes.size() / n_points : bundle.modes.size() / n_points);
+
+            if (is_real)
+                bundle.real_modes.insert(bundle.real_modes.end(), detector.geometry->real_scalar_field.begin(), detector.geometry->real_scalar_field.end());
+            else
+                bundle.modes.insert(bundle.modes.end(), detector.get_scalar_field().begin(), detector.get_scalar_field().end());
+        }
+    }
+}
+
+std::array<std::vector<double>, 4> DetectorGroup::get_projected_field(
+    const FibonacciMesh& mesh, const std::vector<complex128>& S1, const std::vector<complex128>& S2, const JonesVector& jones_vector)
+{
+    const std::vector<double>& theta = mesh.spherical.theta;
+    const std::vector<double>& weights = mesh.quadrature_weights;
+
+    std::array<std::vector<double>, 4> field;
+    for (std::vector<double>& component : field)
+        component.resize(theta.size());
+
+    for (size_t i = 0; i < theta.size(); ++i) {
+        const double cos_theta = cos(theta[i]), sin_theta = sin(theta[i]);
+
+        // Fields of BaseScatterer::compute_unstructured_farfields, without the propagator
+        const complex128
+            perpendicular_field = weights[i] * S1[i] * (jones_vector[0] * cos_theta + jones_vector[1] * sin_theta),
+            parallel_field = weights[i] * S2[i] * (jones_vector[0] * sin_theta - jones_vector[1] * cos_theta);
+
+        const complex128
+            horizontal = perpendicular_field * mesh.horizontal_perpendicular_projection[i] + parallel_field * mesh.horizontal_parallel_projection[i],
+            vertical = perpendicular_field * mesh.vertical_perpendicular_projection[i] + parallel_field * mesh.vertical_parallel_projection[i];
+
+        field[0][i] = horizontal.real();
+        field[1][i] = horizontal.imag();
+        field[2][i] = vertical.real();
+        field[3][i] = vertical.imag();
+    }
+
+    return field;
+}
+
+template <typename ModeType>
+std::array<complex128, 2> DetectorGroup::get_mode_sums(const ModeType* mode, const std::array<std::vector<double>, 4>& field)
+{
+    const double
+        *horizontal_real = field[0].data(), *horizontal_imag = field[1].data(),
+        *vertical_real = field[2].data(), *vertical_imag = field[3].data();
+
+    if constexpr (std::is_same_v<ModeType, double>) {
+        double h_real = 0.0, h_imag = 0.0, v_real = 0.0, v_imag = 0.0;
+
+        for (size_t i = 0; i < field[0].size(); ++i) {
+            h_real += mode[i] * horizontal_real[i];
+            h_imag += mode[i] * horizontal_imag[i];
+            v_real += mode[i] * vertical_real[i];
+            v_imag += mode[i] * vertical_imag[i];
+        }
+
+        return {complex128(h_real, h_imag), complex128(v_real, v_imag)};
+    } else {
+        complex128 horizontal = 0.0, vertical = 0.0;
+
+        for (size_t i = 0; i < field[0].size(); ++i) {
+            horizontal += mode[i] * complex128(horizontal_real[i], horizontal_imag[i]);
+            vertical += mode[i] * complex128(vertical_real[i], vertical_imag[i]);
+        }
+
+        return {horizontal, vertical};
+    }
+}
+
+std::vector<double> DetectorGroup::get_coupling(const BaseScatterer& scatterer) const
+{
+    constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    std::vector<double> couplings(this->detectors.size());
+
+    // The scatterer is shared by the threads below, the coefficients it defers are filled before
+    scatterer.ensure_coefficients();
+
+    // Bundles holding a detector that integrates mesh amplitudes, with the smallest tolerance of those detectors
+    std::vector<size_t> meshed_bundles;
+    std::vector<double> bundle_tolerance(this->bundles.size(), std::numeric_limits<double>::infinity());
+
+    for (size_t k = 0; k < this->detectors.size(); ++k) {
+        const Detector& detector = this->detectors[k];
+        const size_t b = this->bundle_index[k];
+
+        if (!detector.uses_mesh_amplitudes(scatterer) || detector.get_mesh().spherical.phi.empty())
+            continue;
+
+        if (bundle_tolerance[b] == std::numeric_limits<double>::infinity())
+            meshed_bundles.push_back(b);
+
+        bundle_tolerance[b] = std::min(bundle_tolerance[b], detector.interpolation_tolerance);
+    }
+
+    std::sort(meshed_bundles.begin(), meshed_bundles.end());
+
+    // The interpolated bundles share one table
+    std::vector<size_t> tabulated_bundles;
+    std::vector<std::array<double, 2>> ranges;
+    size_t n_points = 0;
+    double interpolation_tolerance = 0.0;
+
+    for (const size_t b : meshed_bundles) {
+        if (bundle_tolerance[b] <= 0.0)
+            continue;
+
+        const std::vector<double>& phi = this->detectors[this->bundles[b].members.front()].get_mesh().spherical.phi;
+        const auto [phi_min, phi_max] = std::minmax_element(phi.begin(), phi.end());
+
+        interpolation_tolerance = tabulated_bundles.empty() ? bundle_tolerance[b] : std::min(interpolation_tolerance, bundle_tolerance[b]);
+
+        tabulated_bundles.push_back(b);
+        ranges.push_back({*phi_min, *phi_max});
+        n_points += phi.size();
+    }
+
+    const AmplitudeTable table = scatterer.compute_amplitude_table(ranges, interpolation_tolerance, n_points);
+
+    // The exact bundles are evaluated at once on the union of their meshes, each then taking its slice
+    std::vector<double> union_phi;
+    std::vector<size_t> union_offset(this->bundles.size());
+
+    for (const size_t b : meshed_bundles) {
+        if (bundle_tolerance[b] > 0.0)
+            continue;
+
+        const std::vector<double>& phi = this->detectors[this->bundles[b].members.front()].get_mesh().spherical.phi;
+
+        union_offset[b] = union_phi.size();
+        union_phi.insert(union_phi.end(), phi.begin(), phi.end());
+    }
+
+    std::vector<complex128> union_S1, union_S2;
+
+    if (!union_phi.empty())
+        std::tie(union_S1, union_S2) = scatterer.compute_mesh_amplitudes(union_phi);
+
+    std::vector<std::vector<complex128>> S1(this->bundles.size()), S2(this->bundles.size());
+    std::vector<std::array<std::vector<double>, 4>> fields(this->bundles.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long index = 0; index < static_cast<long long>(meshed_bundles.size()); ++index) {
+        const size_t b = meshed_bundles[index];
+        const MeshBundle& bundle = this->bundles[b];
+        const FibonacciMesh& mesh = this->detectors[bundle.members.front()].get_mesh();
+
+        const bool is_tabulated = !table.empty() && std::binary_search(tabulated_bundles.begin(), tabulated_bundles.end(), b);
+
+        if (bundle_tolerance[b] <= 0.0) {
+            const auto begin = static_cast<std::ptrdiff_t>(union_offset[b]), end = begin + static_cast<std::ptrdiff_t>(mesh.spherical.phi.size());
+            S1[b].assign(union_S1.begin() + begin, union_S1.begin() + end);
+            S2[b].assign(union_S2.begin() + begin, union_S2.begin() + end);
+        }
+        else if (is_tabulated)
+            std::tie(S1[b], S2[b]) = table.evaluate(mesh.spherical.phi);
+        else
+            std::tie(S1[b], S2[b]) = scatterer.compute_mesh_amplitudes(mesh, bundle_tolerance[b]);
+
+        if (bundle.n_modes > 0)
+            fields[b] = get_projected_field(mesh, S1[b], S2[b], scatterer.source.jones_vector);
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long k = 0; k < static_cast<long long>(this->detectors.size()); ++k) {
+        const Detector& detector = this->detectors[k];
+        const size_t b = this->bundle_index[k];
+        const MeshBundle& bundle = this->bundles[b];
+
+        if (S1[b].empty() || !detector.uses_mesh_amplitudes(scatterer)) {
+            couplings[k] = detector.get_coupling(scatterer);
+            continue;
+        }
+
+        const size_t row = bundle.rows[this->bundle_position[k]];
+
+        if (row == npos) {
+            couplings[k] = detector.get_coupling(scatterer, S1[b], S2[b]);
+            continue;
+        }
+
+        const size_t n_points = S1[b].size();
+        const auto [horizontal_sum, vertical_sum] = bundle.real_modes.empty()
+            ? get_mode_sums(&bundle.modes[row * n_points], fields[b])
+            : get_mode_sums(&bundle.real_modes[row * n_points], fields[b]);
+
+        couplings[k] = detector.get_coupling(scatterer, horizontal_sum, vertical_sum);
+    }
+
+    return couplings;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <complex>
+#include "detector.h"
+
+using complex128 = std::complex<double>;
+
+
+/**
+ * @brief Detectors collecting the light scattered by the same particle, such as the forward, side and ring
+ * photodiodes of an angle-resolved instrument, or the modes of a mode-resolved fibre coupling.
+ *
+ * The far field only depends on the scattering angle. The particle is built once for all the detectors, and the
+ * detectors interpolating S1 and S2 share a single AmplitudeTable, refined once per particle over the ranges of all
+ * their meshes instead of once per detector. Detectors differing only by their orientation, as in goniometer sweeps,
+ * then reduce to interpolating the table at their mesh points.
+ *
+ * Detectors differing only by their mode share their mesh, see DetectorGeometryCache, and are bundled: the amplitudes
+ * are computed once per bundle, and the coherent point couplings of its modes follow from a single product of the
+ * dense (modes x points) matrix of their mode fields with the projected far field. The bundles evaluating the amplitudes
+ * exactly do so in a single call on the union of their meshes.
+ */
+class DetectorGroup {
+    public:
+        std::vector<Detector> detectors;
+
+        DetectorGroup() = default;
+
+        /**
+         * @brief Groups the given detectors and bundles those sharing a mesh.
+         * @param detectors The detectors, in the order of the couplings.
+         */
+        explicit DetectorGroup(std::vector<Detector> detectors);
+
+        size_t size() const {return this->detectors.size();}
+
+        /**
+         * @brief Computes the coupling of every detector with the scatterer.
+         * @param scatterer The scatterer.
+         * @return The couplings, one per detector.
+         * @note Detectors that do not integrate mesh amplitudes, see Detector::uses_mesh_amplitudes, compute their coupling
+         * on their own with the shared particle. The bundles evaluating their amplitudes exactly do so at once on the union
+         * of their meshes, the others share a table refined to the smallest of their tolerances, unless it would hold more
+         * nodes than their meshes hold points. The bundles, then the detectors, are projected in parallel when the group is
+         * not itself called from a parallel region.
+         */
+        std::vector<double> get_coupling(const BaseScatterer& scatterer) const;
+
+    private:
+        /**
+         * @brief Detectors of identical meshes along with the mode fields of their coherent point couplings.
+         * @note The rows of the mode matrix are real when every mode is, real_modes then being used instead of modes.
+         */
+        struct MeshBundle {
+            std::vector<size_t> members;  // detectors of the bundle, the first one providing the mesh
+            std::vector<size_t> rows;  // row of each member in the mode matrix, npos for the other couplings
+            size_t n_modes = 0;
+            std::vector<double> real_modes;  // n_modes x points, row-major
+            std::vector<complex128> modes;
+        };
+
+        std::vector<MeshBundle> bundles;
+        std::vector<size_t> bundle_index;  // bundle of each detector
+        std::vector<size_t> bundle_position;  // position of each detector among the members of its bundle
+
+        /**
+         * @brief Computes the weighted horizontal and vertical projections of the far field on the mesh.
+         * @param mesh The mesh of the bundle.
+         * @param S1 The S1 amplitudes at the mesh points.
+         * @param S2 The S2 amplitudes at the mesh points.
+         * @param jones_vector The Jones vector of the source.
+         * @return The real and imaginary parts of the horizontal, then vertical projections, each of the size of the mesh.
+         * @note The fields of Detector::get_projected_coupling without the mode, which only enters the matrix product.
+         */
+        static std::array<std::vector<double>, 4> get_projected_field(
+            const FibonacciMesh& mesh, const std::vector<complex128>& S1, const std::vector<complex128>& S2, const JonesVector& jones_vector);
+
+        /**
+         * @brief Computes the sums of a row of the mode matrix with the projected field.
+         * @param mode The row, of the size of the mesh.
+         * @param field The projected field of get_projected_field.
+         * @return The horizontal and vertical sums.
+         */
+        template <typename ModeType>
+        static std::array<complex128, 2> get_mode_sums(const ModeType* mode, const std::array<std::vector<double>, 4>& field);
+};
@@ -4,6 +4,7 @@
 #include <coordinates/interface.cpp>
 #include <mode_field/interface.cpp>
 #include <utils/numpy_interface.h>
+#include <utils/shared_instance_interface.h>
 
 PYBIND11_MODULE(interface_detector, module) {
     module.doc() = R"pbdoc(
@@ -14,6 +15,10 @@ PYBIND11_MODULE(interface_detector, module) {
     )pbdoc"
     ;
 
+    share_instance<DetectorGeometryCache>("PyMieSim::DetectorGeometryCache");
+    share_instance<AngularBasisCache>("PyMieSim::AngularBasisCache");
+    share_instance<SizeParameterTableCache>("PyMieSim::SizeParameterTableCache");
+
     register_coordinates(module);
 
     register_fibonacci(module);
@@ -55,6 +60,10 @@ PYBIND11_MODULE(interface_detector, module) {
                     If true, uses mean coupling; if false, uses point coupling.
                 medium_refractive_index : float, optional
                     Refractive index of the surrounding medium. Default is 1.0.
+                quadrature : str, optional
+                    Mesh of the detector, 'fibonacci' (default) for the golden spiral where every point covers the same
+                    solid angle, or 'gauss_legendre' for the Gauss-Legendre product rule, which converges with far
+                    fewer points for smooth fields.
 
                 Attributes
                 ----------
@@ -82,7 +91,7 @@ PYBIND11_MODULE(interface_detector, module) {
                     Minimum polar angle in the mesh (radians); zero if no cache.
             )pbdoc"
         )
-        .def(pybind11::init<std::string, size_t, double, double, double, double, double, double, bool, bool, double>(),
+        .def(pybind11::init<std::string, size_t, double, double, double, double, double, double, bool, bool, double, std::string>(),
             pybind11::arg("mode_number"),
             pybind11::arg("sampling"),
             pybind11::arg("NA"),
@@ -94,6 +103,7 @@ PYBIND11_MODULE(interface_detector, module) {
             pybind11::arg("is_coherent"),
             pybind11::arg("mean_coupling"),
             pybind11::arg("medium_refractive_index") = 1.0,
+            pybind11::arg("quadrature") = "fibonacci",
             R"pbdoc(
                 Initialize a BindedDetector.
 
@@ -102,14 +112,16 @@ PYBIND11_MODULE(interface_detector, module) {
         )
         .def_property(
             "_cpp_scalar_field",
-            [](Detector& self) {return vector_as_numpy_view(self, self.scalar_field);},
+            [](Detector& self) {return vector_as_numpy_view(self, self.get_scalar_field());},
             [](Detector& self,
                pybind11::array_t<std::complex<double>, pybind11::array::c_style | pybind11::array::forcecast> arr) {
-                vector_assign_from_numpy(self.scalar_field, arr);
+                std::vector<complex128> scalar_field;
+                vector_assign_from_numpy(scalar_field, arr);
+                self.set_scalar_field(std::move(scalar_field));
             },
             R"pbdoc(
                 Complex far field samples as numpy.complex128, shape (N,)
-                Getter returns a zero copy view tied to the detector lifetime
+                Getter returns a read-only zero copy view tied to the detector lifetime, the samples being shared by identical detectors
                 Setter accepts any 1D array castable to complex128
             )pbdoc"
         )
@@ -239,6 +251,59 @@ PYBIND11_MODULE(interface_detector, module) {
                 True if the detector is in coherent mode; false for incoherent.
             )pbdoc"
         )
+        .def_readwrite("interpolation_tolerance", &Detector::interpolation_tolerance,
+            R"pbdoc(
+                Relative error tolerance of the interpolated far-field mode.
+
+                When strictly positive, S1 and S2 are evaluated on an adaptive 1-D angular grid of a few
+                times the scatterer's maximum order and interpolated to the mesh points, instead of being
+                summed at each of the `sampling` points. Zero (default) evaluates them exactly.
+            )pbdoc"
+        )
+        .def_readwrite("coupling_tolerance", &Detector::coupling_tolerance,
+            R"pbdoc(
+                Relative tolerance of the adaptive coupling.
+
+                When strictly positive, the coupling is computed on nested meshes refined until it changes by less
+                than this tolerance, or until the next mesh would exceed `max_sampling`, instead of on the mesh of
+                `sampling` points. Zero (default) uses the mesh of the detector.
+            )pbdoc"
+        )
+        .def_readwrite("max_sampling", &Detector::max_sampling,
+            R"pbdoc(
+                Largest number of mesh points reached by the adaptive coupling. Default is 100000.
+            )pbdoc"
+        )
+        .def("_cpp_get_adaptive_coupling",
+            [](const Detector& self, const BaseScatterer& scatterer, const double tolerance, const size_t max_sampling) {
+                Detector detector = self;
+                detector.coupling_tolerance = tolerance;
+                detector.max_sampling = max_sampling;
+
+                const AdaptiveCoupling output = detector.get_adaptive_coupling(scatterer);
+                return pybind11::make_tuple(output.coupling, output.error, output.sampling);
+            },
+            pybind11::arg("scatterer"),
+            pybind11::arg("tolerance"),
+            pybind11::arg("max_sampling") = 100000,
+            R"pbdoc(
+                Compute the coupling on meshes refined until it converges.
+
+                Parameters
+                ----------
+                scatterer : BaseScatterer
+                    An instance of a PyMieSim scatterer (e.g., SPHERE or CYLINDER).
+                tolerance : float
+                    Relative change of the coupling between two refinements below which it is considered converged.
+                max_sampling : int
+                    Largest number of mesh points.
+
+                Returns
+                -------
+                tuple
+                    The coupling coefficient, its relative error estimate and the number of mesh points used.
+            )pbdoc"
+        )
         .def_readonly("_cpp_NA", &Detector::numerical_aperture,
             R"pbdoc(
                 Numerical aperture of the detector.
@@ -275,9 +340,20 @@ PYBIND11_MODULE(interface_detector, module) {
                 Rotation angle of the detector's field-of-view.
             )pbdoc"
         )
-        .def_readonly("_cpp_mesh", &Detector::fibonacci_mesh,
+        .def_readonly("_cpp_quadrature", &Detector::quadrature,
+            R"pbdoc(
+                Mesh of the detector, 'fibonacci' or 'gauss_legendre'.
+            )pbdoc"
+        )
+        .def_property_readonly("_cpp_mesh",
+            [](const Detector& self) {
+                return self.get_mesh();  // a copy: the mesh itself is shared with every detector of the same geometry
+            },
             R"pbdoc(
-                The Fibonacci angular mesh used for sampling.
+                The angular mesh used for sampling, Fibonacci or Gauss-Legendre.
+
+                Returned as a copy, so that modifying it does not alter the cached mesh shared by
+                every detector of the same geometry.
 
                 Provided as a NumPy array of shape (sampling, 2) containing
                 (gamma, phi) pairs.
@@ -294,5 +370,50 @@ PYBIND11_MODULE(interface_detector, module) {
                 zero if `cache_NA` disabled.
             )pbdoc"
         )
+        .def_static("set_geometry_cache",
+            [](const size_t capacity) {
+                DetectorGeometryCache::get_instance().configure(capacity);
+            },
+            pybind11::arg("capacity") = 64,
+            R"pbdoc(
+                Sets the number of detector geometries kept in the process-wide cache.
+
+                Detectors built with the same sampling, angles, offsets, rotation and mode share their
+                Fibonacci mesh, mode field and coupling weights, whether they are single detectors or
+                built by `Setup`. The least recently used geometries are dropped beyond the capacity.
+
+                Parameters
+                ----------
+                capacity : int, optional
+                    Maximum number of cached geometries, zero disables the cache. Default is 64.
+            )pbdoc"
+        )
+        .def_static("clear_geometry_cache",
+            []() {DetectorGeometryCache::get_instance().clear();},
+            "Removes every cached detector geometry and resets the cache statistics."
+        )
+        .def_static("get_geometry_cache_statistics",
+            []() {
+                const DetectorGeometryCache::Statistics statistics = DetectorGeometryCache::get_instance().get_statistics();
+
+                pybind11::dict output;
+                output["hits"] = statistics.hits;
+                output["misses"] = statistics.misses;
+                output["evictions"] = statistics.evictions;
+                output["size"] = statistics.size;
+                output["capacity"] = statistics.capacity;
+                return output;
+            },
+            R"pbdoc(
+                Returns the counters of the process-wide cache of detector geometries.
+
+                Returns
+                -------
+                dict
+                    ``hits`` and ``misses``: lookups served from the cache or building a new geometry.
+                    ``evictions``: geometries dropped beyond the capacity.
+                    ``size`` and ``capacity``: geometries currently held and maximum number kept.
+            )pbdoc"
+        )
     ;
 }
@@ -1,5 +1,7 @@
 #include "experiment.h"
 
+#include <omp.h>
+
 
 
 // Example: You can also add a class-wide debug_print method.
@@ -17,6 +19,40 @@ void Experiment::debug_print_state(const ScattererSet& scatterer_set, const Base
 }
 
 
+std::tuple<SphereEfficiencies, std::vector<double>>
+Experiment::get_sphere_efficiencies(const SphereSet& sphere_set, const BaseSourceSet& source_set) const {
+    const size_t n_spheres = sphere_set.total_combinations, total = source_set.total_combinations * n_spheres;
+
+    std::vector<double> size_parameter(total), cross_section(total);
+    std::vector<complex128> relative_index(total);
+
+    for (size_t i = 0; i < source_set.total_combinations; ++i) {
+        BaseSource source = source_set.get_source_by_index(i);
+
+        for (size_t j = 0; j < n_spheres; ++j) {
+            const size_t p = i * n_spheres + j;
+            std::tie(size_parameter[p], relative_index[p], cross_section[p]) = sphere_set.get_batch_parameters_by_index(j, source);
+        }
+    }
+
+    return std::make_tuple(compute_sphere_efficiencies(size_parameter, relative_index), std::move(cross_section));
+}
+
+std::tuple<SphereEfficiencies, std::vector<double>>
+Experiment::get_sphere_efficiencies_sequential(const SphereSet& sphere_set, const BaseSourceSet& source_set) const {
+    const size_t full_size = source_set.wavelength.size();
+
+    std::vector<double> size_parameter(full_size), cross_section(full_size);
+    std::vector<complex128> relative_index(full_size);
+
+    for (size_t idx = 0; idx < full_size; ++idx) {
+        BaseSource source = source_set.get_source_by_index_sequential(idx);
+        std::tie(size_parameter[idx], relative_index[idx], cross_section[idx]) = sphere_set.get_batch_parameters_by_index_sequential(idx, source);
+    }
+
+    return std::make_tuple(compute_sphere_efficiencies(size_parameter, relative_index), std::move(cross_section));
+}
+
 std::tuple<std::vector<double>, std::vector<size_t>>
 Experiment::get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const {
 
@@ -29,6 +65,24 @@ Experiment::get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet
 
     std::vector<double> output_array(total_iterations);
 
+    // Detectors are built once, their mesh, mode field and coherent weights are shared by every scatterer
+    std::vector<Detector> detectors(detector_set.total_combinations);
+
+    #pragma omp parallel for
+    for (long long k = 0; k < static_cast<long long>(detectors.size()); ++k) {
+        detectors[k] = detector_set.get_detector_by_index(k);
+        detectors[k].interpolation_tolerance = this->interpolation_tolerance;
+        detectors[k].coupling_tolerance = this->coupling_tolerance;
+        detectors[k].max_sampling = this->max_sampling;
+    }
+
+    // The detector indices are row-major in k: the couplings of a group fill the detector axes in place
+    if ((this->interpolation_tolerance > 0.0 || detector_set.mode_numbers.size() > 1) && detectors.size() > 1) {
+        this->fill_group_coupling(scatterer_set, source_set, DetectorGroup(std::move(detectors)), output_array);
+        debug_printf("get_scatterer_coupling: finished computation\n");
+        return std::make_tuple(std::move(output_array), std::move(array_shape));
+    }
+
     #pragma omp parallel for
     for (long long idx_flat = 0; idx_flat < static_cast<long long>(total_iterations); ++idx_flat) {
         size_t i = idx_flat / (scatterer_set.total_combinations * detector_set.total_combinations);
@@ -37,11 +91,9 @@ Experiment::get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet
 
         BaseSource source = source_set.get_source_by_index(i);
 
-        Detector detector = detector_set.get_detector_by_index(k);
-
-        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(j, source);
+        const Detector& detector = detectors[k];
 
-        detector.medium_refractive_index = scatterer_ptr->medium_refractive_index;
+        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
 
         size_t idx = flatten_multi_index(array_shape, source.indices, scatterer_ptr->indices, detector.indices);
         output_array[idx] = detector.get_coupling(*scatterer_ptr);
@@ -51,6 +103,56 @@ Experiment::get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet
     return std::make_tuple(std::move(output_array), std::move(array_shape));
 }
 
+std::tuple<std::vector<double>, std::vector<size_t>>
+Experiment::get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorGroupSet &detector_group_set) const {
+
+    std::vector<size_t> array_shape = concatenate_vector(source_set.shape, scatterer_set.shape, detector_group_set.shape);
+    const size_t n_detectors = detector_group_set.total_combinations;
+    debug_printf("get_group_coupling: scatterers = %zu, detectors = %zu\n", source_set.total_combinations * scatterer_set.total_combinations, n_detectors);
+
+    std::vector<double> output_array(source_set.total_combinations * scatterer_set.total_combinations * n_detectors);
+
+    DetectorGroup detector_group = detector_group_set.get_detector_group();
+
+    for (Detector& detector : detector_group.detectors) {
+        detector.interpolation_tolerance = this->interpolation_tolerance;
+        detector.coupling_tolerance = this->coupling_tolerance;
+        detector.max_sampling = this->max_sampling;
+    }
+
+    this->fill_group_coupling(scatterer_set, source_set, detector_group, output_array);
+    debug_printf("get_group_coupling: finished computation\n");
+
+    return std::make_tuple(std::move(output_array), std::move(array_shape));
+}
+
+void
+Experiment::fill_group_coupling(
+    const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorGroup& detector_group, std::vector<double>& output_array) const {
+
+    const std::vector<size_t> head_shape = concatenate_vector(source_set.shape, scatterer_set.shape);
+    const size_t total_iterations = source_set.total_combinations * scatterer_set.total_combinations;
+    const size_t n_detectors = detector_group.size();
+
+    // With fewer scatterers than threads the loop stays serial and DetectorGroup spreads the detectors instead
+    const bool is_parallel = total_iterations >= static_cast<size_t>(omp_get_max_threads());
+
+    #pragma omp parallel for if(is_parallel)
+    for (long long idx_flat = 0; idx_flat < static_cast<long long>(total_iterations); ++idx_flat) {
+        size_t i = idx_flat / scatterer_set.total_combinations;
+        size_t j = idx_flat % scatterer_set.total_combinations;
+
+        BaseSource source = source_set.get_source_by_index(i);
+
+        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
+
+        const size_t idx = flatten_multi_index(head_shape, source.indices, scatterer_ptr->indices) * n_detectors;
+        const std::vector<double> couplings = detector_group.get_coupling(*scatterer_ptr);
+
+        std::copy(couplings.begin(), couplings.end(), output_array.begin() + idx);
+    }
+}
+
 std::vector<double>
 Experiment::get_coupling_sequential(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const {
 
@@ -72,6 +174,9 @@ Experiment::get_coupling_sequential(const ScattererSet& scatterer_set, const Bas
         Detector detector = detector_set.get_detector_by_index_sequential(idx);
 
         detector.medium_refractive_index = scatterer_ptr->medium_refractive_index;
+        detector.interpolation_tolerance = this->interpolation_tolerance;
+        detector.coupling_tolerance = this->coupling_tolerance;
+        detector.max_sampling = this->max_sampling;
 
         output_array[idx] = detector.get_coupling(*scatterer_ptr);
     }
@@ -79,6 +184,58 @@ Experiment::get_coupling_sequential(const ScattererSet& scatterer_set, const Bas
     return output_array;
 }
 
+std::tuple<std::vector<double>, std::vector<double>, std::vector<size_t>, std::vector<size_t>>
+Experiment::get_adaptive_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const {
+
+    std::vector<size_t> array_shape = concatenate_vector(source_set.shape, scatterer_set.shape, detector_set.shape);
+    size_t total_iterations = source_set.total_combinations * scatterer_set.total_combinations * detector_set.total_combinations;
+    debug_printf("get_adaptive_coupling: total_iterations = %zu\n", total_iterations);
+
+    std::vector<double> coupling_array(total_iterations), error_array(total_iterations);
+    std::vector<size_t> sampling_array(total_iterations);
+
+    std::vector<Detector> detectors(detector_set.total_combinations);
+
+    #pragma omp parallel for
+    for (long long k = 0; k < static_cast<long long>(detectors.size()); ++k) {
+        detectors[k] = detector_set.get_detector_by_index(k);
+        detectors[k].interpolation_tolerance = this->interpolation_tolerance;
+        detectors[k].coupling_tolerance = this->coupling_tolerance;
+        detectors[k].max_sampling = this->max_sampling;
+    }
+
+    // The levels are resolved once per detector, every scatterer then refines on the same geometries
+    std::vector<std::vector<std::shared_ptr<const DetectorGeometry>>> levels(detectors.size());
+
+    #pragma omp parallel for
+    for (long long k = 0; k < static_cast<long long>(detectors.size()); ++k)
+        levels[k] = detectors[k].get_adaptive_geometries();
+
+    // Points converge after different numbers of levels, the iterations are handed out dynamically
+    #pragma omp parallel for schedule(dynamic)
+    for (long long idx_flat = 0; idx_flat < static_cast<long long>(total_iterations); ++idx_flat) {
+        size_t i = idx_flat / (scatterer_set.total_combinations * detector_set.total_combinations);
+        size_t j = (idx_flat / detector_set.total_combinations) % scatterer_set.total_combinations;
+        size_t k = idx_flat % detector_set.total_combinations;
+
+        BaseSource source = source_set.get_source_by_index(i);
+
+        const Detector& detector = detectors[k];
+
+        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
+
+        size_t idx = flatten_multi_index(array_shape, source.indices, scatterer_ptr->indices, detector.indices);
+        const AdaptiveCoupling coupling = detector.get_adaptive_coupling(*scatterer_ptr, levels[k]);
+
+        coupling_array[idx] = coupling.coupling;
+        error_array[idx] = coupling.error;
+        sampling_array[idx] = coupling.sampling;
+    }
+    debug_printf("get_adaptive_coupling: finished computation\n");
+
+    return std::make_tuple(std::move(coupling_array), std::move(error_array), std::move(sampling_array), std::move(array_shape));
+}
+
 
 std::tuple<std::vector<complex128>, std::vector<size_t>>
 Experiment::get_farfields(const ScattererSet& scatterer_set, const BaseSourceSet& source_set, const FibonacciMesh& mesh, const double distance) const
@@ -110,13 +267,13 @@ Experiment::get_farfields(const ScattererSet& scatterer_set, const BaseSourceSet
         size_t j = idx_flat % scatterer_set.total_combinations;  // scatterer index
 
         BaseSource source = source_set.get_source_by_index(i);
-        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(j, source);
+        std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
 
         // Linear index over the head shape only
         size_t idx_head = flatten_multi_index(head_shape, source.indices, scatterer_ptr->indices);
 
         // Compute fields
-        auto [phi_field, theta_field] = scatterer_ptr->compute_unstructured_farfields(mesh, distance);
+        auto [phi_field, theta_field] = scatterer_ptr->compute_unstructured_farfields(mesh, distance, this->interpolation_tolerance);
 
         // Sanity check in debug builds
         if (phi_field.size() != stride_channel || theta_field.size() != stride_channel) {
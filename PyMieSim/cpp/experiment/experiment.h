@@ -7,15 +7,54 @@
 #include "../scatterer/sphere/sphere.h"
 #include "../scatterer/cylinder/cylinder.h"
 #include "../scatterer/coreshell/coreshell.h"
+#include "../scatterer/sphere/sphere_batch.h"
 #include "../source/source.h"
 #include "../detector/detector.h"
 #include "../sets/sets.cpp"
 
 
+/**
+ * @brief Maps a BaseScatterer getter to its value in a SphereEfficiencies batch.
+ * @tparam function The getter. Only the specialisations below have a batch equivalent.
+ */
+template<double (BaseScatterer::*function)() const>
+struct SphereBatchMeasure {
+    static constexpr bool available = false;
+    static double get(const SphereEfficiencies&, const size_t, const double) {return 0.0;}
+};
+
+#define DEFINE_SPHERE_BATCH_MEASURE(name, expression) \
+    template<> \
+    struct SphereBatchMeasure<&BaseScatterer::get_##name> { \
+        static constexpr bool available = true; \
+        static double get(const SphereEfficiencies& e, const size_t p, const double cross_section) {return expression;} \
+    };
+
+DEFINE_SPHERE_BATCH_MEASURE(Qsca, e.Qsca[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qext, e.Qext[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qabs, e.Qext[p] - e.Qsca[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qback, e.Qback[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qforward, e.Qforward[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qratio, e.Qback[p] / e.Qsca[p])
+DEFINE_SPHERE_BATCH_MEASURE(Qpr, e.Qext[p] - e.g[p] * e.Qsca[p])
+DEFINE_SPHERE_BATCH_MEASURE(g, e.g[p])
+DEFINE_SPHERE_BATCH_MEASURE(Csca, e.Qsca[p] * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cext, e.Qext[p] * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cabs, (e.Qext[p] - e.Qsca[p]) * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cback, e.Qback[p] * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cforward, e.Qforward[p] * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cratio, e.Qback[p] / e.Qsca[p] * cross_section)
+DEFINE_SPHERE_BATCH_MEASURE(Cpr, (e.Qext[p] - e.g[p] * e.Qsca[p]) * cross_section)
+
+
 class Experiment
 {
     public:
         bool debug_mode = false;
+        double interpolation_tolerance = 0.0;  // S1/S2 interpolated from a 1-D angular grid when > 0
+        double coupling_tolerance = 0.0;  // detector meshes refined until the coupling converges to this relative tolerance when > 0
+        size_t max_sampling = 100000;  // largest mesh of the adaptive refinement
+        bool use_sphere_batch = true;  // scalar measures of sphere sets computed by the batch kernel when possible
 
         explicit Experiment(bool debug_mode = false) : debug_mode(debug_mode) {}
 
@@ -40,20 +79,22 @@ class Experiment
 
         /**
          * @brief Flattens a multi-dimensional index into a single index.
-         * @tparam MultiIndexVectors Variadic template for multiple index vectors.
+         * @tparam MultiIndexTuples Variadic template for multiple index tuples.
          * @param dimensions The dimensions of the multi-dimensional array.
-         * @param multi_indices The multi-dimensional indices to be flattened.
-         * @return The flattened single index.
+         * @param multi_indices The multi-dimensional indices to be flattened, read one after the other as a single index.
+         * @return The flattened single index (row-major).
          */
-        template <typename... MultiIndexVectors>
-        size_t flatten_multi_index(const std::vector<size_t>& dimensions, const MultiIndexVectors&... multi_indices) const {
-            std::vector<size_t> multi_index = concatenate_vector(multi_indices...);
+        template <typename... MultiIndexTuples>
+        size_t flatten_multi_index(const std::vector<size_t>& dimensions, const MultiIndexTuples&... multi_indices) const {
             size_t flatten_index = 0;
-            size_t stride = 1;
-            for (int i = static_cast<int>(dimensions.size()) - 1; i >= 0; --i) {
-                flatten_index += multi_index[i] * stride;
-                stride *= dimensions[i];
-            }
+            size_t axis = 0;
+
+            auto accumulate = [&](const auto& multi_index) {
+                for (const size_t index : multi_index)
+                    flatten_index = flatten_index * dimensions[axis++] + index;
+            };
+
+            (accumulate(multi_indices), ...);
             return flatten_index;
         }
 
@@ -87,6 +128,10 @@ class Experiment
             if (debug_mode)
                 this->debug_print_state(scatterer_set, source_set, detector_set);
 
+            if constexpr (SphereBatchMeasure<function>::available)
+                if (const SphereSet* sphere_set = this->get_batchable_sphere_set(scatterer_set))
+                    return this->get_sphere_batch_data<function>(*sphere_set, source_set, detector_set);
+
             std::vector<size_t> array_shape;
             size_t total_iterations;
 
@@ -113,7 +158,7 @@ class Experiment
                     size_t j = flat_index % scatterer_set.total_combinations;
                     BaseSource source = source_set.get_source_by_index(i);
 
-                    std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(j, source);
+                    std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
 
                     idx = flatten_multi_index(array_shape, source.indices, scatterer_ptr->indices);
 
@@ -125,10 +170,10 @@ class Experiment
                     long long k = flat_index % detector_set.total_combinations;
                     BaseSource source = source_set.get_source_by_index(i);
 
-                    std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(j, source);
+                    std::unique_ptr<BaseScatterer> scatterer_ptr = scatterer_set.get_scatterer_ptr_by_index(scatterer_set.get_sweep_index(j), source);
 
-                    Detector detector = detector_set.get_detector_by_index(k);
-                    idx = flatten_multi_index(array_shape, source.indices, scatterer_ptr->indices, detector.indices);
+                    // Only the position of the detector is needed, not its mesh
+                    idx = flatten_multi_index(array_shape, source.indices, scatterer_ptr->indices, detector_set.calculate_indices(k));
 
                     output_array[idx] = std::invoke(function, *scatterer_ptr);
                 }
@@ -160,6 +205,17 @@ class Experiment
             source_set.validate_sequential_data(full_size);
             debug_printf("get_scatterer_data_sequential: full_size = %zu\n", full_size);
 
+            if constexpr (SphereBatchMeasure<function>::available)
+                if (const SphereSet* sphere_set = this->get_batchable_sphere_set(scatterer_set)) {
+                    auto [efficiencies, cross_section] = this->get_sphere_efficiencies_sequential(*sphere_set, source_set);
+
+                    std::vector<double> output_array(full_size);
+                    for (size_t idx = 0; idx < full_size; ++idx)
+                        output_array[idx] = SphereBatchMeasure<function>::get(efficiencies, idx, cross_section[idx]);
+
+                    return output_array;
+                }
+
             std::vector<double> output_array(full_size);
 
             #pragma omp parallel for
@@ -175,16 +231,90 @@ class Experiment
             return output_array;
         }
 
+        /**
+         * @brief Returns the scatterer set as a SphereSet if its scalar measures can use the batch kernel.
+         * @param scatterer_set The set of scatterers.
+         * @return The SphereSet, or nullptr for other scatterers, when use_sphere_batch is off and when a regime accuracy_target is set.
+         */
+        const SphereSet* get_batchable_sphere_set(const ScattererSet& scatterer_set) const {
+            if (!this->use_sphere_batch)
+                return nullptr;
+
+            const SphereSet* sphere_set = dynamic_cast<const SphereSet*>(&scatterer_set);
+            return (sphere_set && sphere_set->accuracy_target == 0.0) ? sphere_set : nullptr;
+        }
+
+        /**
+         * @brief Computes the efficiencies of every (source, sphere) pair with compute_sphere_efficiencies.
+         * @param sphere_set The set of spheres.
+         * @param source_set The set of sources.
+         * @return The efficiencies and cross sections, indexed by source_index * sphere_set.total_combinations + sphere_index.
+         */
+        std::tuple<SphereEfficiencies, std::vector<double>>
+        get_sphere_efficiencies(const SphereSet& sphere_set, const BaseSourceSet& source_set) const;
+
+        /**
+         * @brief Computes the efficiencies of a sequential sphere set with compute_sphere_efficiencies.
+         * @param sphere_set The set of spheres.
+         * @param source_set The set of sources.
+         * @return The efficiencies and cross sections, one per wavelength.
+         */
+        std::tuple<SphereEfficiencies, std::vector<double>>
+        get_sphere_efficiencies_sequential(const SphereSet& sphere_set, const BaseSourceSet& source_set) const;
+
+        /**
+         * @brief Batch counterpart of get_data for scalar sphere measures.
+         * @tparam function The getter, with a SphereBatchMeasure specialisation.
+         * @param sphere_set The set of spheres.
+         * @param source_set The set of sources.
+         * @param detector_set The set of detectors, the values are repeated along its axes.
+         * @return A tuple containing the requested data and the shape of the array, laid out as get_data does.
+         */
+        template<double (BaseScatterer::*function)() const>
+        std::tuple<std::vector<double>, std::vector<size_t>>
+        get_sphere_batch_data(const SphereSet& sphere_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const {
+            std::vector<size_t> array_shape = detector_set.is_empty
+                ? concatenate_vector(source_set.shape, sphere_set.shape)
+                : concatenate_vector(source_set.shape, sphere_set.shape, detector_set.shape);
+
+            const size_t n_detectors = detector_set.is_empty ? 1 : detector_set.total_combinations;
+
+            auto [efficiencies, cross_section] = this->get_sphere_efficiencies(sphere_set, source_set);
+
+            // Row-major layout: the (source, sphere) pair is the slowest index, the detector the fastest
+            std::vector<double> output_array(cross_section.size() * n_detectors);
+            for (size_t p = 0; p < cross_section.size(); ++p)
+                std::fill_n(output_array.begin() + p * n_detectors, n_detectors, SphereBatchMeasure<function>::get(efficiencies, p, cross_section[p]));
+
+            debug_printf("get_sphere_batch_data: finished computation of %zu spheres\n", cross_section.size());
+            return std::make_tuple(std::move(output_array), std::move(array_shape));
+        }
+
         /**
          * @brief Computes the coupling coefficient for given scatterers, sources, and detectors.
          * @param scatterer_set The set of scatterers.
          * @param source_set The set of sources.
          * @param detector_set The set of detectors.
          * @return A tuple containing a numpy array of coupling coefficients and the shape of the array.
+         * @note With interpolation_tolerance > 0 and several detectors, e.g. a goniometer sweep of phi_offset or gamma_offset,
+         * the detectors are evaluated as a DetectorGroup: the amplitudes of each scatterer are tabulated once for every orientation.
+         * So are several mode_numbers, the modes sharing a mesh being coupled to one far-field evaluation per scatterer.
          */
         std::tuple<std::vector<double>, std::vector<size_t>>
         get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const;
 
+        /**
+         * @brief Computes the coupling coefficients of a detector group for given scatterers and sources.
+         * @param scatterer_set The set of scatterers.
+         * @param source_set The set of sources.
+         * @param detector_group_set The detectors of the group.
+         * @return A tuple containing the coupling coefficients and the shape of the array, the detectors of the group
+         * being laid along the last axis.
+         * @note Each scatterer is built once and its far field evaluated once for all the detectors, see DetectorGroup.
+         */
+        std::tuple<std::vector<double>, std::vector<size_t>>
+        get_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorGroupSet &detector_group_set) const;
+
         /**
          * @brief Computes the coupling coefficient sequentially for given scatterers, sources, and detectors.
          * @param scatterer_set The set of scatterers.
@@ -195,6 +325,17 @@ class Experiment
         std::vector<double>
         get_coupling_sequential(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const;
 
+        /**
+         * @brief Computes the coupling coefficients on meshes refined until they converge to coupling_tolerance.
+         * @param scatterer_set The set of scatterers.
+         * @param source_set The set of sources.
+         * @param detector_set The set of detectors.
+         * @return A tuple containing the couplings, their error estimates, the number of mesh points reached and the shape of the arrays.
+         * @note Each point of the sweep stops refining as soon as its own coupling has converged, see Detector::get_adaptive_coupling.
+         */
+        std::tuple<std::vector<double>, std::vector<double>, std::vector<size_t>, std::vector<size_t>>
+        get_adaptive_coupling(const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) const;
+
         /**
          * @brief Computes the far-field patterns for given scatterers, sources, and a Fibonacci mesh.
          * @param scatterer_set The set of scatterers.
@@ -206,4 +347,17 @@ class Experiment
         std::tuple<std::vector<complex128>, std::vector<size_t>>
         get_farfields(const ScattererSet& scatterer_set, const BaseSourceSet& source_set, const FibonacciMesh& mesh, const double distance = 1) const;
 
+    private:
+        /**
+         * @brief Fills the couplings of a detector group, scatterer by scatterer.
+         * @param scatterer_set The set of scatterers.
+         * @param source_set The set of sources.
+         * @param detector_group The detectors, laid along the last axis of the output.
+         * @param output_array The couplings, of size source × scatterer × detectors.
+         * @note The scatterers run in parallel when there are enough of them to occupy every thread, the detectors
+         * of each scatterer otherwise.
+         */
+        void fill_group_coupling(
+            const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorGroup& detector_group, std::vector<double>& output_array) const;
+
 };
@@ -2,6 +2,8 @@
 #include "experiment.cpp"
 #include <utils/numpy_interface.h>
 #include <utils/defines.h>
+#include <utils/shared_instance_interface.h>
+#include <utils/heap_counter.h>
 
 
 #define DEFINE_GETTER_INTERFACE(property) \
@@ -67,6 +69,11 @@
 PYBIND11_MODULE(interface_experiment, module) {
     module.doc() = "Interface for conducting Lorenz-Mie Theory (LMT) experiments within the PyMieSim package.";
 
+    // The detectors and scatterers built by Setup share the caches of the single ones
+    share_instance<DetectorGeometryCache>("PyMieSim::DetectorGeometryCache");
+    share_instance<AngularBasisCache>("PyMieSim::AngularBasisCache");
+    share_instance<SizeParameterTableCache>("PyMieSim::SizeParameterTableCache");
+
     pybind11::class_<Experiment>(module, "EXPERIMENT")
         .def(
             pybind11::init<bool>(),
@@ -84,6 +91,37 @@ PYBIND11_MODULE(interface_experiment, module) {
                     If set to True, enables debug printing for tracing computations. Default is True.
             )pbdoc"
         )
+        .def_readwrite("interpolation_tolerance", &Experiment::interpolation_tolerance,
+            R"pbdoc(
+                Relative error tolerance of the interpolated far-field mode used by coupling and far-field computations.
+
+                When strictly positive, S1 and S2 are evaluated on an adaptive 1-D angular grid and interpolated
+                to the mesh points, which is much cheaper for dense meshes and large scatterers. Zero (default)
+                evaluates them exactly at every mesh point.
+            )pbdoc"
+        )
+        .def_readwrite("coupling_tolerance", &Experiment::coupling_tolerance,
+            R"pbdoc(
+                Relative tolerance of the adaptive coupling.
+
+                When strictly positive, the coupling of every point of the sweep is computed on nested meshes refined
+                until it changes by less than this tolerance, or until the next mesh would exceed `max_sampling`.
+                The `sampling` of the detectors is then ignored. Zero (default) uses the mesh of the detectors.
+            )pbdoc"
+        )
+        .def_readwrite("max_sampling", &Experiment::max_sampling,
+            R"pbdoc(
+                Largest number of mesh points reached by the adaptive coupling. Default is 100000.
+            )pbdoc"
+        )
+        .def_readwrite("use_sphere_batch", &Experiment::use_sphere_batch,
+            R"pbdoc(
+                Whether the scalar measures of spheres are computed by the batch kernel. Default is True.
+
+                When False, every sphere of the sweep is evaluated as a single Sphere object, as for the other
+                scatterers, which is slower but shares its code path with the per-object measures.
+            )pbdoc"
+        )
         .def("get_coupling_sequential",
             [](Experiment& self, const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set) {
 
@@ -133,6 +171,70 @@ PYBIND11_MODULE(interface_experiment, module) {
                     The set of detectors.
             )pbdoc"
         )
+        .def("get_coupling",
+            [](Experiment& self, const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorGroupSet &detector_set) {
+
+                auto [coupling_array, coupling_shape] = self.get_coupling(scatterer_set, source_set, detector_set);
+                return vector_move_from_numpy(coupling_array, coupling_shape);
+            },
+            pybind11::arg("scatterer_set"),
+            pybind11::arg("source_set"),
+            pybind11::arg("detector_set"),
+            R"pbdoc(
+                Retrieves the coupling power of every detector of a group for a combination of scatterers and sources.
+
+                The far field of each scatterer is evaluated once for all the detectors of the group.
+
+                Parameters
+                ----------
+                scatterer_set : ScattererSet
+                    The set of scatterers.
+                source_set : BaseSourceSet
+                    The set of sources.
+                detector_set : DetectorGroupSet
+                    The detectors of the group, laid along the last axis of the output.
+            )pbdoc"
+        )
+        .def("_get_adaptive_coupling",
+            [](const Experiment& self, const ScattererSet& scatterer_set, const BaseSourceSet &source_set, const DetectorSet &detector_set, const double tolerance, const size_t max_sampling) {
+                Experiment experiment = self;
+                experiment.coupling_tolerance = tolerance;
+                experiment.max_sampling = max_sampling;
+
+                auto [coupling_array, error_array, sampling_array, array_shape] = experiment.get_adaptive_coupling(scatterer_set, source_set, detector_set);
+                return pybind11::make_tuple(
+                    vector_move_from_numpy(coupling_array, array_shape),
+                    vector_move_from_numpy(error_array, array_shape),
+                    vector_move_from_numpy(sampling_array, array_shape)
+                );
+            },
+            pybind11::arg("scatterer_set"),
+            pybind11::arg("source_set"),
+            pybind11::arg("detector_set"),
+            pybind11::arg("tolerance"),
+            pybind11::arg("max_sampling") = 100000,
+            R"pbdoc(
+                Retrieves the coupling power on detector meshes refined until it converges, for a combination of scatterers, sources, and detectors.
+
+                Parameters
+                ----------
+                scatterer_set : ScattererSet
+                    The set of scatterers.
+                source_set : BaseSourceSet
+                    The set of sources.
+                detector_set : DetectorSet
+                    The set of detectors.
+                tolerance : float
+                    Relative change of the coupling between two refinements below which it is considered converged.
+                max_sampling : int
+                    Largest number of mesh points.
+
+                Returns
+                -------
+                tuple of numpy.ndarray
+                    The coupling coefficients, their relative error estimates and the number of mesh points used.
+            )pbdoc"
+        )
         .def("_get_farfields",
             [](Experiment& self, const ScattererSet& scatterer_set, const BaseSourceSet& source_set, const FibonacciMesh& mesh, const double distance){
 
@@ -164,6 +266,118 @@ PYBIND11_MODULE(interface_experiment, module) {
             )pbdoc"
         )
 
+        .def_static("set_angular_basis_cache",
+            [](const bool enabled, const size_t max_memory_size) {
+                AngularBasisCache::get_instance().configure(enabled, max_memory_size);
+            },
+            pybind11::arg("enabled"),
+            pybind11::arg("max_memory_size") = size_t(512) << 20,
+            R"pbdoc(
+                Enables or disables the shared cache of angular functions for spherical scatterers.
+
+                When enabled, the pi_n and tau_n tables of every mesh (detectors and far-field meshes) are
+                computed once and shared by all the scatterers evaluated on it, S1 and S2 becoming a dense
+                matrix-vector product over the table. The setting also applies to the single detectors.
+                Disabled by default as the on-the-fly recurrence is usually faster on memory-bound machines.
+
+                Parameters
+                ----------
+                enabled : bool
+                    Whether to use the cache.
+                max_memory_size : int, optional
+                    Memory budget of the cache in bytes. Default is 512 MiB.
+            )pbdoc"
+        )
+
+        .def_static("get_angular_basis_cache_statistics",
+            []() {
+                const AngularBasisCache::Statistics statistics = AngularBasisCache::get_instance().get_statistics();
+
+                pybind11::dict output;
+                output["hits"] = statistics.hits;
+                output["misses"] = statistics.misses;
+                output["size"] = statistics.size;
+                output["memory_size"] = statistics.memory_size;
+                return output;
+            },
+            R"pbdoc(
+                Returns the counters of the shared cache of angular functions.
+
+                Returns
+                -------
+                dict
+                    ``hits``: lookups served from a cached table. ``misses``: lookups building or extending a table.
+                    ``size`` and ``memory_size``: tables currently held and their size in bytes.
+            )pbdoc"
+        )
+
+        .def_static("get_workspace_statistics",
+            []() {
+                const Workspace::Statistics statistics = Workspace::get_statistics();
+
+                const std::optional<size_t> heap_allocations = HeapCounter::get_allocations();
+
+                pybind11::dict output;
+                output["block_allocations"] = statistics.block_allocations;
+                output["reserved_bytes"] = statistics.reserved_bytes;
+                if (heap_allocations)
+                    output["heap_allocations"] = *heap_allocations;
+                else
+                    output["heap_allocations"] = pybind11::none();
+                return output;
+            },
+            R"pbdoc(
+                Returns the counters of the per-thread workspaces holding the scratch buffers of the scatterers.
+
+                Each thread grows its workspace until it fits the largest scatterer evaluated, after which
+                repeated computations take their scratch memory without allocating new blocks. The coefficients
+                of each scatterer and the amplitudes it returns are still allocated on the heap per point.
+
+                Returns
+                -------
+                dict
+                    ``block_allocations``: workspace blocks allocated by all the threads since start-up.
+                    ``reserved_bytes``: bytes currently held by the workspaces.
+                    ``heap_allocations``: every heap allocation of the C++ code of this module since start-up,
+                    counted only in builds configured with ``PYMIESIM_COUNT_HEAP_ALLOCATIONS=ON``, None otherwise.
+            )pbdoc"
+        )
+
+        .def_static("clear_size_parameter_cache",
+            []() {
+                SizeParameterTableCache::get_instance().clear();
+            },
+            R"pbdoc(
+                Removes the cached size-parameter tables and resets the cache counters.
+            )pbdoc"
+        )
+
+        .def_static("get_size_parameter_cache_statistics",
+            []() {
+                const SizeParameterTableCache::Statistics statistics = SizeParameterTableCache::get_instance().get_statistics();
+
+                pybind11::dict output;
+                output["hits"] = statistics.hits;
+                output["misses"] = statistics.misses;
+                output["evictions"] = statistics.evictions;
+                output["size"] = statistics.size;
+                output["capacity"] = statistics.capacity;
+                return output;
+            },
+            R"pbdoc(
+                Returns the counters of the cache of size-parameter tables.
+
+                The Riccati-Bessel and Bessel functions of the size parameter are shared by all the threads and
+                computed once per size parameter, so the counters do not depend on the thread schedule. The cache
+                is shared with the single scatterers.
+
+                Returns
+                -------
+                dict
+                    ``hits``, ``misses`` and ``evictions`` since the last clear, with the current ``size`` and ``capacity``.
+            )pbdoc"
+        )
+
         DEFINE_GETTERS_INTERFACE_6(a1, a2, a3, b1, b2, b3)
 
         DEFINE_GETTERS_INTERFACE_6(a11, a12, a13, b11, b12, b13)
@@ -172,5 +386,6 @@ PYBIND11_MODULE(interface_experiment, module) {
         DEFINE_GETTERS_INTERFACE_7(Qsca, Qext, Qabs, Qpr, Qforward, Qback, Qratio)
         DEFINE_GETTERS_INTERFACE_7(Csca, Cext, Cabs, Cpr, Cforward, Cback, Cratio)
         DEFINE_GETTERS_INTERFACE_1(g)
+        DEFINE_GETTERS_INTERFACE_1(regime)
         ;
 }
@@ -1,5 +1,7 @@
 #include "./fibonacci.h"
 
+#include <algorithm>
+
 
 // ------------------ Constructors ------------------
 FibonacciMesh::FibonacciMesh(size_t sampling, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius):
@@ -7,33 +9,79 @@ FibonacciMesh::FibonacciMesh(size_t sampling, double max_angle, double min_angle
 {
     this->compute_properties();
     this->compute_mesh();
+    this->quadrature_weights.assign(this->cartesian.x.size(), this->dOmega);
+
+    // The spiral is turned about its first point, any axis will do for an empty mesh
+    this->apply_orientation(this->cartesian.x.empty() ? std::array<double, 3>{0., 0., 1.} : this->get_principal_axis());
+}
+
+// ------------------ Methods ------------------
+void FibonacciMesh::apply_orientation(const std::array<double, 3>& principal_axis) {
     this->base_cartesian = cartesian;
 
-    this->rotate_around_center();
-    this->rotate_around_axis(rotation);
+    // The offsets and the rotation about the principal axis are composed, the points being rotated in a single pass
+    const Matrix3 offset_rotation = this->get_offset_rotation_matrix();
+    const Matrix3 mesh_rotation = compose_rotations(
+        this->get_rotation_matrix(apply_matrix(offset_rotation, principal_axis), this->rotation),
+        offset_rotation
+    );
+
+    this->cartesian.apply_matrix(mesh_rotation);
+    this->vertical_vector_field.apply_matrix(offset_rotation);
+    this->horizontal_vector_field.apply_matrix(offset_rotation);
+    this->spherical = this->cartesian.to_spherical();
 
     this->compute_vector_field();
     this->compute_projections();
 }
 
-// ------------------ Methods ------------------
-void FibonacciMesh::rotate_around_center() {
-    if (gamma_offset != 0.0) {
-        this->cartesian.rotate_about_axis('x', this->gamma_offset);
-        this->vertical_vector_field.rotate_about_axis('x', this->gamma_offset);
-        this->horizontal_vector_field.rotate_about_axis('x', this->gamma_offset);
+void FibonacciMesh::compute_rings(const std::vector<double>& mu, const std::vector<double>& polar_weights, const size_t azimuthal_sampling) {
+    const size_t n_points = mu.size() * azimuthal_sampling;
+    const double azimuthal_step = 2. * PI / azimuthal_sampling;
+
+    std::vector<double> cos_azimuth(azimuthal_sampling), sin_azimuth(azimuthal_sampling);
+    for (size_t j = 0; j < azimuthal_sampling; ++j) {
+        cos_azimuth[j] = cos(j * azimuthal_step);
+        sin_azimuth[j] = sin(j * azimuthal_step);
     }
 
-    if (phi_offset != 0.0) {
-        this->cartesian.rotate_about_axis('y', this->phi_offset);
-        this->vertical_vector_field.rotate_about_axis('y', this->phi_offset);
-        this->horizontal_vector_field.rotate_about_axis('y', this->phi_offset);
+    this->cartesian.x.resize(n_points);
+    this->cartesian.y.resize(n_points);
+    this->cartesian.z.resize(n_points);
+    this->quadrature_weights.resize(n_points);
+
+    // Ring by ring, the trapezoidal rule of a periodic function weights every azimuth alike
+    for (size_t k = 0; k < mu.size(); ++k) {
+        const double ring_radius = std::sqrt(std::max(0., 1. - mu[k] * mu[k]));
+        const double weight = polar_weights[k] * azimuthal_step;
+
+        for (size_t j = 0; j < azimuthal_sampling; ++j) {
+            const size_t i = k * azimuthal_sampling + j;
+
+            this->cartesian.x[i] = ring_radius * cos_azimuth[j];
+            this->cartesian.y[i] = ring_radius * sin_azimuth[j];
+            this->cartesian.z[i] = mu[k];
+            this->quadrature_weights[i] = weight;
+        }
     }
 }
 
-std::vector<std::vector<double>>
-FibonacciMesh::get_rotation_matrix(std::vector<double> rotation_axis, double rotation_angle) const {
-    double norm_rotation_axis = sqrt(pow(rotation_axis[0], 2) + pow(rotation_axis[1], 2) + pow(rotation_axis[2], 2));
+void FibonacciMesh::rotate_around_center() {
+    const Matrix3 offset_rotation = this->get_offset_rotation_matrix();
+
+    this->cartesian.apply_matrix(offset_rotation);
+    this->vertical_vector_field.apply_matrix(offset_rotation);
+    this->horizontal_vector_field.apply_matrix(offset_rotation);
+}
+
+Matrix3 FibonacciMesh::get_offset_rotation_matrix() const {
+    // Rotation about x by gamma_offset, then about y by phi_offset
+    return compose_rotations(get_axis_rotation_matrix('y', this->phi_offset), get_axis_rotation_matrix('x', this->gamma_offset));
+}
+
+Matrix3
+FibonacciMesh::get_rotation_matrix(std::array<double, 3> rotation_axis, double rotation_angle) const {
+    double norm_rotation_axis = sqrt(rotation_axis[0] * rotation_axis[0] + rotation_axis[1] * rotation_axis[1] + rotation_axis[2] * rotation_axis[2]);
 
     for (double &x: rotation_axis)
         x /= norm_rotation_axis;
@@ -44,66 +92,108 @@ FibonacciMesh::get_rotation_matrix(std::vector<double> rotation_axis, double rot
         c = -1 * sin(rotation_angle / 2.0) * rotation_axis[1],
         d = -1 * sin(rotation_angle / 2.0) * rotation_axis[2];
 
-    std::vector<std::vector<double>> matrix = {
+    return {{
         {a * a + b * b - c * c - d * d, 2 * (b * c + a * d), 2 * (b * d - a * c)},
         {2 * (b * c - a * d), a * a + c * c - b * b - d * d, 2 * (c * d + a * b)},
         {2 * (b * d + a * c), 2 * (c * d - a * b), a * a + d * d - b * b - c * c}
-    };
-
-    return matrix;
+    }};
 }
 
 void FibonacciMesh::compute_vector_field() {
     parallel_vector = VectorField(sampling);
     perpendicular_vector = VectorField(sampling);
 
+    // Unit vectors (-y, x, 0) and (x z, y z, -(x^2 + y^2)), normalized in the same pass
+    auto set_normalized = [](double *vector, const double a, const double b, const double c) {
+        const double norm = std::sqrt(a * a + b * b + c * c);
+
+        if (norm > 0.0) {
+            const double inverse_norm = 1.0 / norm;
+            vector[0] = a * inverse_norm;
+            vector[1] = b * inverse_norm;
+            vector[2] = c * inverse_norm;
+        } else {
+            vector[0] = a;
+            vector[1] = b;
+            vector[2] = c;
+        }
+    };
+
     for (size_t i = 0; i < sampling; i++){
-        this->perpendicular_vector.at(i,0) = -cartesian.y[i] ;
-        this->perpendicular_vector.at(i,1) = cartesian.x[i] ;
-        this->perpendicular_vector.at(i,2) = 0.0;
+        const double x = this->cartesian.x[i], y = this->cartesian.y[i], z = this->cartesian.z[i];
 
-        this->parallel_vector.at(i,0) = this->cartesian.x[i] * this->cartesian.z[i] ;
-        this->parallel_vector.at(i,1) = this->cartesian.y[i] * this->cartesian.z[i] ;
-        this->parallel_vector.at(i,2) = -( pow( this->cartesian.x[i], 2 ) + pow( this->cartesian.y[i], 2 ) );
+        set_normalized(&this->perpendicular_vector.at(i, 0), -y, x, 0.0);
+        set_normalized(&this->parallel_vector.at(i, 0), x * z, y * z, -(x * x + y * y));
     }
-
-    this->parallel_vector.normalize();
-    this->perpendicular_vector.normalize();
 }
 
 void FibonacciMesh::compute_projections() {
-    this->horizontal_parallel_projection = this->parallel_vector.get_scalar_product(this->horizontal_vector_field);
+    const size_t n_points = this->parallel_vector.sampling;
+
+    this->horizontal_parallel_projection.resize(n_points);
+    this->vertical_parallel_projection.resize(n_points);
+    this->horizontal_perpendicular_projection.resize(n_points);
+    this->vertical_perpendicular_projection.resize(n_points);
 
-    this->vertical_parallel_projection = this->parallel_vector.get_scalar_product(this->vertical_vector_field);
+    const std::array<double, 3>
+        horizontal = {this->horizontal_vector_field[0], this->horizontal_vector_field[1], this->horizontal_vector_field[2]},
+        vertical = {this->vertical_vector_field[0], this->vertical_vector_field[1], this->vertical_vector_field[2]};
 
-    this->horizontal_perpendicular_projection = this->perpendicular_vector.get_scalar_product(this->horizontal_vector_field);
+    // The four scalar products in a single pass over the two vector fields
+    for (size_t i = 0; i < n_points; ++i) {
+        const double *parallel = &this->parallel_vector.at(i, 0), *perpendicular = &this->perpendicular_vector.at(i, 0);
 
-    this->vertical_perpendicular_projection = this->perpendicular_vector.get_scalar_product(this->vertical_vector_field);
+        this->horizontal_parallel_projection[i] = parallel[0] * horizontal[0] + parallel[1] * horizontal[1] + parallel[2] * horizontal[2];
+        this->vertical_parallel_projection[i] = parallel[0] * vertical[0] + parallel[1] * vertical[1] + parallel[2] * vertical[2];
+        this->horizontal_perpendicular_projection[i] = perpendicular[0] * horizontal[0] + perpendicular[1] * horizontal[1] + perpendicular[2] * horizontal[2];
+        this->vertical_perpendicular_projection[i] = perpendicular[0] * vertical[0] + perpendicular[1] * vertical[1] + perpendicular[2] * vertical[2];
+    }
 }
 
 void FibonacciMesh::compute_mesh() {
-    double golden_angle = PI * (3. - sqrt(5.));  // golden angle = 2.39996322972865332
+    const double golden_angle = PI * (3. - sqrt(5.));  // golden angle = 2.39996322972865332
+    const size_t start = this->get_first_spiral_index();
+    const size_t n_points = std::min(this->sampling, this->true_number_of_sample - start);
+
+    this->cartesian.x.resize(n_points);
+    this->cartesian.y.resize(n_points);
+    this->cartesian.z.resize(n_points);
+
+    for (size_t k = 0; k < n_points; k++){
+        const size_t i = start + k;
 
-    for (size_t i = 0; i < this->true_number_of_sample; i++){
         double
             z = 1 - (2. * i) / (true_number_of_sample - 1),
             theta = golden_angle * i,
             radius = sqrt(1 - z * z);
 
-        double x = cos(theta) * radius;
-        double y = sin(theta) * radius;
-        double angle = - (asin(z) - PI / 2.0);
+        this->cartesian.x[k] = cos(theta) * radius;
+        this->cartesian.y[k] = sin(theta) * radius;
+        this->cartesian.z[k] = z;
+    }
+}
+
+size_t FibonacciMesh::get_first_spiral_index() const {
+    const size_t n_spiral = this->true_number_of_sample;
 
-        if (angle < this->min_angle)
-            continue;
+    // Same test as the spiral walk: polar angle of point i below min_angle
+    auto is_inside_hole = [&](const size_t i) {
+        const double z = 1 - (2. * i) / (n_spiral - 1);
+        return - (asin(z) - PI / 2.0) < this->min_angle;
+    };
 
-        if (this->cartesian.z.size() >= this->sampling)
-            break;
+    // z decreases along the spiral, the points in the hole are the leading ones, up to 1 - 2 i / (n - 1) = cos(min_angle)
+    double estimate = std::ceil((1. - cos(this->min_angle)) * (n_spiral - 1) / 2.);
+    size_t start = std::isfinite(estimate) ? static_cast<size_t>(std::clamp(estimate, 0., static_cast<double>(n_spiral))) : 0;
 
-        this->cartesian.z.push_back(z);
-        this->cartesian.x.push_back(x);
-        this->cartesian.y.push_back(y);
-    }
+    // Correct the rounding of the estimate
+    while (start > 0 && !is_inside_hole(start - 1))
+        --start;
+
+    while (start < n_spiral && is_inside_hole(start))
+        ++start;
+
+    return start;
 }
 
 void FibonacciMesh::compute_properties(){
@@ -117,8 +207,8 @@ void FibonacciMesh::compute_properties(){
     this->true_number_of_sample = (size_t) ( this->sampling * ratio );
 }
 
-std::vector<double> FibonacciMesh::get_principal_axis() const {
-    std::vector<double> principal_axis = {
+std::array<double, 3> FibonacciMesh::get_principal_axis() const {
+    std::array<double, 3> principal_axis = {
         this->cartesian.x[0],
         this->cartesian.y[0],
         this->cartesian.z[0]
@@ -128,20 +218,7 @@ std::vector<double> FibonacciMesh::get_principal_axis() const {
 }
 
 void FibonacciMesh::rotate_around_axis(double angle) {
-    std::vector<double> rotation_axis = this->get_principal_axis();
-
-    std::vector<std::vector<double>> rotation_matrix = this->get_rotation_matrix(rotation_axis, angle);
-
-    for (size_t i = 0; i < cartesian.x.size(); ++i){
-        double
-            x = this->cartesian.x[i],
-            y = this->cartesian.y[i],
-            z = this->cartesian.z[i];
-
-        this->cartesian.x[i] = rotation_matrix[0][0] * x + rotation_matrix[0][1] * y + rotation_matrix[0][2] * z;
-        this->cartesian.y[i] = rotation_matrix[1][0] * x + rotation_matrix[1][1] * y + rotation_matrix[1][2] * z;
-        this->cartesian.z[i] = rotation_matrix[2][0] * x + rotation_matrix[2][1] * y + rotation_matrix[2][2] * z;
-    }
+    this->cartesian.apply_matrix(this->get_rotation_matrix(this->get_principal_axis(), angle));
 
     this->spherical = this->cartesian.to_spherical();
 }
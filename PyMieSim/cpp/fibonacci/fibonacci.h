@@ -35,6 +35,8 @@ class FibonacciMesh {
         std::vector<double> horizontal_perpendicular_projection;
         std::vector<double> vertical_perpendicular_projection;
 
+        std::vector<double> quadrature_weights;  // solid angle of each point, dOmega for every point of the spiral
+
         FibonacciMesh() = default;
 
         /**
@@ -49,6 +51,22 @@ class FibonacciMesh {
          */
         FibonacciMesh(size_t sampling, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius = 1.0);
 
+        /**
+         *  @brief Orients the points generated around the z axis, then computes their spherical coordinates, vector fields and projections.
+         *  @param principal_axis The axis, before the offsets, about which the mesh is turned by its rotation angle.
+         *  @note The offsets and the rotation are composed in a single matrix, the points being rotated in one pass.
+         */
+        void apply_orientation(const std::array<double, 3>& principal_axis);
+
+        /**
+         *  @brief Generates rings of points about the z axis, for the product rules of the derived meshes.
+         *  @param mu The cosines of the polar angles of the rings.
+         *  @param polar_weights The weights of the polar rule, one per ring.
+         *  @param azimuthal_sampling The number of equally spaced points per ring.
+         *  @note Point i of ring k is stored at k * azimuthal_sampling + i, with solid angle polar_weights[k] * 2 pi / azimuthal_sampling.
+         */
+        void compute_rings(const std::vector<double>& mu, const std::vector<double>& polar_weights, const size_t azimuthal_sampling);
+
         /**
          *  @brief Rotates the mesh around its center based on the specified phi and gamma offsets.
          *  @note This function applies rotations to the Cartesian coordinates and vector fields.
@@ -75,10 +93,18 @@ class FibonacciMesh {
 
         /**
          *  @brief Computes the Fibonacci mesh based on the specified parameters.
-         *  @note This function generates the mesh points in Cartesian coordinates and computes the corresponding spherical coordinates.
+         *  @note The points are those of the golden spiral over the full sphere of true_number_of_sample points that fall in
+         *  the cap or annulus. Only these are generated, from get_first_spiral_index, so the cost is proportional to sampling.
          */
         void compute_mesh();
 
+        /**
+         *  @brief Returns the index along the full-sphere spiral of the first point at or beyond min_angle.
+         *  @note Computed from the closed form of z along the spiral, then corrected so that the selection is the same as
+         *  testing the points one by one.
+         */
+        size_t get_first_spiral_index() const;
+
         /**
          *  @brief Computes the properties of the Fibonacci mesh, including solid angle and sampling ratio.
          */
@@ -86,16 +112,22 @@ class FibonacciMesh {
 
         /**
          *  @brief Gets the principal axis of the Fibonacci mesh.
-         *  @return A vector containing the principal axis coordinates.
+         *  @return The coordinates of the first point of the mesh.
          */
-        std::vector<double> get_principal_axis() const;
+        std::array<double, 3> get_principal_axis() const;
 
         /**
          *  @brief Computes the rotation matrix for a given rotation axis and angle.
          *  @param rotation_axis The axis around which to rotate.
          *  @param rotation_angle The angle by which to rotate (in radians).
-         *  @return The rotation matrix as a 3x3 vector.
+         *  @return The rotation matrix.
+         */
+        Matrix3 get_rotation_matrix(std::array<double, 3> rotation_axis, double rotation_angle) const;
+
+        /**
+         *  @brief Computes the rotation of the gamma offset about x followed by the phi offset about y.
+         *  @return The composed rotation matrix.
          */
-        std::vector<std::vector<double>> get_rotation_matrix(std::vector<double> rotation_axis, double rotation_angle) const;
+        Matrix3 get_offset_rotation_matrix() const;
 
 };
@@ -0,0 +1,101 @@
+#include "./gauss_legendre.h"
+
+#include <algorithm>
+#include "../utils/math.h"
+
+
+namespace {
+    // Ratio of the mean circumference of the annulus to its polar width, resolving both directions alike
+    double get_aspect_ratio(const double max_angle, const double min_angle) {
+        const double polar_width = std::abs(max_angle - min_angle);
+        const double solid_angle = 2. * PI * std::abs(cos(min_angle) - cos(max_angle));
+
+        return (polar_width > 0.0) ? solid_angle / (polar_width * polar_width) : 1.0;
+    }
+}
+
+// ------------------ Constructors ------------------
+GaussLegendreMesh::GaussLegendreMesh(size_t sampling, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius)
+{
+    this->max_angle = max_angle;
+    this->min_angle = min_angle;
+    this->phi_offset = phi_offset;
+    this->gamma_offset = gamma_offset;
+    this->rotation = rotation;
+    this->radius = radius;
+
+    this->Omega = 2. * PI * std::abs(cos(this->min_angle) - cos(this->max_angle));
+    this->compute_sampling(sampling);
+    this->dOmega = this->Omega / this->sampling;
+
+    this->compute_product_rule();
+
+    // The rings are centered on the z axis, the rotation turns them about the detector axis
+    this->apply_orientation({0., 0., 1.});
+}
+
+// ------------------ Methods ------------------
+void GaussLegendreMesh::compute_sampling(const size_t sampling) {
+    const double aspect_ratio = get_aspect_ratio(this->max_angle, this->min_angle);
+
+    this->polar_sampling = std::max<size_t>(1, static_cast<size_t>(std::round(std::sqrt(sampling / aspect_ratio))));
+    this->azimuthal_sampling = std::max<size_t>(1, static_cast<size_t>(std::round(static_cast<double>(sampling) / this->polar_sampling)));
+
+    this->sampling = this->polar_sampling * this->azimuthal_sampling;
+    this->true_number_of_sample = this->sampling;
+}
+
+void GaussLegendreMesh::compute_product_rule() {
+    auto [mu, polar_weights] = get_gauss_legendre_rule(this->polar_sampling, cos(this->max_angle), cos(this->min_angle));
+
+    this->compute_rings(mu, polar_weights, this->azimuthal_sampling);
+}
+
+
+// ------------------ FejerMesh ------------------
+FejerMesh::FejerMesh(size_t level, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius)
+:   level(level)
+{
+    this->max_angle = max_angle;
+    this->min_angle = min_angle;
+    this->phi_offset = phi_offset;
+    this->gamma_offset = gamma_offset;
+    this->rotation = rotation;
+    this->radius = radius;
+
+    const std::array<size_t, 2> level_sampling = get_level_sampling(level, max_angle, min_angle);
+    this->polar_intervals = level_sampling[0];
+    this->azimuthal_sampling = level_sampling[1];
+
+    this->sampling = (this->polar_intervals - 1) * this->azimuthal_sampling;
+    this->true_number_of_sample = this->sampling;
+    this->Omega = 2. * PI * std::abs(cos(this->min_angle) - cos(this->max_angle));
+    this->dOmega = this->Omega / this->sampling;
+
+    auto [mu, polar_weights] = get_fejer_rule(this->polar_intervals, cos(this->max_angle), cos(this->min_angle));
+    this->compute_rings(mu, polar_weights, this->azimuthal_sampling);
+
+    this->apply_orientation({0., 0., 1.});
+}
+
+std::array<size_t, 2> FejerMesh::get_level_sampling(const size_t level, const double max_angle, const double min_angle) {
+    const size_t base_polar_intervals = 4;
+    const size_t base_azimuthal_sampling = std::max<size_t>(4, static_cast<size_t>(std::round(get_aspect_ratio(max_angle, min_angle) * (base_polar_intervals - 1))));
+
+    return {base_polar_intervals << level, base_azimuthal_sampling << level};
+}
+
+size_t FejerMesh::get_sampling(const size_t level, const double max_angle, const double min_angle) {
+    const std::array<size_t, 2> level_sampling = get_level_sampling(level, max_angle, min_angle);
+    return (level_sampling[0] - 1) * level_sampling[1];
+}
+
+size_t FejerMesh::get_nested_index(const size_t coarse_index) const {
+    // Ring k of the coarse mesh is ring 2 k + 1 here, its point j the point 2 j
+    const size_t coarse_azimuthal_sampling = this->azimuthal_sampling / 2;
+    const size_t ring = coarse_index / coarse_azimuthal_sampling, point = coarse_index % coarse_azimuthal_sampling;
+
+    return (2 * ring + 1) * this->azimuthal_sampling + 2 * point;
+}
+
+// -
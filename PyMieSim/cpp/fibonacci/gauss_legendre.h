@@ -0,0 +1,97 @@
+#pragma once
+
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include "./fibonacci.h"
+
+
+/**
+ * @brief Product quadrature mesh of a detector: Gauss-Legendre in the cosine of the polar angle about the detector
+ * axis, trapezoidal in the azimuth.
+ *
+ * Both rules converge spectrally for the smooth fields collected over a cap or an annulus, where the Fibonacci spiral
+ * is only a low order rule. The points carry unequal solid angles, held in quadrature_weights, dOmega being their mean.
+ * The mesh derives from FibonacciMesh so that detectors and far-field evaluations accept either.
+ */
+class GaussLegendreMesh : public FibonacciMesh {
+    public:
+        size_t polar_sampling = 0;
+        size_t azimuthal_sampling = 0;
+
+        GaussLegendreMesh() = default;
+
+        /**
+         *  @brief Constructs a Gauss-Legendre product mesh with the specified parameters.
+         *  @param sampling The approximate number of sampling points, split between polar nodes and azimuthal points.
+         *  @param max_angle The maximum angle for the mesh points (in radians).
+         *  @param min_angle The minimum angle for the mesh points (in radians).
+         *  @param phi_offset The offset for the phi angle (in radians).
+         *  @param gamma_offset The offset for the gamma angle (in radians).
+         *  @param rotation The rotation angle for the mesh about its axis (in radians).
+         *  @param radius The radius of the mesh (default is 1.0).
+         *  @note The mesh holds polar_sampling * azimuthal_sampling points, stored in sampling.
+         */
+        GaussLegendreMesh(size_t sampling, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius = 1.0);
+
+        /**
+         *  @brief Splits the sampling between polar nodes and azimuthal points.
+         *  @param sampling The requested number of points.
+         *  @note The ratio of azimuthal to polar points is the mean circumference of the annulus over its polar width,
+         *  so that both directions are resolved alike.
+         */
+        void compute_sampling(const size_t sampling);
+
+        /**
+         *  @brief Generates the nodes and their solid angles around the z axis.
+         */
+        void compute_product_rule();
+};
+
+
+/**
+ * @brief Nested product mesh: Fejer's second rule in the cosine of the polar angle about the detector axis, trapezoidal
+ * in the azimuth, both doubled from one level to the next.
+ *
+ * Every point of a level is a point of the next one, so that refining the mesh only evaluates the field at the new
+ * points. The rules converge spectrally like the Gauss-Legendre product and, unlike it, never sample the axis itself,
+ * where the parallel and perpendicular vectors are undefined.
+ */
+class FejerMesh : public FibonacciMesh {
+    public:
+        size_t level = 0;
+        size_t polar_intervals = 0;  // the rings are the Fejer nodes of this many intervals, one less than their number
+        size_t azimuthal_sampling = 0;
+
+        FejerMesh() = default;
+
+        /**
+         *  @brief Constructs the nested mesh of the given level.
+         *  @param level The refinement level, each level holding about four times the points of the previous one.
+         *  @param max_angle The maximum angle for the mesh points (in radians).
+         *  @param min_angle The minimum angle for the mesh points (in radians).
+         *  @param phi_offset The offset for the phi angle (in radians).
+         *  @param gamma_offset The offset for the gamma angle (in radians).
+         *  @param rotation The rotation angle for the mesh about its axis (in radians).
+         *  @param radius The radius of the mesh (default is 1.0).
+         */
+        FejerMesh(size_t level, double max_angle, double min_angle, double phi_offset, double gamma_offset, double rotation, double radius = 1.0);
+
+        /**
+         *  @brief Returns the number of polar intervals and of points per ring of a level.
+         *  @note Level 0 holds 3 rings, the points per ring following the aspect ratio of GaussLegendreMesh::compute_sampling.
+         */
+        static std::array<size_t, 2> get_level_sampling(const size_t level, const double max_angle, const double min_angle);
+
+        /**
+         *  @brief Returns the number of points of a level without building it.
+         */
+        static size_t get_sampling(const size_t level, const double max_angle, const double min_angle);
+
+        /**
+         *  @brief Returns the index in this mesh of a point of the mesh one level below.
+         *  @param coarse_index The index of the point in the coarser mesh.
+         */
+        size_t get_nested_index(const size_t coarse_index) const;
+};
@@ -1,6 +1,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include "fibonacci.h"
+#include "gauss_legendre.h"
 
 void register_fibonacci(pybind11::module_& module) {
     pybind11::class_<FibonacciMesh>(module, "FIBONACCIMESH")
@@ -74,6 +75,12 @@ void register_fibonacci(pybind11::module_& module) {
             &FibonacciMesh::Omega,
             "Total solid angle covered by the mesh."
         )
+        .def_property_readonly("_cpp_quadrature_weights",
+            [](const FibonacciMesh& self) {
+                return pybind11::array_t<double>(self.quadrature_weights.size(), self.quadrature_weights.data());
+            },
+            "Solid angle covered by each point, used as quadrature weight by the coupling integrals."
+        )
         .def_readonly("_cpp_phi_offset",
             &FibonacciMesh::phi_offset,
             "Azimuthal angle offset (in radians) for the mesh."
@@ -163,4 +170,44 @@ void register_fibonacci(pybind11::module_& module) {
             )pbdoc"
         )
     ;
+
+    pybind11::class_<GaussLegendreMesh, FibonacciMesh>(module, "GAUSSLEGENDREMESH")
+        .def(pybind11::init<size_t, double, double, double, double, double>(),
+            pybind11::arg("sampling"),
+            pybind11::arg("max_angle"),
+            pybind11::arg("min_angle"),
+            pybind11::arg("phi_offset"),
+            pybind11::arg("gamma_offset"),
+            pybind11::arg("rotation_angle"),
+            R"pbdoc(
+                Initialize a Gauss-Legendre product mesh with specified parameters.
+
+                The points lie on rings at the Gauss-Legendre nodes in the cosine of the polar angle about the
+                detector axis, equally spaced in azimuth. Their solid angles are given by `_cpp_quadrature_weights`.
+
+                Parameters
+                ----------
+                sampling : int
+                    Approximate number of sampling points, split between rings and points per ring.
+                max_angle : float
+                    Maximum angle for the mesh points (in radians).
+                min_angle : float
+                    Minimum angle for the mesh points (in radians).
+                phi_offset : float
+                    Offset for the azimuthal angle (phi) in radians.
+                gamma_offset : float
+                    Offset for the polar angle (gamma) in radians.
+                rotation_angle : float
+                    Rotation angle for the mesh about its axis in radians.
+            )pbdoc"
+        )
+        .def_readonly("_cpp_polar_sampling",
+            &GaussLegendreMesh::polar_sampling,
+            "Number of Gauss-Legendre rings."
+        )
+        .def_readonly("_cpp_azimuthal_sampling",
+            &GaussLegendreMesh::azimuthal_sampling,
+            "Number of points per ring."
+        )
+    ;
 }
@@ -1,11 +1,15 @@
 #include "mode_field.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 
 // ________________________________ COMMON ___________________________________
 // ________________________________ STD ___________________________________
 
 std::vector<complex128>
-ModeField::get_unstructured(std::vector<double> x_coords, std::vector<double> y_coords) const {
+ModeField::get_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const {
    if (this->mode_id.mode_family == "LP")
       return this->get_LP_unstructured(x_coords, y_coords);
    if (this->mode_id.mode_family == "HG")
@@ -18,72 +22,84 @@ ModeField::get_unstructured(std::vector<double> x_coords, std::vector<double> y_
    throw std::runtime_error("Invalid mode family");
 }
 
-void ModeField::normalize_coordinates(std::vector<double> &x_coords, std::vector<double> &y_coords) const {
+double ModeField::get_coordinate_scale(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const {
    double max_norm = 0.0;
-   for (size_t i = 0; i < x_coords.size(); ++i) {
-      double norm = std::sqrt(x_coords[i] * x_coords[i] + y_coords[i] * y_coords[i]);
-      if (norm > max_norm)
-         max_norm = norm;
-   }
+   for (size_t i = 0; i < x_coords.size(); ++i)
+      max_norm = std::max(max_norm, x_coords[i] * x_coords[i] + y_coords[i] * y_coords[i]);
 
-   if (max_norm != 0) {  // Avoid division by zero
-      for (size_t i = 0; i < x_coords.size(); ++i) {
-         x_coords[i] /= max_norm;
-         y_coords[i] /= max_norm;
-      }
-   }
-}
+   max_norm = std::sqrt(max_norm);
 
-void ModeField::normalize_fields(std::vector<complex128> &field) const {
-   double norm = 0.0;
-   for (const complex128& f : field)
-      norm += std::norm(f);
+   return (max_norm != 0) ? 1.0 / max_norm : 1.0;  // Avoid division by zero
+}
 
-   norm = std::sqrt(norm);
+void ModeField::normalize_fields(std::vector<complex128> &field, double squared_norm) const {
+   const double norm = std::sqrt(squared_norm);
 
    if (norm != 0) {  // Avoid division by zero
+      const double inverse_norm = 1.0 / norm;
       for (complex128& f : field)
-         f /= norm;
+         f *= inverse_norm;
    }
 }
 
 
 // ________________________________ LP ___________________________________
 
-[[nodiscard]] std::vector<complex128>
-ModeField::get_LP_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords) const {
+double ModeField::get_bessel_zero(int order, int rank) {
+   static std::mutex mutex;
+   static std::map<std::pair<int, int>, double> zeros;
 
-   size_t azimuthal_number = mode_id.number_0;
-   size_t radial_number = mode_id.number_1;
+   std::lock_guard<std::mutex> lock(mutex);
 
-   std::vector<complex128> field(x_coords.size());
+   auto it = zeros.find({order, rank});
+   if (it != zeros.end())
+      return it->second;
 
-   // Normalize the coordinates
-   this->normalize_coordinates(x_coords, y_coords);
+   std::vector<double> rj0(rank), rj1(rank), ry0(rank), ry1(rank);
+   Special_::compute_bessel_zeros(order, rank, &rj0[0], &rj1[0], &ry0[0], &ry1[0]);
+
+   zeros[{order, rank}] = rj0[rank - 1];
+   return rj0[rank - 1];
+}
 
-   std::vector<double> rj0(radial_number), rj1(radial_number), ry0(radial_number), ry1(radial_number);
+[[nodiscard]] std::vector<complex128>
+ModeField::get_LP_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const {
 
-   // Calculate Bessel zeros for the radial and azimuthal components
-   Special_::compute_bessel_zeros(azimuthal_number, radial_number, &rj0[0], &rj1[0], &ry0[0], &ry1[0]);
+   const int azimuthal_number = mode_id.number_0;
+   const int radial_number = mode_id.number_1;
+   const size_t size = x_coords.size();
 
-   double x, y, r, phi, azimuthal_part;
+   std::vector<complex128> field(size);
 
-   for (size_t i = 0; i < x_coords.size(); ++i) {
-      x = x_coords[i];
-      y = y_coords[i];
+   // The coordinates are normalized to the unit disk, the radial_number-th zero of J_azimuthal_number falling on its edge
+   const double scale = this->get_coordinate_scale(x_coords, y_coords) * get_bessel_zero(azimuthal_number, radial_number);
 
-      r = std::sqrt(x * x + y * y);
-      phi = std::atan2(y, x);
+   std::vector<double> argument(size), radial_part(size);
+   for (size_t i = 0; i < size; ++i)
+      argument[i] = std::sqrt(x_coords[i] * x_coords[i] + y_coords[i] * y_coords[i]) * scale;
 
-      complex128 radial_part = Cylindrical_::Jn(azimuthal_number, r * rj0[radial_number-1]);
+   Special_::compute_Jn_array(azimuthal_number, argument.data(), radial_part.data(), size);
 
-      azimuthal_part = std::cos(azimuthal_number * phi);
+   double squared_norm = 0.0;
+   for (size_t i = 0; i < size; ++i) {
+      // cos(azimuthal_number * phi) as the Chebyshev polynomial of cos(phi), the origin taking phi = 0
+      const double r = std::sqrt(x_coords[i] * x_coords[i] + y_coords[i] * y_coords[i]);
+      const double cos_phi = (r != 0.0) ? x_coords[i] / r : 1.0;
+
+      double azimuthal_part = 1.0, previous = cos_phi;
+      for (int n = 0; n < azimuthal_number; ++n) {
+         const double next = 2.0 * cos_phi * azimuthal_part - previous;
+         previous = azimuthal_part;
+         azimuthal_part = next;
+      }
 
-      field[i] = radial_part * azimuthal_part;
+      const double value = radial_part[i] * azimuthal_part;
+      field[i] = value;
+      squared_norm += value * value;
    }
 
    // Normalization to L2 norm of 1
-   this->normalize_fields(field);
+   this->normalize_fields(field, squared_norm);
 
    return field;
 }
@@ -115,8 +131,35 @@ double ModeField::hermite_imp(unsigned n, double x) const {
 }
 
 
+void ModeField::hermite_array(unsigned n, const double *x, double *output, size_t size) const {
+   constexpr size_t block_size = 64;
+
+   for (size_t start = 0; start < size; start += block_size) {
+      const size_t count = std::min(block_size, size - start);
+      const double *x_block = x + start;
+
+      double p0[block_size], p1[block_size];
+
+      for (size_t i = 0; i < count; ++i) {
+         p0[i] = 1;
+         p1[i] = 2 * x_block[i];
+      }
+
+      for (unsigned c = 1; c < n; ++c)
+         for (size_t i = 0; i < count; ++i) {
+            const double next = this->hermite_next(c, x_block[i], p1[i], p0[i]);
+            p0[i] = p1[i];
+            p1[i] = next;
+         }
+
+      for (size_t i = 0; i < count; ++i)
+         output[start + i] = (n == 0) ? p0[i] : p1[i];
+   }
+}
+
+
 // Helper function to calculate the Hermite-Gaussian mode field amplitude
-std::vector<complex128> ModeField::get_HG_unstructured(std::vector<double>& x_coords, std::vector<double>& y_coords, double wavelength, double waist_radius, double z) const {
+std::vector<complex128> ModeField::get_HG_unstructured(const std::vector<double>& x_coords, const std::vector<double>& y_coords, double wavelength, double waist_radius, double z) const {
 
    size_t x_number = this->mode_id.number_0;
    size_t y_number = this->mode_id.number_1;
@@ -127,7 +170,7 @@ std::vector<complex128> ModeField::get_HG_unstructured(std::vector<double>& x_co
    std::vector<complex128> field(x_coords.size());
 
    // Normalize the coordinates
-   this->normalize_coordinates(x_coords, y_coords);
+   const double scale = this->get_coordinate_scale(x_coords, y_coords);
 
    // Calculate the beam width at distance z
    double w = w0 * std::sqrt(1 + (z * wavelength / (PI * w0 * w0)) * (z * wavelength / (PI * w0 * w0)));
@@ -139,27 +182,37 @@ std::vector<complex128> ModeField::get_HG_unstructured(std::vector<double>& x_co
    // Gouy phase shift at z
    double gouy_phase = std::atan(z * PI / (wavelength * w0 * w0));
 
-   // Process each coordinate
+   const double hermite_scale = std::sqrt(2) / w;
+   double squared_norm = 0.0;
+
+   // Hermite polynomial factors, evaluated for all the points at once
+   std::vector<double> x_argument(x_coords.size()), y_argument(y_coords.size()), Hn(x_coords.size()), Hm(y_coords.size());
    for (size_t i = 0; i < x_coords.size(); ++i) {
-      double x = x_coords[i];
-      double y = y_coords[i];
+      x_argument[i] = hermite_scale * (x_coords[i] * scale);
+      y_argument[i] = hermite_scale * (y_coords[i] * scale);
+   }
 
-      // Hermite polynomial factors
-      double Hn = this->hermite_imp(x_number, std::sqrt(2) * x / w);
-      double Hm = this->hermite_imp(y_number, std::sqrt(2) * y / w);
+   this->hermite_array(x_number, x_argument.data(), Hn.data(), x_coords.size());
+   this->hermite_array(y_number, y_argument.data(), Hm.data(), y_coords.size());
+
+   // Process each coordinate
+   for (size_t i = 0; i < x_coords.size(); ++i) {
+      double x = x_coords[i] * scale;
+      double y = y_coords[i] * scale;
 
       // Amplitude calculation
-      double amplitude = Hn * Hm * std::exp(-((x * x + y * y) / (w * w)));
+      double amplitude = Hn[i] * Hm[i] * std::exp(-((x * x + y * y) / (w * w)));
 
       // Phase calculation including Gouy phase and spherical phase factor
       double phase = -k * ((x * x + y * y) / (2 * R)) + (x_number + y_number) * gouy_phase;
 
       // Combine amplitude and phase into a complex field
       field[i] = complex128(amplitude * std::cos(phase), amplitude * std::sin(phase));
+      squared_norm += amplitude * amplitude;
    }
 
    // Normalization to L2 norm of 1
-   this->normalize_fields(field);
+   this->normalize_fields(field, squared_norm);
 
    return field;
 }
@@ -226,7 +279,36 @@ double ModeField::laguerre_imp(unsigned n, unsigned m, double x) const
 }
 
 
-std::vector<complex128> ModeField::get_LG_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords, double wavelength, double waist_radius, double z) const {
+void ModeField::laguerre_array(unsigned n, unsigned m, const double *x, double *output, size_t size) const
+{
+   constexpr size_t block_size = 64;
+
+   for (size_t start = 0; start < size; start += block_size) {
+      const size_t count = std::min(block_size, size - start);
+      const double *x_block = x + start;
+
+      double p0[block_size], p1[block_size];
+
+      // The associated recurrence reduces to the plain one for m = 0
+      for (size_t i = 0; i < count; ++i) {
+         p0[i] = 1;
+         p1[i] = m + 1 - x_block[i];
+      }
+
+      for (unsigned c = 1; c < n; ++c)
+         for (size_t i = 0; i < count; ++i) {
+            const double next = this->laguerre_next(c, m, x_block[i], p1[i], p0[i]);
+            p0[i] = p1[i];
+            p1[i] = next;
+         }
+
+      for (size_t i = 0; i < count; ++i)
+         output[start + i] = (n == 0) ? p0[i] : p1[i];
+   }
+}
+
+
+std::vector<complex128> ModeField::get_LG_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords, double wavelength, double waist_radius, double z) const {
 
    size_t azimuthal_number = mode_id.number_0;
    size_t radial_number = mode_id.number_1;
@@ -238,32 +320,47 @@ std::vector<complex128> ModeField::get_LG_unstructured(std::vector<double> &x_co
    std::vector<complex128> field(x_coords.size());
 
    // Normalize the coordinates
-   this->normalize_coordinates(x_coords, y_coords);
+   const double scale = this->get_coordinate_scale(x_coords, y_coords);
 
-   // Convert to polar coordinates and calculate field values
+   // Beam parameters at z, shared by every point
+   double w = w0 * std::sqrt(1 + (z * wavelength / (PI * w0 * w0)) * (z * wavelength / (PI * w0 * w0)));
+   double R = (z == 0) ? std::numeric_limits<double>::infinity() : z * (1 + (PI * w0 * w0 / (z * wavelength)) * (PI * w0 * w0 / (z * wavelength)));
+   double gouy_phase = std::atan(z * PI / (wavelength * w0 * w0));
+   double constant_phase = (2 * azimuthal_number + radial_number + 1) * gouy_phase;
+
+   double squared_norm = 0.0;
+
+   // Laguerre polynomial, evaluated for all the points at once
+   std::vector<double> argument(x_coords.size()), L_pl(x_coords.size());
    for (size_t i = 0; i < x_coords.size(); ++i) {
-        double x = x_coords[i];
-        double y = y_coords[i];
-        double r = std::sqrt(x * x + y * y);
-        double theta = std::atan2(y, x);
+      double x = x_coords[i] * scale;
+      double y = y_coords[i] * scale;
+      double r = std::sqrt(x * x + y * y);
 
-      // Beam parameters at z
-      double w = w0 * std::sqrt(1 + (z * wavelength / (PI * w0 * w0)) * (z * wavelength / (PI * w0 * w0)));
-      double R = (z == 0) ? std::numeric_limits<double>::infinity() : z * (1 + (PI * w0 * w0 / (z * wavelength)) * (PI * w0 * w0 / (z * wavelength)));
-      double gouy_phase = std::atan(z * PI / (wavelength * w0 * w0));
+      argument[i] = 2 * r * r / (w * w);
+   }
 
-      // Laguerre polynomial
-      double L_pl = laguerre_imp(azimuthal_number, radial_number, 2 * r * r / (w * w));
-      double amplitude = std::pow(std::sqrt(2) * r / w, radial_number) * L_pl * std::exp(-r * r / (w * w));
+   this->laguerre_array(azimuthal_number, radial_number, argument.data(), L_pl.data(), x_coords.size());
+
+   // Convert to polar coordinates and calculate field values
+   for (size_t i = 0; i < x_coords.size(); ++i) {
+      double x = x_coords[i] * scale;
+      double y = y_coords[i] * scale;
+      double r = std::sqrt(x * x + y * y);
+      double theta = std::atan2(y, x);
+
+      double amplitude = std::pow(std::sqrt(2) * r / w, radial_number) * L_pl[i] * std::exp(-r * r / (w * w));
 
       // Phase factor
-      double phase = radial_number * theta - k * r * r / (2 * R) + (2 * azimuthal_number + radial_number + 1) * gouy_phase;
+      double phase = radial_number * theta - k * r * r / (2 * R) + constant_phase;
 
-      field[i] = amplitude * std::cos(phase); // store the real part of the field
-    }
+      double value = amplitude * std::cos(phase); // store the real part of the field
+      field[i] = value;
+      squared_norm += value * value;
+   }
 
    // Normalization to L2 norm of 1
-   this->normalize_fields(field);
+   this->normalize_fields(field, squared_norm);
 
 
    return field;
@@ -273,7 +370,7 @@ std::vector<complex128> ModeField::get_LG_unstructured(std::vector<double> &x_co
 // ________________________________ NC ___________________________________
 
 
-std::vector<complex128> ModeField::get_NC_unstructured(std::vector<double> &x_coords, std::vector<double> &) const {
+std::vector<complex128> ModeField::get_NC_unstructured(const std::vector<double> &x_coords, const std::vector<double> &) const {
    std::vector<complex128> output(x_coords.size(), 1.0);
 
    return output;
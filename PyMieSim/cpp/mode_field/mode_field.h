@@ -3,6 +3,7 @@
 #include <cmath>
 #include <vector>
 #include <complex>
+#include <string>
 #include <bessel_subroutine/bessel_subroutine.h>
 
 
@@ -32,23 +33,33 @@ class ModeField {
        * @param x_coords X-coordinates of the points.
        * @param y_coords Y-coordinates of the points.
        * @return A vector of complex128 representing the unstructured mode field.
+       * @note The coordinates are scaled by their largest radius on the fly, the inputs are left untouched.
        */
-      [[nodiscard]] std::vector<complex128> get_unstructured(std::vector<double> x_coords, std::vector<double> y_coords) const;
+      [[nodiscard]] std::vector<complex128> get_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const;
 
 
    private:
       /**
-       * @brief Normalizes the coordinates to the range [-1, 1].
+       * @brief Returns the factor bringing the coordinates to the range [-1, 1].
        * @param x_coords X-coordinates of the points.
        * @param y_coords Y-coordinates of the points.
+       * @return The inverse of the largest radius, 1 if every point is at the origin.
        */
-      void normalize_coordinates(std::vector<double> &x_coords, std::vector<double> &y_coords) const;
+      double get_coordinate_scale(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const;
 
       /**
-       * @brief Normalizes the field values to ensure they sum to 1.
+       * @brief Normalizes the field values to ensure their squared moduli sum to 1.
        * @param field The field values to normalize.
+       * @param squared_norm The sum of the squared moduli, accumulated while the field was computed.
        */
-      void normalize_fields(std::vector<complex128> &field) const;
+      void normalize_fields(std::vector<complex128> &field, double squared_norm) const;
+
+      /**
+       * @brief Returns the rank-th zero of J_order, computed once per process.
+       * @param order Order of the Bessel function.
+       * @param rank Rank of the zero, starting at 1.
+       */
+      static double get_bessel_zero(int order, int rank);
 
       /**
        * @brief Computes the Hermite-Gaussian mode field.
@@ -58,8 +69,9 @@ class ModeField {
        * @param waist_radius Waist radius of the mode (default is 0.3).
        * @param z Propagation distance (default is 0.0).
        * @return A vector of complex128 representing the Hermite-Gaussian mode field.
+       * @note J_n is evaluated for real arguments over all the points at once, see Special_::compute_Jn_array.
        */
-      std::vector<complex128> get_LP_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords) const;
+      std::vector<complex128> get_LP_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const;
 
       /**
        * @brief Computes the Hermite-Gaussian mode field.
@@ -70,7 +82,7 @@ class ModeField {
        * @param z Propagation distance (default is 0.0).
        * @return A vector of complex128 representing the Hermite-Gaussian mode field.
        */
-      std::vector<complex128> get_HG_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords, double wavelength = 1.55, double waist_radius = 0.3, double z = 0.0) const ;
+      std::vector<complex128> get_HG_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords, double wavelength = 1.55, double waist_radius = 0.3, double z = 0.0) const ;
 
       /**
        * @brief Computes the Laguerre-Gaussian mode field.
@@ -81,7 +93,7 @@ class ModeField {
        * @param z Propagation distance (default is 0.0).
        * @return A vector of complex128 representing the Laguerre-Gaussian mode field.
        */
-      std::vector<complex128> get_LG_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords, double wavelength = 1.55, double waist_radius = 0.3, double z = 0.0) const ;
+      std::vector<complex128> get_LG_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords, double wavelength = 1.55, double waist_radius = 0.3, double z = 0.0) const ;
 
       /**
        * @brief Computes the non-circular unstructured mode field.
@@ -89,7 +101,7 @@ class ModeField {
        * @param y_coords Y-coordinates of the points.
        * @return A vector of complex128 representing the non-circular unstructured mode field.
        */
-      std::vector<complex128> get_NC_unstructured(std::vector<double> &x_coords, std::vector<double> &y_coords) const;
+      std::vector<complex128> get_NC_unstructured(const std::vector<double> &x_coords, const std::vector<double> &y_coords) const;
 
       /**
        * @brief Computes the Hermite polynomial value for a given order and x.
@@ -107,6 +119,16 @@ class ModeField {
        */
       double hermite_imp(unsigned n, double x) const;
 
+      /**
+       * @brief Computes the Hermite polynomial of a given order at many values at once.
+       * @param n Order of the Hermite polynomial.
+       * @param x Values at which to evaluate the polynomial.
+       * @param output The values of the Hermite polynomial, as many as x.
+       * @param size Number of values.
+       * @note Same recurrence as hermite_imp, run order by order over blocks of values so that it vectorizes.
+       */
+      void hermite_array(unsigned n, const double *x, double *output, size_t size) const;
+
       /**
        * @brief Computes the Laguerre polynomial value for a given order and x.
        * @param n Order of the Laguerre polynomial.
@@ -142,5 +164,16 @@ class ModeField {
        */
       double laguerre_imp(unsigned n, unsigned m, double x) const;
 
+      /**
+       * @brief Computes the associated Laguerre polynomial of given orders at many values at once.
+       * @param n Order of the Laguerre polynomial.
+       * @param m Order of the associated Laguerre polynomial.
+       * @param x Values at which to evaluate the polynomial.
+       * @param output The values of the Laguerre polynomial, as many as x.
+       * @param size Number of values.
+       * @note Same recurrence as laguerre_imp, run order by order over blocks of values so that it vectorizes.
+       */
+      void laguerre_array(unsigned n, unsigned m, const double *x, double *output, size_t size) const;
+
 
 };
@@ -0,0 +1,170 @@
+#include "angular_basis.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#define PI (double)3.14159265358979323846264338
+
+
+// ---------------------- AngularBasis ---------------------------------------
+AngularBasis::AngularBasis(const std::vector<double>& _phi, const size_t _max_order)
+: phi(_phi), max_order(_max_order)
+{
+    const size_t n_angles = phi.size();
+
+    mu.resize(n_angles);
+    pi.resize(max_order * n_angles);
+    tau.resize(max_order * n_angles);
+
+    for (size_t i = 0; i < n_angles; ++i)
+        mu[i] = cos(phi[i] - PI / 2.0);
+
+    // pi_1 = 1, tau_1 = mu, pi_2 = 3 mu, tau_2 = 3 (2 mu^2 - 1)
+    for (size_t i = 0; i < n_angles && max_order > 0; ++i) {
+        pi[i] = 1.0;
+        tau[i] = mu[i];
+    }
+
+    for (size_t i = 0; i < n_angles && max_order > 1; ++i) {
+        pi[n_angles + i] = 3.0 * mu[i];
+        tau[n_angles + i] = 2.0 * mu[i] * pi[n_angles + i] - 3.0;
+    }
+
+    this->compute_rows(2);
+}
+
+AngularBasis::AngularBasis(const AngularBasis& other, const size_t _max_order)
+: phi(other.phi), mu(other.mu), max_order(std::max(_max_order, other.max_order))
+{
+    const size_t n_angles = mu.size();
+
+    pi.resize(max_order * n_angles);
+    tau.resize(max_order * n_angles);
+
+    std::copy(other.pi.begin(), other.pi.end(), pi.begin());
+    std::copy(other.tau.begin(), other.tau.end(), tau.begin());
+
+    this->compute_rows(other.max_order);
+}
+
+void AngularBasis::compute_rows(const size_t start_order) {
+    const size_t n_angles = mu.size();
+
+    for (size_t m = std::max<size_t>(start_order, 2); m < max_order; ++m) {
+        const double
+            c0 = (2. * m + 1.) / m,
+            c1 = (m + 1.) / m,
+            t0 = m + 1.,
+            t1 = m + 2.;
+
+        const double *pi_1 = &pi[(m - 1) * n_angles], *pi_2 = &pi[(m - 2) * n_angles];
+        double *pi_n = &pi[m * n_angles], *tau_n = &tau[m * n_angles];
+
+        for (size_t i = 0; i < n_angles; ++i) {
+            pi_n[i] = c0 * mu[i] * pi_1[i] - c1 * pi_2[i];
+            tau_n[i] = t0 * mu[i] * pi_n[i] - t1 * pi_1[i];
+        }
+    }
+}
+
+
+// ---------------------- AngularBasisCache ---------------------------------------
+uint64_t AngularBasisCache::get_hash(const std::vector<double>& phi) {
+    // FNV-1a over the bit patterns of the angles
+    uint64_t hash = 14695981039346656037ull ^ phi.size();
+
+    for (const double value : phi) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash = (hash ^ bits) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+std::shared_ptr<const AngularBasis>
+AngularBasisCache::get_basis(const std::vector<double>& phi, const size_t max_order) {
+    const size_t required_size = (2 * max_order + 2) * phi.size() * sizeof(double);
+
+    const uint64_t hash = get_hash(phi);
+    std::shared_ptr<const AngularBasis> cached;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!enabled || required_size > max_memory_size)
+            return nullptr;
+
+        auto it = lookup.find(hash);
+
+        if (it != lookup.end() && it->second->basis->phi == phi) {
+            entries.splice(entries.begin(), entries, it->second);
+            cached = it->second->basis;
+        }
+
+        if (cached && cached->max_order >= max_order)
+            ++hits;
+        else
+            ++misses;
+    }
+
+    if (cached && cached->max_order >= max_order)
+        return cached;
+
+    // Tables are built outside the lock, growing geometrically so that sweeps of increasing size extend them rarely
+    std::shared_ptr<const AngularBasis> basis = cached
+        ? std::make_shared<const AngularBasis>(*cached, std::max(max_order, cached->max_order + cached->max_order / 2))
+        : std::make_shared<const AngularBasis>(phi, max_order);
+
+    this->insert(hash, basis);
+
+    return basis;
+}
+
+void AngularBasisCache::insert(const uint64_t hash, std::shared_ptr<const AngularBasis> basis) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = lookup.find(hash);
+
+    if (it != lookup.end()) {
+        if (it->second->basis->phi == basis->phi && it->second->basis->max_order >= basis->max_order)
+            return;
+
+        memory_size -= it->second->basis->get_memory_size();
+        entries.erase(it->second);
+        lookup.erase(it);
+    }
+
+    memory_size += basis->get_memory_size();
+    entries.push_front({hash, std::move(basis)});
+    lookup[hash] = entries.begin();
+
+    while (memory_size > max_memory_size && entries.size() > 1) {
+        memory_size -= entries.back().basis->get_memory_size();
+        lookup.erase(entries.back().hash);
+        entries.pop_back();
+    }
+}
+
+AngularBasisCache::Statistics AngularBasisCache::get_statistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {hits, misses, entries.size(), memory_size};
+}
+
+void AngularBasisCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lookup.clear();
+    memory_size = 0;
+    hits = 0;
+    misses = 0;
+}
+
+void AngularBasisCache::configure(const bool _enabled, const size_t _max_memory_size) {
+    this->clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = _enabled;
+    max_memory_size = _max_memory_size;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include <utils/shared_instance.h>
+
+
+/**
+ * @brief Tabulated angular functions pi_n(mu) and tau_n(mu) on a fixed set of angles.
+ *
+ * The tables depend only on the angles and the order, not on the scatterer, so a single
+ * instance can be shared by every scatterer evaluated on the same mesh. Rows are stored
+ * order-major ([order * n_angles + angle]) so that S1/S2 reduce to a dense
+ * (orders x angles) matrix-vector product over contiguous rows.
+ */
+class AngularBasis {
+    public:
+        std::vector<double> phi;
+        std::vector<double> mu;
+        size_t max_order = 0;
+        std::vector<double> pi;
+        std::vector<double> tau;
+
+        AngularBasis() = default;
+
+        /**
+         * @brief Builds the pi/tau tables on the given angles.
+         * @param phi The angles in radians (mesh convention, mu = cos(phi - pi/2)).
+         * @param max_order The number of orders to tabulate.
+         */
+        AngularBasis(const std::vector<double>& phi, const size_t max_order);
+
+        /**
+         * @brief Builds a table holding more orders by continuing the recurrence of an existing one.
+         * @param other The table to extend, its rows are copied unchanged.
+         * @param max_order The number of orders of the new table.
+         */
+        AngularBasis(const AngularBasis& other, const size_t max_order);
+
+        size_t get_n_angles() const { return mu.size(); }
+
+        size_t get_memory_size() const { return (phi.size() + mu.size() + pi.size() + tau.size()) * sizeof(double); }
+
+    private:
+        /**
+         * @brief Fills the rows [start_order, max_order) of the tables, rows start_order - 2 and start_order - 1 must be set.
+         * @param start_order The first order to compute (at least 2).
+         */
+        void compute_rows(const size_t start_order);
+};
+
+
+/**
+ * @brief Process-wide cache of AngularBasis tables keyed on the angles they were built on.
+ *
+ * Lookups hash the angle values so that meshes rebuilt with identical parameters share the
+ * same table. A cached table is extended when a larger order is requested, and the least
+ * recently used tables are dropped once the memory budget is exceeded.
+ *
+ * @note The cache is disabled by default: streaming the tables is memory bound and was measured
+ * slower than the blocked on-the-fly recurrence of BaseScatterer::compute_spherical_s1s2 on
+ * typical detector meshes. It is kept for machines where memory bandwidth outweighs arithmetic.
+ * The instance is a SharedInstance, EXPERIMENT.set_angular_basis_cache also applies to the single detectors.
+ */
+class AngularBasisCache {
+    public:
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t size = 0;
+            size_t memory_size = 0;
+        };
+
+        bool enabled = false;
+        size_t max_memory_size = size_t(512) << 20;  // bytes
+
+        /**
+         * @brief Returns the process-wide cache.
+         */
+        static AngularBasisCache& get_instance() {return SharedInstance<AngularBasisCache>::get();}
+
+        /**
+         * @brief Returns a table covering at least max_order orders on the given angles.
+         * @param phi The angles in radians.
+         * @param max_order The minimum number of orders required.
+         * @return A shared table, or nullptr if the cache is disabled or the table would not fit in the memory budget.
+         */
+        std::shared_ptr<const AngularBasis> get_basis(const std::vector<double>& phi, const size_t max_order);
+
+        /**
+         * @brief Returns the lookups served from the cache and those building or extending a table, along with
+         * the number of tables held and their size in bytes.
+         */
+        Statistics get_statistics();
+
+        /**
+         * @brief Removes every cached table and resets the counters.
+         */
+        void clear();
+
+        /**
+         * @brief Enables or disables the cache and sets its memory budget, dropping the cached tables and resetting the counters.
+         * @param enabled Whether spherical scatterers evaluated on meshes use the cached tables.
+         * @param max_memory_size The memory budget in bytes.
+         */
+        void configure(const bool enabled, const size_t max_memory_size);
+
+    private:
+        struct Entry {
+            uint64_t hash;
+            std::shared_ptr<const AngularBasis> basis;
+        };
+
+        std::mutex mutex;
+        std::list<Entry> entries;  // most recently used first
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> lookup;
+        size_t memory_size = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+
+        AngularBasisCache() = default;
+        friend class SharedInstance<AngularBasisCache>;
+
+        static uint64_t get_hash(const std::vector<double>& phi);
+
+        void insert(const uint64_t hash, std::shared_ptr<const AngularBasis> basis);
+};
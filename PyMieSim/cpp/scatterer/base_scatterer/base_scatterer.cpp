@@ -2,14 +2,12 @@
 
 
 
-size_t BaseScatterer::get_wiscombe_criterion(const double size_parameter) const {
+size_t BaseScatterer::get_wiscombe_criterion(const double size_parameter) {
     return static_cast<size_t>(2 + size_parameter + 4 * std::cbrt(size_parameter)) + 16;
 }
 
 std::vector<double> BaseScatterer::get_prefactor() const {
-    std::vector<double> output;
-
-    output.reserve(max_order);
+    std::vector<double> output(max_order);
 
     for (size_t m = 0; m < max_order ; ++m)
         output[m] = (double) ( 2 * (m + 1) + 1 ) / ( (m + 1) * ( (m + 1) + 1 ) );
@@ -54,6 +52,12 @@ BaseScatterer::compute_unstructured_farfields(const std::vector<double>& phi, co
 {
     auto [S1, S2] = this->compute_s1s2(phi);
 
+    return this->compute_unstructured_farfields(S1, S2, theta, radius);
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_unstructured_farfields(const std::vector<complex128>& S1, const std::vector<complex128>& S2, const std::vector<double>& theta, const double radius) const
+{
     std::vector<complex128> phi_field, theta_field;
 
     size_t full_size = theta.size();
@@ -76,13 +80,130 @@ BaseScatterer::compute_unstructured_farfields(const std::vector<double>& phi, co
 }
 
 std::tuple<std::vector<complex128>, std::vector<complex128>>
-BaseScatterer::compute_unstructured_farfields(const FibonacciMesh& fibonacci_mesh, const double radius) const
+BaseScatterer::compute_unstructured_farfields(const FibonacciMesh& fibonacci_mesh, const double radius, const double interpolation_tolerance) const
 {
-    return this->compute_unstructured_farfields(
-        fibonacci_mesh.spherical.phi,
-        fibonacci_mesh.spherical.theta,
-        radius
-    );
+    auto [S1, S2] = this->compute_mesh_amplitudes(fibonacci_mesh, interpolation_tolerance);
+
+    return this->compute_unstructured_farfields(S1, S2, fibonacci_mesh.spherical.theta, radius);
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_mesh_amplitudes(const FibonacciMesh& fibonacci_mesh, const double interpolation_tolerance) const
+{
+    return this->compute_mesh_amplitudes(fibonacci_mesh.spherical.phi, interpolation_tolerance);
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_mesh_amplitudes(const std::vector<double>& phi, const double interpolation_tolerance) const
+{
+    return (interpolation_tolerance > 0.0)
+        ? this->compute_interpolated_s1s2(phi, interpolation_tolerance)
+        : this->compute_mesh_s1s2(phi);
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_interpolated_s1s2(const std::vector<double>& phi, const double tolerance) const
+{
+    if (phi.empty())
+        return this->compute_mesh_s1s2(phi);
+
+    const auto [phi_min, phi_max] = std::minmax_element(phi.begin(), phi.end());
+    const AmplitudeTable table = this->compute_amplitude_table({{*phi_min, *phi_max}}, tolerance, phi.size());
+
+    if (table.empty())
+        return this->compute_mesh_s1s2(phi);
+
+    return table.evaluate(phi);
+}
+
+AmplitudeTable
+BaseScatterer::compute_amplitude_table(const std::vector<std::array<double, 2>>& ranges, const double tolerance, const size_t max_nodes) const
+{
+    size_t n_intervals = std::max<size_t>(4 * max_order, 8);
+
+    if (ranges.empty() || n_intervals + 1 >= max_nodes)
+        return AmplitudeTable();
+
+    double start = ranges[0][0], stop = ranges[0][1];
+    for (const std::array<double, 2>& range : ranges) {
+        start = std::min(start, range[0]);
+        stop = std::max(stop, range[1]);
+    }
+
+    const double span = stop - start;
+
+    if (span <= 0.0)
+        return AmplitudeTable();
+
+    std::vector<double> grid(n_intervals + 1);
+    for (size_t i = 0; i <= n_intervals; ++i)
+        grid[i] = start + span * i / n_intervals;
+
+    auto [S1_grid, S2_grid] = this->compute_s1s2(grid);
+
+    while (true) {
+        if (2 * n_intervals + 1 >= max_nodes)
+            return AmplitudeTable();
+
+        const double step = span / n_intervals;
+
+        std::vector<double> midpoints(n_intervals);
+        for (size_t i = 0; i < n_intervals; ++i)
+            midpoints[i] = start + step * (i + 0.5);
+
+        auto [S1_mid, S2_mid] = this->compute_s1s2(midpoints);
+
+        // Interpolation error at the midpoint of each interval, and largest amplitude at its midpoint and left node
+        std::vector<double> error(n_intervals), scale(n_intervals);
+        for (size_t i = 0; i < n_intervals; ++i) {
+            error[i] = std::max(
+                std::abs(interpolate_cubic(S1_grid, start, step, midpoints[i]) - S1_mid[i]),
+                std::abs(interpolate_cubic(S2_grid, start, step, midpoints[i]) - S2_mid[i])
+            );
+            scale[i] = std::max({std::abs(S1_mid[i]), std::abs(S2_mid[i]), std::abs(S1_grid[i]), std::abs(S2_grid[i])});
+        }
+
+        bool is_converged = true;
+        for (const std::array<double, 2>& range : ranges) {
+            const size_t
+                first = std::min(static_cast<size_t>(std::max(0.0, (range[0] - start) / step)), n_intervals - 1),
+                last = std::min(static_cast<size_t>(std::max(0.0, (range[1] - start) / step)), n_intervals - 1);
+
+            const double range_error = *std::max_element(error.begin() + first, error.begin() + last + 1);
+            const double range_scale = *std::max_element(scale.begin() + first, scale.begin() + last + 1);
+
+            if (range_error > tolerance * range_scale) {
+                is_converged = false;
+                break;
+            }
+        }
+
+        // Merge the midpoints, the grid used below is one refinement finer than the one checked
+        std::vector<complex128> S1_merged(2 * n_intervals + 1), S2_merged(2 * n_intervals + 1);
+        for (size_t i = 0; i < n_intervals; ++i) {
+            S1_merged[2 * i] = S1_grid[i];
+            S2_merged[2 * i] = S2_grid[i];
+            S1_merged[2 * i + 1] = S1_mid[i];
+            S2_merged[2 * i + 1] = S2_mid[i];
+        }
+        S1_merged.back() = S1_grid.back();
+        S2_merged.back() = S2_grid.back();
+
+        S1_grid = std::move(S1_merged);
+        S2_grid = std::move(S2_merged);
+        n_intervals *= 2;
+
+        if (is_converged)
+            break;
+    }
+
+    AmplitudeTable table;
+    table.start = start;
+    table.step = span / n_intervals;
+    table.S1 = std::move(S1_grid);
+    table.S2 = std::move(S2_grid);
+
+    return table;
 }
 
 std::tuple<std::vector<complex128>, std::vector<complex128>, std::vector<double>, std::vector<double>>
@@ -102,16 +223,6 @@ BaseScatterer::compute_full_structured_farfields(const size_t& sampling, const d
     );
 }
 
-std::vector<complex128>
-BaseScatterer::compute_dn(double nmx, complex128 z)  const { //Page 127 of BH
-    std::vector<complex128> Dn(nmx, 0.0);
-
-    for (double n = nmx - 1.; n > 1.; n--)
-        Dn[n-1] = n/z - ( 1. / (Dn[n] + n/z) );
-
-    return Dn;
-}
-
 double
 BaseScatterer::get_g_with_farfields(size_t sampling) const {
     auto [SPF, fibonacci_mesh] = this->compute_full_structured_spf(sampling);
@@ -125,6 +236,8 @@ BaseScatterer::get_g_with_farfields(size_t sampling) const {
 
 complex128
 BaseScatterer::get_coefficient(const std::string &type, const size_t order) {
+    this->ensure_coefficients();
+
     if (order > max_order)
         throw std::invalid_argument("Coefficient number is higher than computed max value: " + std::to_string(max_order));
 
@@ -183,6 +296,229 @@ BaseScatterer::get_pi_tau(const double& mu, const size_t& max_order) const {
     return std::make_tuple(pin, taun);
 }
 
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_spherical_s1s2(const std::vector<double>& phi) const
+{
+    // Crossover measured with development/benchmark_fast_legendre.py
+    if (max_order >= fast_legendre_min_order && 2 * phi.size() >= max_order)
+        return this->compute_fast_spherical_s1s2(phi);
+
+    return this->compute_direct_spherical_s1s2(phi);
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_direct_spherical_s1s2(const std::vector<double>& phi) const
+{
+    constexpr size_t block_size = 64;
+    const size_t n_angles = phi.size();
+
+    std::vector<complex128> S1(n_angles), S2(n_angles);
+
+    // Prefactor-weighted coefficients split into real and imaginary parts, taken from this thread's workspace
+    Workspace::Scope scope;
+    std::span<double>
+        a_real = Workspace::allocate<double>(max_order),
+        a_imag = Workspace::allocate<double>(max_order),
+        b_real = Workspace::allocate<double>(max_order),
+        b_imag = Workspace::allocate<double>(max_order),
+        pi_factor_0 = Workspace::allocate<double>(max_order),
+        pi_factor_1 = Workspace::allocate<double>(max_order);
+
+    for (size_t m = 0; m < max_order; ++m) {
+        const double n = static_cast<double>(m + 1);
+        const double prefactor = (2. * n + 1.) / (n * (n + 1.));
+
+        a_real[m] = prefactor * this->an[m].real();
+        a_imag[m] = prefactor * this->an[m].imag();
+        b_real[m] = prefactor * this->bn[m].real();
+        b_imag[m] = prefactor * this->bn[m].imag();
+
+        // pi_n = ((2n - 1) mu pi_{n-1} - n pi_{n-2}) / (n - 1)
+        pi_factor_0[m] = (m == 0) ? 0. : (2. * m + 1.) / m;
+        pi_factor_1[m] = (m == 0) ? 0. : (m + 1.) / m;
+    }
+
+    std::array<double, block_size> mu, pi_previous, pi_current, S1_real, S1_imag, S2_real, S2_imag;
+
+    for (size_t start = 0; start < n_angles; start += block_size) {
+        const size_t width = std::min(block_size, n_angles - start);
+
+        // Order n = 1: pi_1 = 1, tau_1 = mu. Lanes beyond the last angle are padded with mu = 0.
+        for (size_t i = 0; i < block_size; ++i) {
+            mu[i] = (i < width) ? cos(phi[start + i] - PI / 2.0) : 0.0;
+            pi_previous[i] = 0.0;
+            pi_current[i] = 1.0;
+            S1_real[i] = a_real[0] + b_real[0] * mu[i];
+            S1_imag[i] = a_imag[0] + b_imag[0] * mu[i];
+            S2_real[i] = a_real[0] * mu[i] + b_real[0];
+            S2_imag[i] = a_imag[0] * mu[i] + b_imag[0];
+        }
+
+        for (size_t m = 1; m < max_order; ++m) {
+            const double
+                c0 = pi_factor_0[m], c1 = pi_factor_1[m],
+                t0 = m + 1., t1 = m + 2.,
+                ar = a_real[m], ai = a_imag[m], br = b_real[m], bi = b_imag[m];
+
+            for (size_t i = 0; i < block_size; ++i) {
+                const double pi_n = c0 * mu[i] * pi_current[i] - c1 * pi_previous[i];
+                const double tau_n = t0 * mu[i] * pi_n - t1 * pi_current[i];
+
+                pi_previous[i] = pi_current[i];
+                pi_current[i] = pi_n;
+
+                S1_real[i] += ar * pi_n + br * tau_n;
+                S1_imag[i] += ai * pi_n + bi * tau_n;
+                S2_real[i] += ar * tau_n + br * pi_n;
+                S2_imag[i] += ai * tau_n + bi * pi_n;
+            }
+        }
+
+        for (size_t i = 0; i < width; ++i) {
+            S1[start + i] = complex128(S1_real[i], S1_imag[i]);
+            S2[start + i] = complex128(S2_real[i], S2_imag[i]);
+        }
+    }
+
+    return std::make_tuple(std::move(S1), std::move(S2));
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_fast_spherical_s1s2(const std::vector<double>& phi) const
+{
+    const size_t N = max_order;
+
+    // Every series below is a scratch buffer of N + 1 coefficients taken from this thread's workspace
+    Workspace::Scope scope;
+    auto allocate_series = [N]() {return Workspace::allocate<complex128>(N + 1, 0.0);};
+
+    // Legendre coefficients of sum_n c_n pi_n, using P_n' = sum_{k = n-1, n-3, ...} (2k + 1) P_k
+    auto derivative_series = [&](const std::span<const complex128> c) {
+        std::span<complex128> output = allocate_series();
+        complex128 suffix[2] = {0.0, 0.0};
+
+        for (size_t k = N; k-- > 0;) {
+            suffix[k % 2] += c[k + 1];
+            output[k] = (2. * k + 1.) * suffix[k % 2];
+        }
+        return output;
+    };
+
+    // Legendre coefficients of mu * sum_k l_k P_k, using (2k + 1) mu P_k = (k + 1) P_{k+1} + k P_{k-1}
+    auto multiply_by_mu = [&](const std::span<const complex128> l) {
+        std::span<complex128> output = allocate_series();
+
+        for (size_t k = 0; k < N; ++k) {
+            output[k + 1] += l[k] * (k + 1.) / (2. * k + 1.);
+            if (k > 0)
+                output[k - 1] += l[k] * static_cast<double>(k) / (2. * k + 1.);
+        }
+        return output;
+    };
+
+    // S1 = sum alpha_n pi_n - mu sum beta_n pi_n + sum (2n + 1) b_n P_n, S2 likewise with a and b swapped
+    std::span<complex128> alpha = allocate_series(), beta = allocate_series();
+    for (size_t n = 1; n <= N; ++n) {
+        const double prefactor = (2. * n + 1.) / (n * (n + 1.));
+        alpha[n] = prefactor * this->an[n - 1];
+        beta[n] = prefactor * this->bn[n - 1];
+    }
+
+    const std::span<const complex128>
+        alpha_series = derivative_series(alpha),
+        beta_series = derivative_series(beta),
+        mu_alpha_series = multiply_by_mu(alpha_series),
+        mu_beta_series = multiply_by_mu(beta_series);
+
+    std::span<complex128> S1_legendre = allocate_series(), S2_legendre = allocate_series();
+    for (size_t n = 0; n <= N; ++n) {
+        const complex128 a = (n > 0) ? this->an[n - 1] : 0.0, b = (n > 0) ? this->bn[n - 1] : 0.0;
+        S1_legendre[n] = alpha_series[n] - mu_beta_series[n] + (2. * n + 1.) * b;
+        S2_legendre[n] = beta_series[n] - mu_alpha_series[n] + (2. * n + 1.) * a;
+    }
+
+    std::span<complex128> S1_chebyshev = allocate_series(), S2_chebyshev = allocate_series();
+    legendre_to_chebyshev(S1_legendre, S1_chebyshev);
+    legendre_to_chebyshev(S2_legendre, S2_chebyshev);
+
+    // Scattering angle of each point, mu = cos(phi - pi / 2)
+    std::span<double> theta = Workspace::allocate<double>(phi.size());
+    for (size_t i = 0; i < phi.size(); ++i)
+        theta[i] = phi[i] - PI / 2.0;
+
+    return std::make_tuple(
+        evaluate_cosine_series(S1_chebyshev, theta),
+        evaluate_cosine_series(S2_chebyshev, theta)
+    );
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_spherical_s1s2(const AngularBasis& basis) const
+{
+    constexpr size_t block_size = 256;
+    const size_t n_angles = basis.get_n_angles();
+
+    if (basis.max_order < max_order)
+        throw std::invalid_argument("Angular basis holds fewer orders than the scatterer.");
+
+    std::vector<complex128> S1(n_angles), S2(n_angles);
+
+    Workspace::Scope scope;
+    std::span<double>
+        a_real = Workspace::allocate<double>(max_order),
+        a_imag = Workspace::allocate<double>(max_order),
+        b_real = Workspace::allocate<double>(max_order),
+        b_imag = Workspace::allocate<double>(max_order);
+
+    for (size_t m = 0; m < max_order; ++m) {
+        const double n = static_cast<double>(m + 1);
+        const double prefactor = (2. * n + 1.) / (n * (n + 1.));
+
+        a_real[m] = prefactor * this->an[m].real();
+        a_imag[m] = prefactor * this->an[m].imag();
+        b_real[m] = prefactor * this->bn[m].real();
+        b_imag[m] = prefactor * this->bn[m].imag();
+    }
+
+    std::array<double, block_size> S1_real, S1_imag, S2_real, S2_imag;
+
+    for (size_t start = 0; start < n_angles; start += block_size) {
+        const size_t width = std::min(block_size, n_angles - start);
+
+        S1_real.fill(0.); S1_imag.fill(0.); S2_real.fill(0.); S2_imag.fill(0.);
+
+        for (size_t m = 0; m < max_order; ++m) {
+            const double *pi_n = &basis.pi[m * n_angles + start], *tau_n = &basis.tau[m * n_angles + start];
+            const double ar = a_real[m], ai = a_imag[m], br = b_real[m], bi = b_imag[m];
+
+            for (size_t i = 0; i < width; ++i) {
+                S1_real[i] += ar * pi_n[i] + br * tau_n[i];
+                S1_imag[i] += ai * pi_n[i] + bi * tau_n[i];
+                S2_real[i] += ar * tau_n[i] + br * pi_n[i];
+                S2_imag[i] += ai * tau_n[i] + bi * pi_n[i];
+            }
+        }
+
+        for (size_t i = 0; i < width; ++i) {
+            S1[start + i] = complex128(S1_real[i], S1_imag[i]);
+            S2[start + i] = complex128(S2_real[i], S2_imag[i]);
+        }
+    }
+
+    return std::make_tuple(std::move(S1), std::move(S2));
+}
+
+std::tuple<std::vector<complex128>, std::vector<complex128>>
+BaseScatterer::compute_cached_spherical_s1s2(const std::vector<double>& phi) const
+{
+    std::shared_ptr<const AngularBasis> basis = AngularBasisCache::get_instance().get_basis(phi, max_order);
+
+    if (!basis)
+        return this->compute_spherical_s1s2(phi);
+
+    return this->compute_spherical_s1s2(*basis);
+}
+
 std::tuple<std::vector<double>, FullSteradian>
 BaseScatterer::compute_full_structured_spf(const size_t sampling, const double radius) const
 {
@@ -1,25 +1,76 @@
 #pragma once
 
+#include <array>
 #include <complex>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include <source/source.h>
 #include <fibonacci/fibonacci.h>
 #include <full_mesh/full_mesh.h>
 #include <bessel_subroutine/bessel_subroutine.h>
+#include <scatterer/base_scatterer/angular_basis.h>
+#include <scatterer/base_scatterer/fast_legendre.h>
+#include <scatterer/base_scatterer/size_parameter_cache.h>
 #include <utils/defines.h>
+#include <utils/math.h>
+#include <utils/workspace.h>
 
 typedef std::complex<double> complex128;
 
+/**
+ * @brief Method used to evaluate the scattering quantities of a scatterer.
+ * Rayleigh uses closed-form low-order partial waves, AnomalousDiffraction uses the van de Hulst
+ * approximation for extinction-type quantities and Mie is the exact series.
+ */
+enum class ScatteringRegime {Mie = 0, Rayleigh = 1, AnomalousDiffraction = 2};
+
+
+/**
+ * @brief S1 and S2 tabulated on a regular grid of the scattering angle, interpolated to any mesh within its span.
+ *
+ * The amplitudes only depend on the scattering angle, a table built once per particle serves every detector
+ * orientation, see BaseScatterer::compute_amplitude_table.
+ */
+struct AmplitudeTable {
+    double start = 0.0;
+    double step = 0.0;
+    std::vector<complex128> S1;
+    std::vector<complex128> S2;
+
+    bool empty() const {return this->S1.empty();}
+
+    /**
+     * @brief Interpolates S1 and S2 at the given angles, which must lie within the span of the table.
+     * @param phi The angles in radians, in the mesh convention.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>> evaluate(const std::vector<double>& phi) const {
+        std::vector<complex128> S1_points(phi.size()), S2_points(phi.size());
+
+        for (size_t i = 0; i < phi.size(); ++i) {
+            S1_points[i] = interpolate_cubic(this->S1, this->start, this->step, phi[i]);
+            S2_points[i] = interpolate_cubic(this->S2, this->start, this->step, phi[i]);
+        }
+
+        return std::make_tuple(std::move(S1_points), std::move(S2_points));
+    }
+};
+
 
 class BaseScatterer {
 public:
     size_t max_order;
+    static constexpr size_t fast_legendre_min_order = 512;  // smallest order using the fast Legendre transform
     BaseSource source;
     double size_parameter;
     double size_parameter_squared;
     double cross_section;
     double medium_refractive_index;
-    std::vector<size_t> indices;
+    double accuracy_target = 0.0;  // approximations allowed below this estimated relative error, 0 means exact
+    ScatteringRegime regime = ScatteringRegime::Mie;
+    IndexTuple indices;
 
     BaseScatterer() = default;
     BaseScatterer(const size_t _max_order, const BaseSource &_source, const double _medium_refractive_index)
@@ -32,6 +83,28 @@ public:
     virtual void compute_an_bn(const size_t max_order = 0) = 0;
 
     virtual std::tuple<std::vector<complex128>, std::vector<complex128>> compute_s1s2(const std::vector<double> &phi) const = 0;
+
+    /**
+     * @brief Computes S1 and S2 on a mesh that is expected to be reused across many scatterers.
+     * @param phi The angles of the mesh in radians.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note Defaults to compute_s1s2, spherical scatterers override it to use the shared AngularBasisCache.
+     */
+    virtual std::tuple<std::vector<complex128>, std::vector<complex128>> compute_mesh_s1s2(const std::vector<double> &phi) const {return this->compute_s1s2(phi);};
+
+    /**
+     * @brief Tells whether S1 and S2 are the partial-wave sums of an and bn over pi_n and tau_n, as for spherical scatterers.
+     * @note Detectors use it to evaluate coherent couplings directly from the coefficients.
+     */
+    virtual bool has_spherical_amplitudes() const {return false;};
+
+    /**
+     * @brief Makes sure the partial-wave coefficients are available.
+     * @note No-op by default. Scatterers that defer their coefficients in an approximate regime compute them here,
+     * every coefficient accessor calls it first.
+     */
+    virtual void ensure_coefficients() const {};
+
     virtual double get_Qsca() const {throw std::logic_error{"Function not implementend!"};};
     virtual double get_Qext() const {throw std::logic_error{"Function not implementend!"};};
     virtual double get_Qback() const {throw std::logic_error{"Function not implementend!"};};
@@ -130,13 +203,19 @@ public:
      */
     double get_Cpr() const {return get_Qpr() * this->cross_section;};
 
+    /**
+     * @brief Returns the regime used to evaluate the scatterer.
+     * @return The ScatteringRegime value as a double (0: Mie, 1: Rayleigh, 2: anomalous diffraction).
+     */
+    double get_regime() const {return static_cast<double>(this->regime);};
+
     // GENERAL METHODS ----------------------------------------------------
     /**
      * @brief Computes the Wiscombe criterion.
      * @param size_parameter The size parameter.
      * @return The Wiscombe criterion.
      */
-    size_t get_wiscombe_criterion(const double size_parameter) const;
+    static size_t get_wiscombe_criterion(const double size_parameter);
 
     /**
      * @brief Computes the coefficients cn and dn for a scatterer.
@@ -188,18 +267,81 @@ public:
         const double radius
     ) const;
 
+    /**
+     * @brief Computes the unstructured fields from precomputed S1 and S2 amplitudes.
+     * @param S1 The S1 scattering amplitudes, one per point.
+     * @param S2 The S2 scattering amplitudes, one per point.
+     * @param theta The polar angles in radians.
+     * @param radius The radius of the scatterer.
+     * @return A tuple containing the phi and theta fields.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_unstructured_farfields(
+        const std::vector<complex128>& S1,
+        const std::vector<complex128>& S2,
+        const std::vector<double>& theta,
+        const double radius
+    ) const;
+
     /**
      * @brief Computes the unstructured fields for a Fibonacci mesh.
      * @param fibonacci_mesh The Fibonacci mesh object.
      * @param radius The radius of the scatterer.
+     * @param interpolation_tolerance If strictly positive, S1 and S2 are interpolated from a 1-D angular grid
+     * with this relative error instead of being summed at every mesh point (see compute_interpolated_s1s2).
      * @return A tuple containing the phi and theta fields.
      */
     std::tuple<std::vector<complex128>, std::vector<complex128>>
     compute_unstructured_farfields(
         const FibonacciMesh& fibonacci_mesh,
-        const double radius
+        const double radius,
+        const double interpolation_tolerance = 0.0
     ) const;
 
+    /**
+     * @brief Computes S1 and S2 at the points of a Fibonacci mesh.
+     * @param fibonacci_mesh The Fibonacci mesh object.
+     * @param interpolation_tolerance If strictly positive, S1 and S2 are interpolated from a 1-D angular grid
+     * with this relative error instead of being summed at every mesh point (see compute_interpolated_s1s2).
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_mesh_amplitudes(const FibonacciMesh& fibonacci_mesh, const double interpolation_tolerance = 0.0) const;
+
+    /**
+     * @brief Computes S1 and S2 at the given angles of mesh points, such as the points added by a mesh refinement.
+     * @param phi The angles in radians, in the mesh convention.
+     * @param interpolation_tolerance If strictly positive, S1 and S2 are interpolated from a 1-D angular grid
+     * with this relative error (see compute_interpolated_s1s2).
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_mesh_amplitudes(const std::vector<double>& phi, const double interpolation_tolerance = 0.0) const;
+
+    /**
+     * @brief Computes S1 and S2 at the given angles by cubic interpolation from an adaptive 1-D grid.
+     * @param phi The angles in radians.
+     * @param tolerance The target interpolation error, relative to the largest amplitude on the grid.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note The grid spans the range of phi and starts with 4 * max_order intervals. It is doubled until the
+     * cubic interpolant of the grid predicts the exact amplitudes at the interval midpoints within tolerance,
+     * the midpoints being merged in the grid at each step. When the grid would hold as many nodes as there
+     * are angles, S1 and S2 are evaluated directly.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_interpolated_s1s2(const std::vector<double>& phi, const double tolerance) const;
+
+    /**
+     * @brief Tabulates S1 and S2 on a grid refined until it interpolates them within tolerance on each of the ranges.
+     * @param ranges The angular ranges, in radians, such as those of the meshes of several detectors or orientations.
+     * @param tolerance The target interpolation error on each range, relative to the largest amplitude on that range.
+     * @param max_nodes The number of nodes from which the table is not worth it, typically the number of points it serves.
+     * @return The table spanning all the ranges, empty when it would reach max_nodes.
+     * @note The refinement of compute_interpolated_s1s2, which calls it with the range of its angles. Each range is
+     * checked against its own scale, weak side or back scattering is resolved as well as the forward peak.
+     */
+    AmplitudeTable compute_amplitude_table(const std::vector<std::array<double, 2>>& ranges, const double tolerance, const size_t max_nodes) const;
+
     /**
      * @brief Computes the full structured fields for a given sampling and radius.
      * @param sampling The number of sampling points.
@@ -238,6 +380,57 @@ public:
         complex128 *taun
     ) const;
 
+    /**
+     * @brief Computes the S1 and S2 amplitudes of a spherical scatterer from its an and bn coefficients.
+     * @param phi The angles in radians at which to compute the scattering amplitudes.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note Uses compute_fast_spherical_s1s2 when max_order >= fast_legendre_min_order and there are at least
+     * max_order / 2 angles, compute_direct_spherical_s1s2 otherwise.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_spherical_s1s2(const std::vector<double>& phi) const;
+
+    /**
+     * @brief Computes the S1 and S2 amplitudes of a spherical scatterer by direct summation over the orders.
+     * @param phi The angles in radians at which to compute the scattering amplitudes.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note The real-valued pi/tau recurrences run over fixed-size blocks of angles, so the
+     * inner loop is vectorized across angles and no per-angle buffer is allocated.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_direct_spherical_s1s2(const std::vector<double>& phi) const;
+
+    /**
+     * @brief Computes the S1 and S2 amplitudes of a spherical scatterer through a fast Legendre transform.
+     * @param phi The angles in radians at which to compute the scattering amplitudes.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note S1 and S2 are rewritten in O(max_order) as Legendre series (pi_n = P_n', tau_n = n(n+1) P_n - mu pi_n),
+     * converted to Chebyshev series, i.e. cosine series of the scattering angle, and evaluated at all angles
+     * with a non-uniform FFT. The cost is O(max_order^2 / 2 + max_order log max_order + n_angles) instead of
+     * O(max_order * n_angles). compute_spherical_s1s2 selects it for large scatterers evaluated on many angles.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_fast_spherical_s1s2(const std::vector<double>& phi) const;
+
+    /**
+     * @brief Computes the S1 and S2 amplitudes of a spherical scatterer from tabulated pi/tau functions.
+     * @param basis The angular basis, holding at least max_order orders.
+     * @return A tuple containing the S1 and S2 scattering amplitudes on the angles of the basis.
+     * @note S1 and S2 are a dense (orders x angles) matrix-vector product with the prefactor-weighted
+     * an and bn, accumulated over blocks of angles.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_spherical_s1s2(const AngularBasis& basis) const;
+
+    /**
+     * @brief Computes the S1 and S2 amplitudes of a spherical scatterer using the process-wide AngularBasisCache.
+     * @param phi The angles in radians, typically those of a detector or experiment mesh.
+     * @return A tuple containing the S1 and S2 scattering amplitudes.
+     * @note Falls back to the direct recurrence when the cache is disabled or the table does not fit in its memory budget.
+     */
+    std::tuple<std::vector<complex128>, std::vector<complex128>>
+    compute_cached_spherical_s1s2(const std::vector<double>& phi) const;
+
     /**
      * @brief Computes the propagator for a given radius.
      * @param radius The radius of the scatterer.
@@ -246,12 +439,58 @@ public:
     complex128 get_propagator(const double &radius) const;
 
     /**
-     * @brief Computes the dn coefficients for a given nmx and z.
-     * @param nmx The maximum size parameter.
-     * @param z The complex refractive index.
-     * @return A vector of dn coefficients.
+     * @brief Computes the ratio J_(nu-1)(z) / J_nu(z) from its continued fraction, with the modified Lentz method.
+     * @param nu The Bessel order, n + 1/2 for Riccati-Bessel and n for cylindrical functions.
+     * @param z The argument, real (double) or complex (complex128).
+     * @return The ratio, J_(nu-1) / J_nu = b_0 - 1 / (b_1 - 1 / (b_2 - ...)) with b_k = 2 (nu + k) / z.
+     * @note Lentz, Appl. Opt. 15, 668 (1976). The fraction only converges once nu + k exceeds |z|, then within a few terms.
      */
-    std::vector<complex128> compute_dn(double nmx, complex128 z) const;
+    template<typename index_type>
+    static index_type get_bessel_ratio(const double nu, const index_type z) {
+        constexpr double tiny = 1e-300, tolerance = 4 * std::numeric_limits<double>::epsilon();
+        const size_t max_iterations = 100000 + 10 * static_cast<size_t>(std::abs(z));
+
+        index_type ratio = 2. * nu / z;
+        if (std::abs(ratio) < tiny) ratio = tiny;
+
+        index_type C = ratio, D = 0.0;
+
+        for (size_t k = 1; k < max_iterations; ++k) {
+            const index_type b = 2. * (nu + k) / z;
+
+            D = b - D;
+            if (std::abs(D) < tiny) D = tiny;
+
+            C = b - 1. / C;
+            if (std::abs(C) < tiny) C = tiny;
+
+            D = 1. / D;
+            const index_type delta = C * D;
+            ratio *= delta;
+
+            // While nu + k < |z| the partial denominators are small and delta can sit near 1 before convergence
+            if (nu + k > std::abs(z) && std::abs(delta - 1.) < tolerance)
+                return ratio;
+        }
+
+        throw std::runtime_error("Continued fraction for the logarithmic derivative did not converge.");
+    }
+
+    /**
+     * @brief Computes the logarithmic derivatives D_n(z) = psi_n'(z) / psi_n(z) of the Riccati-Bessel functions.
+     * @param max_order The highest order needed.
+     * @param z The argument m x, real (double) for non-absorbing particles or complex (complex128).
+     * @param Dn Caller-provided buffer of max_order + 1 elements at least, receives Dn[n] = D_n(z).
+     * @note D_max_order starts from get_bessel_ratio and the lower orders follow the downward recurrence (page 127 of BH),
+     * so no order past max_order is computed whatever |z|.
+     */
+    template<typename index_type>
+    static void compute_dn(const size_t max_order, const index_type z, std::span<index_type> Dn) {
+        Dn[max_order] = get_bessel_ratio(max_order + 0.5, z) - static_cast<double>(max_order) / z;
+
+        for (size_t n = max_order; n > 0; --n)
+            Dn[n - 1] = static_cast<double>(n) / z - 1. / (Dn[n] + static_cast<double>(n) / z);
+    }
 
     /**
      * @brief Computes near-field electromagnetic fields using internal coefficients cn and dn.
@@ -0,0 +1,105 @@
+#include "fast_legendre.h"
+
+#include <cmath>
+#include <array>
+#include <utils/fft.h>
+#include <utils/workspace.h>
+
+#define PI (double)3.14159265358979323846264338
+
+
+void legendre_to_chebyshev(const std::span<const complex128> legendre, const std::span<complex128> chebyshev) {
+    const size_t size = legendre.size();
+
+    Workspace::Scope scope;
+
+    // L(j) = Gamma(j + 1/2) / Gamma(j + 1)
+    std::span<double> lambda = Workspace::allocate<double>(size);
+    if (size > 0)
+        lambda[0] = std::sqrt(PI);
+    for (size_t j = 1; j < size; ++j)
+        lambda[j] = lambda[j - 1] * (j - 0.5) / j;
+
+    // Coefficients split by parity and into real and imaginary parts so the inner loop is contiguous
+    std::array<std::span<double>, 2> real_part, imag_part;
+    for (size_t parity = 0; parity < 2; ++parity) {
+        real_part[parity] = Workspace::allocate<double>((size + 1 - parity) / 2);
+        imag_part[parity] = Workspace::allocate<double>((size + 1 - parity) / 2);
+    }
+
+    for (size_t n = 0; n < size; ++n) {
+        real_part[n % 2][n / 2] = legendre[n].real();
+        imag_part[n % 2][n / 2] = legendre[n].imag();
+    }
+
+    for (size_t k = 0; k < size; ++k) {
+        const std::span<const double> l_real = real_part[k % 2], l_imag = imag_part[k % 2];
+        const size_t q = k / 2, count = l_real.size() - q;
+        const double *lambda_k = &lambda[k];
+
+        double sum_real = 0.0, sum_imag = 0.0;
+        for (size_t j = 0; j < count; ++j) {
+            const double weight = lambda[j] * lambda_k[j];
+            sum_real += weight * l_real[q + j];
+            sum_imag += weight * l_imag[q + j];
+        }
+
+        const double factor = (k == 0 ? 1.0 : 2.0) / PI;
+        chebyshev[k] = factor * complex128(sum_real, sum_imag);
+    }
+}
+
+std::vector<complex128> evaluate_cosine_series(const std::span<const complex128> coefficients, const std::span<const double> theta) {
+    constexpr int spread = 12;  // grid points on each side of an angle
+    const long long K = static_cast<long long>(coefficients.size()) - 1;
+
+    std::vector<complex128> output(theta.size());
+
+    if (K < 0)
+        return output;
+
+    const double n_modes = 2.0 * K + 1.0;
+    const size_t grid_size = next_power_of_two(static_cast<size_t>(2 * n_modes));
+    const double oversampling = grid_size / n_modes;
+    const double tau = PI * spread / (n_modes * n_modes * oversampling * (oversampling - 0.5));
+    const double step = 2.0 * PI / grid_size;
+
+    // Fourier coefficients f_{+-k} = c_k / 2, deconvolved by the Gaussian's spectrum sqrt(tau / pi) exp(-k^2 tau)
+    Workspace::Scope scope;
+    std::span<complex128> grid = Workspace::allocate<complex128>(grid_size, 0.0);
+    for (long long k = -K; k <= K; ++k) {
+        const complex128 mode = (k == 0) ? coefficients[0] : 0.5 * coefficients[std::abs(k)];
+        grid[(k + static_cast<long long>(grid_size)) % grid_size] = mode * std::sqrt(PI / tau) * std::exp(k * k * tau);
+    }
+
+    fft_radix2(grid, +1);
+
+    std::array<double, 2 * spread> gaussian_offset;
+    for (int l = -spread + 1; l <= spread; ++l)
+        gaussian_offset[l + spread - 1] = std::exp(-(l * step) * (l * step) / (4.0 * tau));
+
+    for (size_t i = 0; i < theta.size(); ++i) {
+        double x = std::fmod(theta[i], 2.0 * PI);
+        if (x < 0.0)
+            x += 2.0 * PI;
+
+        const long long m0 = static_cast<long long>(std::floor(x / step));
+        const double d0 = x - m0 * step;
+
+        // exp(-(d0 - l step)^2 / 4 tau) = exp(-d0^2 / 4 tau) * exp(d0 step / 2 tau)^l * exp(-(l step)^2 / 4 tau)
+        const double e1 = std::exp(-d0 * d0 / (4.0 * tau)), e2 = std::exp(d0 * step / (2.0 * tau));
+
+        complex128 value = 0.0;
+        double power = e1;
+        for (int l = 0; l <= spread; ++l, power *= e2)
+            value += grid[(m0 + l) & (grid_size - 1)] * (power * gaussian_offset[l + spread - 1]);
+
+        power = e1 / e2;
+        for (int l = -1; l > -spread; --l, power /= e2)
+            value += grid[(m0 + l + static_cast<long long>(grid_size)) & (grid_size - 1)] * (power * gaussian_offset[l + spread - 1]);
+
+        output[i] = value / static_cast<double>(grid_size);
+    }
+
+    return output;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <span>
+
+using complex128 = std::complex<double>;
+
+
+/**
+ * @brief Converts a Legendre series into the equivalent Chebyshev series.
+ * @param legendre The coefficients l_n of sum_n l_n P_n(mu), n = 0..N.
+ * @param chebyshev Filled with the coefficients c_k of sum_k c_k T_k(mu), k = 0..N.
+ * @note Uses P_n(cos t) = (1/pi) sum_j L(j) L(n - j) cos((n - 2j) t) with L(z) = Gamma(z + 1/2) / Gamma(z + 1).
+ * All the weights are positive so the conversion is stable; its cost is N^2 / 4 multiply-adds. The scratch
+ * buffers are taken from the workspace of the calling thread.
+ */
+void legendre_to_chebyshev(const std::span<const complex128> legendre, const std::span<complex128> chebyshev);
+
+/**
+ * @brief Evaluates the cosine series f(t) = sum_k c_k cos(k t) at arbitrary angles.
+ * @param coefficients The coefficients c_k, k = 0..N.
+ * @param theta The angles t in radians.
+ * @return The values f(t) at each angle.
+ * @note Non-uniform FFT with Gaussian gridding (Greengard & Lee, 2004): one FFT of twice the oversampled
+ * bandwidth followed by a 24-point interpolation per angle, accurate to about 1e-12 relative to sum_k |c_k|.
+ */
+std::vector<complex128> evaluate_cosine_series(const std::span<const complex128> coefficients, const std::span<const double> theta);
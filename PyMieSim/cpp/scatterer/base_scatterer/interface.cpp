@@ -62,6 +62,48 @@ void register_base_scatterer(pybind11::module_& module) {
                     A tuple containing the S1 and S2 scattering parameters, which represent the scattering amplitudes for the incident and scattered waves.
             )pbdoc"
         )
+        .def("_cpp_get_spherical_s1s2",
+            [](BaseScatterer& self, const std::vector<double> &phi, const std::string &method){
+                self.ensure_coefficients();
+
+                if (self.an.empty())
+                    throw std::invalid_argument("Spherical S1/S2 methods require the an and bn coefficients of a spherical scatterer.");
+
+                std::vector<complex128> S1, S2;
+
+                if (method == "auto")
+                    std::tie(S1, S2) = self.compute_spherical_s1s2(phi);
+                else if (method == "direct")
+                    std::tie(S1, S2) = self.compute_direct_spherical_s1s2(phi);
+                else if (method == "fast")
+                    std::tie(S1, S2) = self.compute_fast_spherical_s1s2(phi);
+                else
+                    throw std::invalid_argument("Invalid method: " + method + ", expected 'auto', 'direct' or 'fast'.");
+
+                return std::make_tuple(
+                    vector_move_from_numpy(S1, {S1.size()}),
+                    vector_move_from_numpy(S2, {S2.size()})
+                );
+            },
+            pybind11::arg("phi"),
+            pybind11::arg("method") = "auto",
+            R"pbdoc(
+                Calculates the S1 and S2 scattering parameters of a spherical scatterer with a given method.
+
+                Parameters
+                ----------
+                phi : float
+                    The angle (in radians) at which the scattering is calculated.
+                method : str, optional
+                    'direct' sums the partial waves at each angle, 'fast' uses the fast Legendre transform and
+                    'auto' (default) selects between them as `_cpp_get_s1s2` does.
+
+                Returns
+                -------
+                tuple
+                    A tuple containing the S1 and S2 scattering parameters.
+            )pbdoc"
+        )
         .def("_cpp_get_farfields",
             [](BaseScatterer& self, const std::vector<double>& phi, const std::vector<double>& theta, const double& distance) {
                 auto [theta_field, phi_field] = self.compute_unstructured_farfields(phi, theta, distance);
@@ -388,6 +430,18 @@ void register_base_scatterer(pybind11::module_& module) {
                     The size parameter (size_parameter), typically the ratio of the scatterer's diameter to the wavelength of incident light.
             )pbdoc"
         )
+        .def_property_readonly("_cpp_regime",
+            [](const BaseScatterer& self) {return static_cast<int>(self.regime);},
+            R"pbdoc(
+                Regime used to evaluate the scatterer.
+
+                Returns
+                -------
+                int
+                    0 for the exact Mie series, 1 for the Rayleigh regime and 2 for the anomalous-diffraction
+                    approximation of the extinction-type quantities.
+            )pbdoc"
+        )
         .def("_cpp_compute_nearfields",  // &BaseScatterer::compute_nearfields_py,
             [](BaseScatterer& self, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::string& field_type) {
                 std::vector<complex128> field = self.compute_nearfields(x, y, z, field_type);
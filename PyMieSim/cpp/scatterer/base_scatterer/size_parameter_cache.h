@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <complex>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <utils/shared_instance.h>
+
+typedef std::complex<double> complex128;
+
+
+enum class SizeParameterTableKind {
+    RiccatiBessel,     // sphere: psi_n(x), chi_n(x)
+    CylindricalBessel  // cylinder: J_n(x), J_n'(x), H_n(x), H_n'(x)
+};
+
+
+/**
+ * @brief Tables of special functions of the real size parameter, shared by scatterers that only differ by index.
+ * @note rows[r][n] holds the r-th function at order n, for n < n_terms.
+ */
+struct SizeParameterTable {
+    SizeParameterTableKind kind;
+    double size_parameter;
+    size_t n_terms;
+    std::vector<std::vector<complex128>> rows;
+};
+
+
+/**
+ * @brief Process-wide LRU cache of SizeParameterTable, shared by all the threads of an experiment.
+ *
+ * Whichever thread evaluates a scatterer, it finds the table computed for any other scatterer of the same
+ * size parameter, so the reuse along an index sweep does not depend on how the sweep is split between threads.
+ * Each thread also keeps the last table it used of each kind: consecutive scatterers of the same size parameter
+ * (see ScattererSet::get_sweep_index) are served without taking the lock.
+ * @note The instance is a SharedInstance, the scatterers built by Setup and the single ones use the same cache.
+ */
+class SizeParameterTableCache {
+    public:
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            size_t size = 0;
+            size_t capacity = 0;
+        };
+
+        /**
+         * @brief Returns the process-wide cache.
+         */
+        static SizeParameterTableCache& get_instance() {return SharedInstance<SizeParameterTableCache>::get();}
+
+        /**
+         * @brief Returns the table of the given kind for size_parameter, computing it on a miss.
+         * @param kind The functions held by the table.
+         * @param size_parameter The real size parameter the table depends on.
+         * @param n_terms The number of orders needed. A cached table with more orders is reused.
+         * @param compute Callable returning the rows for n_terms orders when the table is missing.
+         * @return A shared table.
+         * @note The entry is inserted under the lock and filled outside of it, once: threads missing the same
+         * table concurrently wait for the first one instead of computing it each, so the hit and miss counts
+         * only depend on the scatterers evaluated.
+         */
+        template<typename Compute>
+        std::shared_ptr<const SizeParameterTable> get_table(const SizeParameterTableKind kind, const double size_parameter, const size_t n_terms, Compute&& compute) {
+            Memo& memo = get_memo(kind);
+
+            if (memo.cache == this && memo.generation == generation.load(std::memory_order_acquire)
+                && memo.table->size_parameter == size_parameter && memo.table->n_terms >= n_terms) {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return memo.table;
+            }
+
+            std::shared_ptr<Slot> slot;
+            size_t current_generation;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current_generation = generation.load(std::memory_order_relaxed);
+
+                auto it = lookup.find({kind, size_parameter});
+
+                if (it != lookup.end() && it->second->n_terms >= n_terms) {
+                    entries.splice(entries.begin(), entries, it->second);
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    slot = it->second->slot;
+                }
+                else {
+                    // A cached table with fewer orders is replaced, the scatterers holding it keep it alive
+                    if (it != lookup.end()) {
+                        entries.erase(it->second);
+                        lookup.erase(it);
+                    }
+
+                    ++statistics.misses;
+                    slot = std::make_shared<Slot>();
+                    entries.push_front({{kind, size_parameter}, n_terms, slot});
+                    lookup[{kind, size_parameter}] = entries.begin();
+                    this->evict();
+                }
+            }
+
+            std::call_once(slot->flag, [&]() {
+                slot->table = SizeParameterTable{kind, size_parameter, n_terms, compute()};
+            });
+
+            std::shared_ptr<const SizeParameterTable> table(slot, &slot->table);
+            memo = {this, current_generation, table};
+
+            return table;
+        }
+
+        /**
+         * @brief Returns the hit, miss and eviction counters along with the current size and capacity.
+         */
+        Statistics get_statistics() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            Statistics output = statistics;
+            output.hits = hits.load(std::memory_order_relaxed);
+            output.size = entries.size();
+            output.capacity = capacity;
+            return output;
+        }
+
+        /**
+         * @brief Removes every cached table and resets the counters.
+         * @note The tables kept by the threads are discarded as well, the next lookup of each thread taking the lock.
+         */
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+            lookup.clear();
+            statistics = Statistics();
+            hits.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+
+    private:
+        struct Slot {
+            std::once_flag flag;
+            SizeParameterTable table;
+        };
+
+        struct Key {
+            SizeParameterTableKind kind;
+            double size_parameter;
+
+            bool operator==(const Key& other) const {return kind == other.kind && size_parameter == other.size_parameter;}
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& key) const {return std::hash<double>()(key.size_parameter) ^ static_cast<size_t>(key.kind);}
+        };
+
+        struct Entry {
+            Key key;
+            size_t n_terms;
+            std::shared_ptr<Slot> slot;
+        };
+
+        struct Memo {
+            const SizeParameterTableCache* cache = nullptr;
+            size_t generation = 0;
+            std::shared_ptr<const SizeParameterTable> table;
+        };
+
+        std::mutex mutex;
+        std::list<Entry> entries;  // most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+        size_t capacity = 64;
+        Statistics statistics;  // hits are counted apart, without the lock on the per-thread path
+        std::atomic<size_t> hits{0};
+        std::atomic<size_t> generation{0};
+
+        SizeParameterTableCache() = default;
+        friend class SharedInstance<SizeParameterTableCache>;
+
+        static Memo& get_memo(const SizeParameterTableKind kind) {
+            thread_local Memo memos[2];  // one per SizeParameterTableKind
+            return memos[static_cast<size_t>(kind)];
+        }
+
+        void evict() {
+            while (entries.size() > capacity) {
+                lookup.erase(entries.back().key);
+                entries.pop_back();
+                ++statistics.evictions;
+            }
+        }
+};
+
+
+/**
+ * @brief Returns the table of the given kind for size_parameter from the SizeParameterTableCache.
+ * @param kind The functions held by the table.
+ * @param size_parameter The real size parameter the table depends on.
+ * @param n_terms The number of orders needed. A cached table with more orders is reused.
+ * @param compute Callable returning the rows for n_terms orders when the table is missing.
+ * @return A shared table, kept alive by the pointer even once evicted.
+ * @note Experiment visits the refractive-index axes of a scatterer set innermost (ScattererSet::get_sweep_index), so
+ * sweeps over many indices compute the size-parameter dependent functions once per diameter, wavelength and medium.
+ */
+template<typename Compute>
+std::shared_ptr<const SizeParameterTable> get_size_parameter_table(const SizeParameterTableKind kind, const double size_parameter, const size_t n_terms, Compute&& compute)
+{
+    return SizeParameterTableCache::get_instance().get_table(kind, size_parameter, n_terms, std::forward<Compute>(compute));
+}
@@ -1,4 +1,5 @@
 #include "./coreshell.h"
+#include <type_traits>
 
 
 // ---------------------- Constructors ---------------------------------------
@@ -47,77 +48,129 @@ void CoreShell::apply_medium() {
     this->shell_diameter *= this->medium_refractive_index;
 }
 
-void CoreShell::compute_an_bn(const size_t max_order)
-{
-    an.resize(max_order);
-    bn.resize(max_order);
+namespace {
+    /**
+     * @brief Riccati-Bessel psi_n(z) and chi_n(z) of a real argument for n = 1 to psi.size(), without AMOS calls.
+     * @param D D[n - 1] holds the logarithmic derivative D_n(z), from the downward recurrence.
+     * @note chi_n comes from the upward recurrence, psi_n too while n <= z and from psi_(n-1) / psi_n = D_n(z) + n / z beyond.
+     */
+    void compute_real_riccati_bessel(const double z, std::span<const double> D, std::span<double> psi, std::span<double> chi) {
+        double psi_1 = sin(z), psi_2 = cos(z), chi_1 = cos(z), chi_2 = -sin(z);
 
-    // Calculate scaled parameters and initialize phase shift factors
-    complex128
-        relative_index = this->shell_refractive_index / this->core_refractive_index,
-        u = this->core_refractive_index * this->x_core,
-        v = this->shell_refractive_index * this->x_core,
-        w = this->shell_refractive_index * this->x_shell,
-        sv = sqrt(0.5 * PI * v),
-        sw = sqrt(0.5 * PI * w),
-        sy = sqrt(0.5 * PI * this->x_shell);
+        for (size_t order = 0; order < psi.size(); ++order) {
+            const double nu = order + 1.;
 
-    // Determine the necessary array size for continuity factors
-    size_t mx = static_cast<size_t>(std::max( abs( this->core_refractive_index * this->x_shell ), abs( this->shell_refractive_index*this->x_shell ) ));
-    size_t nmx  = std::max( max_order, mx ) + 16  ;
+            psi[order] = (nu <= z) ? (2. * nu - 1.) / z * psi_1 - psi_2 : psi_1 / (D[order] + nu / z);
+            chi[order] = (2. * nu - 1.) / z * chi_1 - chi_2;
 
-    std::vector<complex128> pv(max_order + 1), pw(max_order + 1), py(max_order + 1), chv(max_order + 1), chw(max_order + 1), chy(max_order + 1), gsy(max_order + 1), gs1y(max_order + 1);
-    std::vector<complex128> p1y(max_order + 2), ch1y(max_order + 2);
+            psi_2 = psi_1; psi_1 = psi[order];
+            chi_2 = chi_1; chi_1 = chi[order];
+        }
+    }
+}
 
-    p1y[0] = sin(this->x_shell);
-    ch1y[0] = cos(this->x_shell);
+void CoreShell::compute_an_bn(const size_t max_order)
+{
+    // Non-absorbing core and shell take the real instantiation
+    if (this->core_refractive_index.imag() == 0.0 && this->shell_refractive_index.imag() == 0.0)
+        this->compute_an_bn_kernel<double>(max_order, this->core_refractive_index.real(), this->shell_refractive_index.real());
+    else
+        this->compute_an_bn_kernel<complex128>(max_order, this->core_refractive_index, this->shell_refractive_index);
+}
 
-    for (size_t order = 0; order < max_order + 1; order++){
-        double nu = order + 1.5 ;
+template<typename index_type>
+void CoreShell::compute_an_bn_kernel(const size_t max_order, const index_type core_index, const index_type shell_index)
+{
+    an.resize(max_order);
+    bn.resize(max_order);
 
-        pw[order] = sw * Cylindrical_::Jn(nu, (complex128) w);
-        pv[order] = sv * Cylindrical_::Jn(nu, (complex128) v);
-        py[order] = sy * Cylindrical_::Jn(nu, (complex128) this->x_shell);
+    // Calculate scaled parameters and initialize phase shift factors
+    const index_type
+        relative_index = shell_index / core_index,
+        u = core_index * this->x_core,
+        v = shell_index * this->x_core,
+        w = shell_index * this->x_shell;
+
+    // Scratch buffers come from this thread's workspace and are released on return
+    Workspace::Scope scope;
+
+    // Continuity factors D_n for n = 0 to max_order + 1
+    std::span<index_type>
+        Du = Workspace::allocate<index_type>(max_order + 2),
+        Dv = Workspace::allocate<index_type>(max_order + 2),
+        Dw = Workspace::allocate<index_type>(max_order + 2);
+
+    this->compute_dn(max_order + 1, u, Du);
+    this->compute_dn(max_order + 1, v, Dv);
+    this->compute_dn(max_order + 1, w, Dw);
+
+    // Shift continuity factors so that index order holds D_(order + 1)
+    Du = Du.subspan(1);
+    Dv = Dv.subspan(1);
+    Dw = Dw.subspan(1);
+
+    // Riccati-Bessel functions of order + 1 in the shell, real arguments skip the AMOS calls
+    std::span<index_type>
+        pv = Workspace::allocate<index_type>(max_order + 1),
+        pw = Workspace::allocate<index_type>(max_order + 1),
+        chv = Workspace::allocate<index_type>(max_order + 1),
+        chw = Workspace::allocate<index_type>(max_order + 1);
+
+    if constexpr (std::is_same_v<index_type, double>) {
+        compute_real_riccati_bessel(v, Dv, pv, chv);
+        compute_real_riccati_bessel(w, Dw, pw, chw);
+    }
+    else {
+        const index_type sv = sqrt(0.5 * PI * v), sw = sqrt(0.5 * PI * w);
 
-        chv[order] = -sv * Cylindrical_::Yn(nu, v);
-        chw[order] = -sw * Cylindrical_::Yn(nu, w);
-        chy[order] = -sy * Cylindrical_::Yn(nu, this->x_shell);
+        for (size_t order = 0; order < max_order + 1; order++){
+            double nu = order + 1.5 ;
 
-        p1y[order + 1] = py[order];
-        ch1y[order + 1] = chy[order];
-        gsy[order] = py[order]  - complex128(0, 1) * chy[order];
-        gs1y[order] = p1y[order] - complex128(0, 1) * ch1y[order];
+            pw[order] = sw * Cylindrical_::Jn(nu, w);
+            pv[order] = sv * Cylindrical_::Jn(nu, v);
+            chv[order] = -sv * Cylindrical_::Yn(nu, v);
+            chw[order] = -sw * Cylindrical_::Yn(nu, w);
+        }
     }
 
-    // Calculate continuity factors in reverse order
-    std::vector<complex128> Du(nmx, 0.0), Dv(nmx, 0.0), Dw(nmx, 0.0);
+    // psi_n(x_shell) and chi_n(x_shell) only depend on the size parameter, shared with the other scatterers of that size
+    const std::shared_ptr<const SizeParameterTable> table = get_size_parameter_table(SizeParameterTableKind::RiccatiBessel, this->x_shell, max_order + 2, [&]() {
+        std::vector<std::vector<complex128>> rows(2, std::vector<complex128>(max_order + 2));
+        rows[0][0] = sin(this->x_shell);
+        rows[1][0] = cos(this->x_shell);
 
-    for (int i = nmx - 1; i > 1; i--){
-        Du[i-1] = (double)i / u - 1.0 / (Du[i] + (double)i / u);
-        Dv[i-1] = (double)i / v - 1.0 / (Dv[i] + (double)i / v);
-        Dw[i-1] = (double)i / w - 1.0 / (Dw[i] + (double)i / w);
-    }
+        for (size_t n = 1; n <= max_order + 1; ++n) {
+            rows[0][n] = +this->x_shell * Spherical_::jn(n, this->x_shell);
+            rows[1][n] = -this->x_shell * Spherical_::yn(n, this->x_shell);
+        }
+        return rows;
+    });
 
-    // Resize continuity factors to maximum order needed
-    Du.erase(Du.begin());
-    Dv.erase(Dv.begin());
-    Dw.erase(Dw.begin());
+    std::span<double> py = Workspace::allocate<double>(max_order + 1), p1y = Workspace::allocate<double>(max_order + 1);
+    std::span<complex128> gsy = Workspace::allocate<complex128>(max_order + 1), gs1y = Workspace::allocate<complex128>(max_order + 1);
 
-    // Calculate Mie coefficients
-    std::vector<complex128> uu(max_order), vv(max_order), fv(max_order), dns(max_order), gns(max_order), a1(max_order), b1(max_order);
+    for (size_t order = 0; order < max_order + 1; order++){
+        py[order] = table->rows[0][order + 1].real();
+        p1y[order] = table->rows[0][order].real();
+        gsy[order] = py[order] - complex128(0, 1) * table->rows[1][order + 1].real();
+        gs1y[order] = p1y[order] - complex128(0, 1) * table->rows[1][order].real();
+    }
 
+    // Calculate Mie coefficients, only the last division is complex when both indices are real
     for (size_t order=0; order < max_order; order++){
         double idx = static_cast<double>(order + 1);
 
-        uu[order] = relative_index * Du[order] - Dv[order];
-        vv[order] = Du[order] / relative_index - Dv[order];
-        fv[order] = pv[order] / chv[order];
-        dns[order] = ((uu[order] * fv[order] / pw[order]) / (uu[order] * (pw[order] - chw[order] * fv[order]) + pw[order] / pv[order] / chv[order])) + Dw[order];
-        gns[order] = ((vv[order] * fv[order] / pw[order]) / (vv[order] * (pw[order] - chw[order] * fv[order]) + pw[order] / pv[order] / chv[order])) + Dw[order];
-        a1[order] = dns[order] / shell_refractive_index + idx / x_shell;
-        b1[order] = shell_refractive_index * gns[order] + idx / x_shell;
-        an[order] = (py[order] * a1[order] - p1y[order]) / (gsy[order] * a1[order] - gs1y[order]);
-        bn[order] = (py[order] * b1[order] - p1y[order]) / (gsy[order] * b1[order] - gs1y[order]);
+        const index_type
+            uu = relative_index * Du[order] - Dv[order],
+            vv = Du[order] / relative_index - Dv[order],
+            fv = pv[order] / chv[order],
+            dns = ((uu * fv / pw[order]) / (uu * (pw[order] - chw[order] * fv) + pw[order] / pv[order] / chv[order])) + Dw[order],
+            gns = ((vv * fv / pw[order]) / (vv * (pw[order] - chw[order] * fv) + pw[order] / pv[order] / chv[order])) + Dw[order],
+            a1 = dns / shell_index + idx / x_shell,
+            b1 = shell_index * gns + idx / x_shell;
+
+        an[order] = (py[order] * a1 - p1y[order]) / (gsy[order] * a1 - gs1y[order]);
+        bn[order] = (py[order] * b1 - p1y[order]) / (gsy[order] * b1 - gs1y[order]);
     }
 }
 
@@ -185,31 +238,7 @@ double CoreShell::get_g() const {
 
 std::tuple<std::vector<complex128>, std::vector<complex128>>
 CoreShell::compute_s1s2(const std::vector<double> &phi) const {
-    std::vector<complex128> S1, S2;
-
-    S1.reserve(phi.size());
-    S2.reserve(phi.size());
-
-    std::vector<double> mu, prefactor = get_prefactor();
-
-    mu.reserve(phi.size());
-
-    for (const double phi : phi)
-        mu.push_back( cos( phi - PI / 2.0 ) );
-
-    for (size_t i = 0; i < phi.size(); i++){
-        auto [pin, taun] = this->get_pi_tau(mu[i], max_order);
-        complex128 S1_temp = 0., S2_temp = 0.;
-
-        for (size_t m = 0; m < max_order ; m++){
-            S1_temp += prefactor[m] * ( this->an[m] * pin[m] +  this->bn[m] * taun[m] );
-            S2_temp += prefactor[m] * ( this->an[m] * taun[m] + this->bn[m] * pin[m]  );
-        }
-        S1.push_back(S1_temp);
-        S2.push_back(S2_temp);
-    }
-
-    return std::make_tuple(std::move(S1), std::move(S2));
+    return this->compute_spherical_s1s2(phi);
 }
 
 void CoreShell::compute_cn_dn(size_t) {
@@ -48,6 +48,16 @@ class CoreShell: public BaseScatterer
          */
         void compute_an_bn(const size_t max_order = 0) override;
 
+        /**
+         * @brief Computes an and bn for core and shell indices, relative to the medium, of type index_type.
+         * @param max_order The maximum order of the coefficients to compute.
+         * @param core_index The relative core refractive index.
+         * @param shell_index The relative shell refractive index.
+         * @note The double instantiation, used when neither layer absorbs, keeps the continuity factors real.
+         */
+        template<typename index_type>
+        void compute_an_bn_kernel(const size_t max_order, const index_type core_index, const index_type shell_index);
+
         /**
          * @brief Computes the coefficients cn and dn for a sphere.
          * @param _max_order The maximum order of the coefficients to compute.
@@ -90,6 +100,8 @@ class CoreShell: public BaseScatterer
          * @return A tuple containing two vectors: S1 and S2, which are the scattering amplitudes.
          */
         std::tuple<std::vector<complex128>, std::vector<complex128>> compute_s1s2(const std::vector<double> &phi) const override;
+        std::tuple<std::vector<complex128>, std::vector<complex128>> compute_mesh_s1s2(const std::vector<double> &phi) const override {return this->compute_cached_spherical_s1s2(phi);}
+        bool has_spherical_amplitudes() const override {return true;}
 
         /**
          * @brief Computes the near-field electromagnetic fields for a sphere.
@@ -45,19 +45,80 @@ double Cylinder::get_Qext() const {
     }
 
     Qext1 = 2. / size_parameter * std::real( this->b1n[0] + 2.0 * Qext1 );
-    Qext2 = 2. / size_parameter * std::real( this->a1n[0] + 2.0 * Qext2 );
+    Qext2 = 2. / size_parameter * std::real( this->a2n[0] + 2.0 * Qext2 );
 
     return this->process_polarization(Qext1, Qext2);
 }
 
 double Cylinder::get_g() const {
-    return this->get_g_with_farfields(1000);
+    double norm1 = 0, norm2 = 0, cos1 = 0, cos2 = 0;
+
+    for (size_t order = 0; order < max_order; ++order) {
+        const double weight = (order == 0) ? 1.0 : 2.0;
+        norm1 += weight * std::norm(this->b1n[order]);
+        norm2 += weight * std::norm(this->a2n[order]);
+
+        if (order + 1 < max_order) {
+            cos1 += 2.0 * std::real(this->b1n[order] * std::conj(this->b1n[order + 1]));
+            cos2 += 2.0 * std::real(this->a2n[order] * std::conj(this->a2n[order + 1]));
+        }
+    }
+
+    const double
+        weight1 = std::norm(source.jones_vector[1]),
+        weight2 = std::norm(source.jones_vector[0]);
+
+    return (cos2 * weight2 + cos1 * weight1) / (norm2 * weight2 + norm1 * weight1);
+}
+
+double Cylinder::get_g_with_angular_integral(const size_t sampling) const {
+    std::vector<double> phi(sampling);
+    for (size_t i = 0; i < sampling; ++i)
+        phi[i] = 2.0 * PI * i / sampling;
+
+    // compute_s1s2 evaluates the amplitudes at the scattering angle theta = pi / 2 - phi, so cos(theta) = sin(phi)
+    auto [T1, T2] = this->compute_s1s2(phi);
+
+    double norm1 = 0, norm2 = 0, cos1 = 0, cos2 = 0;
+
+    for (size_t i = 0; i < sampling; ++i) {
+        const double cos_theta = sin(phi[i]);
+        norm1 += std::norm(T1[i]);
+        norm2 += std::norm(T2[i]);
+        cos1 += std::norm(T1[i]) * cos_theta;
+        cos2 += std::norm(T2[i]) * cos_theta;
+    }
+
+    const double
+        weight1 = std::norm(source.jones_vector[1]),
+        weight2 = std::norm(source.jones_vector[0]);
+
+    return (cos2 * weight2 + cos1 * weight1) / (norm2 * weight2 + norm1 * weight1);
 }
 
 double Cylinder::process_polarization(const complex128 value_0, const complex128 value_1) const {
     return std::abs( value_1 ) * pow(std::abs(source.jones_vector[0]), 2) + std::abs( value_0 ) * pow(std::abs(source.jones_vector[1]), 2);
 }
 
+namespace {
+    /**
+     * @brief Returns J_n(x), J_n'(x), H_n(x) and H_n'(x) for orders 0 to max_order, shared by cylinders that only differ by index.
+     */
+    std::shared_ptr<const SizeParameterTable> get_cylindrical_table(const double size_parameter, const size_t max_order) {
+        return get_size_parameter_table(SizeParameterTableKind::CylindricalBessel, size_parameter, max_order + 1, [&]() {
+            std::vector<std::vector<complex128>> rows(4, std::vector<complex128>(max_order + 1));
+
+            for (size_t order = 0; order < max_order + 1; ++order) {
+                rows[0][order] = Cylindrical_::Jn(order, size_parameter);
+                rows[1][order] = Cylindrical_::Jnp(order, size_parameter);
+                rows[2][order] = Cylindrical_::H1n(order, size_parameter);
+                rows[3][order] = Cylindrical_::H1np(order, size_parameter);
+            }
+            return rows;
+        });
+    }
+}
+
 void Cylinder::compute_an_bn(const size_t max_order) {
     // Resize vectors to hold Mie coefficients for the specified maximum order
     this->a1n.resize(max_order);
@@ -70,33 +131,27 @@ void Cylinder::compute_an_bn(const size_t max_order) {
         m = this->refractive_index / this->medium_refractive_index, // Relative refractive index
         mx = m * size_parameter; // Scaled size parameter for internal calculations
 
-    // Precompute Bessel and Hankel functions up to max_order
-    std::vector<complex128>
-        J_z(max_order + 1),
-        J_z_p(max_order + 1),
-        J_x(max_order + 1),
-        J_x_p(max_order + 1),
-        H_x(max_order + 1),
-        H_x_p(max_order + 1);
-
-    for (size_t order = 0; order < max_order + 1; ++order){
-        J_z[order] = Cylindrical_::Jn(order, mx);
-        J_z_p[order] = Cylindrical_::Jnp(order, mx);
-        J_x[order] = Cylindrical_::Jn(order, size_parameter);
-        J_x_p[order] = Cylindrical_::Jnp(order, size_parameter);
-        H_x[order] = Cylindrical_::H1n(order, size_parameter);
-        H_x_p[order] = Cylindrical_::H1np(order, size_parameter);
-    }
+    // Inside the cylinder only J_n'(mx) / J_n(mx) enters once numerators and denominators are divided by J_n(mx)
+    Workspace::Scope scope;
+    std::span<complex128> Dn = Workspace::allocate<complex128>(max_order + 1);
+    this->compute_dn(max_order, mx, Dn);
+
+    const std::shared_ptr<const SizeParameterTable> table = get_cylindrical_table(size_parameter, max_order);
+    const std::vector<complex128>
+        &J_x = table->rows[0],
+        &J_x_p = table->rows[1],
+        &H_x = table->rows[2],
+        &H_x_p = table->rows[3];
 
     // Compute Mie coefficients a1n, a2n, b1n, b2n for each order
     for (size_t order = 0; order < max_order; order++){
-        complex128 numerator_a = m * J_z[order] * J_x_p[order] - J_z_p[order] * J_x[order];
-        complex128 denominator_a = m * J_z[order] * H_x_p[order] - J_z_p[order] * H_x[order];
+        complex128 numerator_a = m * J_x_p[order] - Dn[order] * J_x[order];
+        complex128 denominator_a = m * H_x_p[order] - Dn[order] * H_x[order];
         this->a1n[order] = 0.0 ;
         this->a2n[order] = numerator_a / denominator_a;
 
-        complex128 numerator_b = J_z[order] * J_x_p[order] - m * J_z_p[order] * J_x[order];
-        complex128 denominator_b = J_z[order] * H_x_p[order] - m * J_z_p[order] * H_x[order];
+        complex128 numerator_b = J_x_p[order] - m * Dn[order] * J_x[order];
+        complex128 denominator_b = H_x_p[order] - m * Dn[order] * H_x[order];
         this->b1n[order] = numerator_b / denominator_b;
         this->b2n[order] = 0.0 ;
     }
@@ -116,35 +171,29 @@ void Cylinder::compute_cn_dn(const size_t max_order) {
     // Impedance ratio (used in TE mode internal coefficient)
     // complex128 m_tilde = this->medium_impedance / this->particle_impedance;
 
-    // Precompute Bessel and Hankel functions
-    std::vector<complex128>
-        J_z(max_order + 1),
-        J_z_p(max_order + 1),
-        J_x(max_order + 1),
-        J_x_p(max_order + 1),
-        H_x(max_order + 1),
-        H_x_p(max_order + 1);
-
-    for (size_t order = 0; order < max_order + 1; ++order){
-        J_z[order]  = Cylindrical_::Jn(order, mx);
-        J_z_p[order]= Cylindrical_::Jnp(order, mx);
-        J_x[order]  = Cylindrical_::Jn(order, size_parameter);
-        J_x_p[order]= Cylindrical_::Jnp(order, size_parameter);
-        H_x[order]  = Cylindrical_::H1n(order, size_parameter);
-        H_x_p[order]= Cylindrical_::H1np(order, size_parameter);
-    }
+    // Inside the cylinder only J_n'(mx) / J_n(mx) enters once numerators and denominators are divided by J_n(mx)
+    Workspace::Scope scope;
+    std::span<complex128> Dn = Workspace::allocate<complex128>(max_order + 1);
+    this->compute_dn(max_order, mx, Dn);
+
+    const std::shared_ptr<const SizeParameterTable> table = get_cylindrical_table(size_parameter, max_order);
+    const std::vector<complex128>
+        &J_x = table->rows[0],
+        &J_x_p = table->rows[1],
+        &H_x = table->rows[2],
+        &H_x_p = table->rows[3];
 
     // Compute internal coefficients c1n, c2n, d1n, d2n
     for (size_t order = 0; order < max_order; ++order) {
         // --- TM polarization (Mode I) ---
-        complex128 num_d1 = J_z[order] * H_x_p[order] - m * J_z_p[order] * H_x[order];
-        complex128 den_d1 = J_z[order] * J_x_p[order] - m * J_z_p[order] * J_x[order];
+        complex128 num_d1 = H_x_p[order] - m * Dn[order] * H_x[order];
+        complex128 den_d1 = J_x_p[order] - m * Dn[order] * J_x[order];
         this->d1n[order] = num_d1 / den_d1;
         this->c1n[order] = 0.0;  // Not used in TM polarization
 
         // --- TE polarization (Mode II) ---
-        complex128 num_c2 = m * J_z[order] * H_x_p[order] - J_z_p[order] * H_x[order];
-        complex128 den_c2 = m * J_z[order] * J_x_p[order] - J_z_p[order] * J_x[order];
+        complex128 num_c2 = m * H_x_p[order] - Dn[order] * H_x[order];
+        complex128 den_c2 = m * J_x_p[order] - Dn[order] * J_x[order];
         this->c2n[order] = num_c2 / den_c2;
         this->d2n[order] = 0.0;  // Not used in TE polarization
     }
@@ -153,14 +202,63 @@ void Cylinder::compute_cn_dn(const size_t max_order) {
 
 std::tuple<std::vector<complex128>, std::vector<complex128>>
 Cylinder::compute_s1s2(const std::vector<double> &phi) const{
-    std::vector<complex128> T1(phi.size()), T2(phi.size());
-
-    for (size_t i = 0; i < phi.size(); i++){
-        T1[i] = this->b1n[0];
-        T2[i] = this->a2n[0];
-        for (size_t order = 1; order < max_order ; order++){
-            T1[i] += 2.0 * this->b1n[order] * cos(order * (PI - (phi[i] + PI/2.0) ) );
-            T2[i] += 2.0 * this->a2n[order] * cos(order * (PI - (phi[i] + PI/2.0) ) );
+    constexpr size_t block_size = 64;
+    const size_t n_angles = phi.size();
+
+    std::vector<complex128> T1(n_angles), T2(n_angles);
+
+    // T1 = b1_0 + 2 sum_n b1_n cos(n theta), T2 likewise with a2n, theta = PI - (phi + PI / 2)
+    Workspace::Scope scope;
+    std::span<double>
+        b_real = Workspace::allocate<double>(max_order),
+        b_imag = Workspace::allocate<double>(max_order),
+        a_real = Workspace::allocate<double>(max_order),
+        a_imag = Workspace::allocate<double>(max_order);
+
+    for (size_t order = 0; order < max_order; ++order) {
+        const double weight = (order == 0) ? 1.0 : 2.0;
+        b_real[order] = weight * this->b1n[order].real();
+        b_imag[order] = weight * this->b1n[order].imag();
+        a_real[order] = weight * this->a2n[order].real();
+        a_imag[order] = weight * this->a2n[order].imag();
+    }
+
+    // cos(n theta) from the Chebyshev recurrence cos((n + 1) theta) = 2 cos(theta) cos(n theta) - cos((n - 1) theta),
+    // shared by T1 and T2 and vectorized over a block of angles
+    std::array<double, block_size> cos_theta, cos_previous, cos_current, T1_real, T1_imag, T2_real, T2_imag;
+
+    for (size_t start = 0; start < n_angles; start += block_size) {
+        const size_t width = std::min(block_size, n_angles - start);
+
+        for (size_t i = 0; i < block_size; ++i) {
+            cos_theta[i] = (i < width) ? cos(PI - (phi[start + i] + PI / 2.0)) : 0.0;
+            cos_previous[i] = cos_theta[i];  // cos(-theta)
+            cos_current[i] = 1.0;
+            T1_real[i] = b_real[0];
+            T1_imag[i] = b_imag[0];
+            T2_real[i] = a_real[0];
+            T2_imag[i] = a_imag[0];
+        }
+
+        for (size_t order = 1; order < max_order; ++order) {
+            const double br = b_real[order], bi = b_imag[order], ar = a_real[order], ai = a_imag[order];
+
+            for (size_t i = 0; i < block_size; ++i) {
+                const double cos_n = 2.0 * cos_theta[i] * cos_current[i] - cos_previous[i];
+
+                cos_previous[i] = cos_current[i];
+                cos_current[i] = cos_n;
+
+                T1_real[i] += br * cos_n;
+                T1_imag[i] += bi * cos_n;
+                T2_real[i] += ar * cos_n;
+                T2_imag[i] += ai * cos_n;
+            }
+        }
+
+        for (size_t i = 0; i < width; ++i) {
+            T1[start + i] = complex128(T1_real[i], T1_imag[i]);
+            T2[start + i] = complex128(T2_real[i], T2_imag[i]);
         }
     }
 
@@ -168,14 +266,12 @@ Cylinder::compute_s1s2(const std::vector<double> &phi) const{
 }
 
 
-std::vector<complex128>
-Cylinder::compute_dn(double nmx, complex128 z) const { //Page 205 of BH
-    std::vector<complex128> Dn(nmx, 0.0);
-
-    for (double n = nmx - 1; n > 0; n--)
-        Dn[n-1] = n/z - ( 1. / (Dn[n] + n/z) );
+void
+Cylinder::compute_dn(const size_t max_order, const complex128 z, std::span<complex128> Dn) { //Page 205 of BH
+    Dn[max_order] = get_bessel_ratio(static_cast<double>(max_order), z) - static_cast<double>(max_order) / z;
 
-    return Dn;
+    for (size_t n = max_order; n > 0; --n)
+        Dn[n - 1] = static_cast<double>(n - 1) / z - 1. / (Dn[n] + static_cast<double>(n) / z);
 }
 
 std::vector<complex128> Cylinder::compute_nearfields(const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::string&) {
@@ -66,11 +66,23 @@ class Cylinder: public BaseScatterer
         double get_Qback() const override {throw std::logic_error{"Function not implemented!"};}
 
         /**
-         * @brief Computes the asymmetry factor g for a sphere.
+         * @brief Computes the asymmetry factor g for a cylinder.
          * @return The asymmetry factor g.
+         * @note For each mode, with c_n = b1n (mode I) or a2n (mode II) and T(theta) = c_0 + 2 sum_n c_n cos(n theta),
+         * g = 2 sum_{n>=0} Re(c_n c*_{n+1}) / (|c_0|^2 + 2 sum_{n>=1} |c_n|^2). Both modes are combined with the
+         * weights of the Jones vector and their scattered power, as in get_Qsca.
          */
         double get_g() const override;
 
+        /**
+         * @brief Computes the asymmetry factor g by integrating the far-field intensity over the scattering angle.
+         * @param sampling The number of scattering angles sampled uniformly over the full circle.
+         * @return The asymmetry factor g.
+         * @note Validation path for get_g, the trapezoid rule over the periodic amplitudes is exact once
+         * sampling exceeds 2 * max_order.
+         */
+        double get_g_with_angular_integral(const size_t sampling) const;
+
         /**
          * @brief Computes the scattering amplitudes S1 and S2 for a sphere.
          * @param phi A vector of angles in radians at which to compute the scattering amplitudes.
@@ -88,13 +100,14 @@ class Cylinder: public BaseScatterer
         double process_polarization(const complex128 value_0, const complex128 value_1) const;
 
         /**
-         * @brief Computes the dn coefficients for the cylinder.
+         * @brief Computes the logarithmic derivatives D_n(z) = J_n'(z) / J_n(z) for the cylinder.
          * This is based on the formula from Bohren and Huffman, page 205.
-         * @param nmx The maximum order of the coefficients.
+         * @param max_order The highest order needed.
          * @param z The complex argument for the Bessel functions.
-         * @return A vector of dn coefficients.
+         * @param Dn Caller-provided buffer of max_order + 1 elements at least, receives Dn[n] = D_n(z).
+         * @note D_max_order starts from BaseScatterer::get_bessel_ratio and the lower orders follow the downward recurrence.
          */
-        std::vector<complex128> compute_dn(double nmx, complex128 z) const;  // Page 205 of BH
+        static void compute_dn(const size_t max_order, const complex128 z, std::span<complex128> Dn);  // Page 205 of BH
 
 
         /**
@@ -128,6 +128,25 @@ void register_cylinder(pybind11::module_& module) {
                     A list of b2n scattering coefficients for the cylinder. These coefficients describe the scattering behavior of the cylinder in the second mode of the spherical wave expansion.
             )pbdoc"
         )
+        .def("_cpp_get_g_with_angular_integral",
+            &Cylinder::get_g_with_angular_integral,
+            pybind11::arg("sampling") = 1000,
+            R"pbdoc(
+                Computes the asymmetry factor by integrating the far-field intensity over the scattering angle.
+
+                Validation path for the analytic series used by `g`.
+
+                Parameters
+                ----------
+                sampling : int, optional
+                    Number of scattering angles over the full circle. Default is 1000.
+
+                Returns
+                -------
+                float
+                    The asymmetry factor g.
+            )pbdoc"
+        )
     ;
 
 }
@@ -4,6 +4,7 @@
 #include "sphere/interface.cpp"
 #include "coreshell/interface.cpp"
 #include "cylinder/interface.cpp"
+#include <utils/shared_instance_interface.h>
 
 
 
@@ -16,6 +17,9 @@ PYBIND11_MODULE(interface_scatterer, module) {
         This module provides C++ bindings for the PyMieSim Python package, which implements the Lorenz-Mie Theory (LMT) for light scattering by spherical particles and other scatterers.
     )pbdoc";
 
+    share_instance<AngularBasisCache>("PyMieSim::AngularBasisCache");
+    share_instance<SizeParameterTableCache>("PyMieSim::SizeParameterTableCache");
+
     register_base_scatterer(module);
 
     register_sphere(module);
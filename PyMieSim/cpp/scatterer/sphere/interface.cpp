@@ -6,12 +6,13 @@ void register_sphere(pybind11::module_& module) {
 
     pybind11::class_<Sphere, BaseScatterer>(module, "SPHERE")
         .def(
-            pybind11::init<const double, const complex128, const double, const BaseSource&, size_t>(),
+            pybind11::init<const double, const complex128, const double, const BaseSource&, size_t, double>(),
             pybind11::arg("diameter"),
             pybind11::arg("refractive_index"),
             pybind11::arg("medium_refractive_index"),
             pybind11::arg("source"),
             pybind11::arg("max_order") = 0,
+            pybind11::arg("accuracy_target") = 0.0,
             R"pbdoc(
                 Constructor for SPHERE, initializing it with physical and optical properties.
 
@@ -27,10 +28,13 @@ void register_sphere(pybind11::module_& module) {
                     The source of the incident light.
                 max_order : int, optional
                     The maximum order of spherical harmonics to use in the scattering calculation. Default is 0.
+                accuracy_target : float, optional
+                    Largest estimated relative error accepted from the Rayleigh or anomalous-diffraction
+                    approximations when max_order is 0. Default is 0, which always uses the exact Mie series.
             )pbdoc"
         )
         .def_property("an",
-            [](Sphere& self) {return vector_as_numpy_view(self, self.an);},
+            [](Sphere& self) {self.ensure_coefficients(); return vector_as_numpy_view(self, self.an);},
             [](Sphere& self, pybind11::array_t<std::complex<double>, pybind11::array::c_style | pybind11::array::forcecast> arr)
             {
                 vector_assign_from_numpy(self.an, arr);
@@ -55,7 +59,7 @@ void register_sphere(pybind11::module_& module) {
             )pbdoc"
         )
         .def_property("bn",
-            [](Sphere& self) {return vector_as_numpy_view(self, self.bn);},
+            [](Sphere& self) {self.ensure_coefficients(); return vector_as_numpy_view(self, self.bn);},
             [](Sphere& self, pybind11::array_t<std::complex<double>, pybind11::array::c_style | pybind11::array::forcecast> arr)
             {
                 vector_assign_from_numpy(self.bn, arr);
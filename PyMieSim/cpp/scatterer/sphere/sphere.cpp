@@ -1,12 +1,62 @@
 #include "./sphere.h"
 
+namespace {
+    /**
+     * @brief Evaluates the Riccati-Bessel function psi_n(z) = z j_n(z) and its derivative from their power series.
+     * @note Accurate to machine precision for |z| <= 1 in about ten terms.
+     */
+    void get_riccati_bessel_series(const size_t order, const complex128 z, complex128 &psi, complex128 &psi_derivative) {
+        const double n = static_cast<double>(order);
+        const complex128 half_z_squared = -0.5 * z * z;
+
+        complex128 prefactor = z;
+        for (size_t i = 1; i <= order; ++i)
+            prefactor *= z / (2. * i + 1.);
+
+        complex128 term = 1.0, sum = 1.0, derivative_sum = n + 1.;
+        for (size_t k = 1; k < 32 && std::abs(term) > 1e-17; ++k) {
+            term *= half_z_squared / (k * (2. * n + 2. * k + 1.));
+            sum += term;
+            derivative_sum += (n + 1. + 2. * k) * term;
+        }
+
+        psi = prefactor * sum;
+        psi_derivative = prefactor / z * derivative_sum;
+    }
+
+    /**
+     * @brief van de Hulst's K function, K(w) = 1/2 + exp(-w)/w + (exp(-w) - 1)/w^2, with its series near w = 0.
+     */
+    complex128 get_van_de_hulst_kernel(const complex128 w) {
+        if (std::abs(w) > 0.1)
+            return 0.5 + std::exp(-w) / w + (std::exp(-w) - 1.) / (w * w);
+
+        // K(w) = sum_j (-1)^(j+1) (j+1) w^j / (j+2)!
+        complex128 power = w, value = 0.0;
+        double factorial = 6.;
+        for (size_t j = 1; j < 12; ++j) {
+            value += (j % 2 ? 1. : -1.) * (j + 1.) * power / factorial;
+            power *= w;
+            factorial *= j + 3.;
+        }
+        return value;
+    }
+}
+
 
 // ---------------------- Constructors ---------------------------------------
-Sphere::Sphere(const double _diameter, const complex128 _refractive_index, const double _medium_refractive_index, const BaseSource &_source, size_t _max_order)
+Sphere::Sphere(const double _diameter, const complex128 _refractive_index, const double _medium_refractive_index, const BaseSource &_source, size_t _max_order, const double _accuracy_target)
 : BaseScatterer(_max_order, _source, _medium_refractive_index), diameter(_diameter), refractive_index(_refractive_index)
 {
+    this->accuracy_target = _accuracy_target;
     this->compute_cross_section();
     this->compute_size_parameter();
+
+    if (_max_order == 0 && _accuracy_target > 0.0) {
+        this->compute_regime();
+        return;
+    }
+
     this->max_order = (_max_order == 0) ? this->get_wiscombe_criterion(this->size_parameter) : _max_order;
     this->compute_an_bn(this->max_order);
 }
@@ -25,46 +75,163 @@ void Sphere::compute_an_bn(size_t _max_order) {
 
     _max_order = (_max_order == 0 ? this->max_order : _max_order);
 
+    const complex128 m = this->refractive_index / this->medium_refractive_index;
+
+    // Non-absorbing particles take the real instantiation
+    if (m.imag() == 0.0)
+        this->compute_an_bn_kernel<double>(_max_order, m.real());
+    else
+        this->compute_an_bn_kernel<complex128>(_max_order, m);
+}
+
+template<typename index_type>
+void Sphere::compute_an_bn_kernel(const size_t _max_order, const index_type m) {
     an.resize(_max_order);
     bn.resize(_max_order);
 
-    complex128 psi_n, chi_n, psi_1, chi_1, xi_n, xi_nm1,
-        m = this->refractive_index / this->medium_refractive_index,
-        mx = m * size_parameter,
-        derivative_a, derivative_b;
+    const index_type mx = m * size_parameter;
+
+    Workspace::Scope scope;
+    std::span<index_type> Dn = Workspace::allocate<index_type>(_max_order + 1);
+    this->compute_dn(_max_order, mx, Dn);
 
-    size_t nmx = std::max( _max_order, (size_t) std::abs(mx) ) + 16;
+    // psi_n(x) and chi_n(x) do not depend on the index, they are shared by the spheres of an index sweep
+    const std::shared_ptr<const SizeParameterTable> table = get_size_parameter_table(SizeParameterTableKind::RiccatiBessel, size_parameter, _max_order + 1, [&]() {
+        std::vector<std::vector<complex128>> rows(2, std::vector<complex128>(_max_order + 1));
+        rows[0][0] = sin(size_parameter);
+        rows[1][0] = cos(size_parameter);
+
+        for (size_t n = 1; n <= _max_order; ++n) {
+            rows[0][n] = +size_parameter * Spherical_::jn(n, size_parameter);
+            rows[1][n] = -size_parameter * Spherical_::yn(n, size_parameter);
+        }
+        return rows;
+    });
 
-    std::vector<complex128> Dn = this->compute_dn(nmx, mx);
+    const std::vector<complex128> &psi = table->rows[0], &chi = table->rows[1];
 
-    psi_1  = sin(size_parameter);
-    chi_1 = cos(size_parameter);
+    double psi_1 = psi[0].real(), chi_1 = chi[0].real();
 
     for (size_t order = 0; order < _max_order; ++order)
     {
-        // Calculate psi and chi (Riccati-Bessel functions)
+        // Calculate psi and chi (Riccati-Bessel functions), real for a real size parameter
         double nu = order + 1;
 
-        psi_n = +size_parameter * Spherical_::jn(nu, size_parameter);
-        chi_n = -size_parameter * Spherical_::yn(nu, size_parameter);
-
-        // Complex Riccati-Bessel functions
-        xi_n = psi_n - 1.0 * complex128(0, 1) * chi_n;
-        xi_nm1 = psi_1 - 1.0 * complex128(0, 1) * chi_1;
+        const double psi_n = psi[order + 1].real(), chi_n = chi[order + 1].real();
 
         // Derivative of the Riccati-Bessel functions
-        derivative_a = Dn[order + 1] / m + nu / size_parameter;
-        derivative_b = Dn[order + 1] * m + nu / size_parameter;
+        const index_type
+            derivative_a = Dn[order + 1] / m + nu / size_parameter,
+            derivative_b = Dn[order + 1] * m + nu / size_parameter;
+
+        // With xi_n = psi_n - i chi_n: a_n = (D psi_n - psi_(n-1)) / (D xi_n - xi_(n-1)), only the denominator is complex when m is real
+        const index_type
+            numerator_a = derivative_a * psi_n - psi_1,
+            numerator_b = derivative_b * psi_n - psi_1;
 
-        // Computation of the electric and magnetic multipole coefficients
-        an[order] = (derivative_a * psi_n - psi_1) / (derivative_a * xi_n - xi_nm1);
-        bn[order] = (derivative_b * psi_n - psi_1) / (derivative_b * xi_n - xi_nm1);
+        an[order] = numerator_a / (numerator_a - complex128(0, 1) * (derivative_a * chi_n - chi_1));
+        bn[order] = numerator_b / (numerator_b - complex128(0, 1) * (derivative_b * chi_n - chi_1));
 
         psi_1 = psi_n;
         chi_1 = chi_n;
     }
 }
 
+void Sphere::compute_regime() {
+    const complex128 m = this->refractive_index / this->medium_refractive_index;
+
+    if (this->size_parameter * std::max(1.0, std::abs(m)) <= 1.0) {
+        this->max_order = rayleigh_max_order;
+        this->compute_rayleigh_an_bn();
+
+        if (this->get_rayleigh_error_estimate() <= this->accuracy_target) {
+            this->regime = ScatteringRegime::Rayleigh;
+            return;
+        }
+    }
+
+    this->max_order = this->get_wiscombe_criterion(this->size_parameter);
+
+    if (this->size_parameter >= anomalous_diffraction_min_size_parameter && this->get_anomalous_diffraction_error_estimate() <= this->accuracy_target) {
+        this->regime = ScatteringRegime::AnomalousDiffraction;
+        this->an.clear();
+        this->bn.clear();
+        return;
+    }
+
+    this->regime = ScatteringRegime::Mie;
+    this->compute_an_bn(this->max_order);
+}
+
+void Sphere::ensure_coefficients() const {
+    if (this->an.empty())
+        const_cast<Sphere*>(this)->compute_an_bn(this->max_order);
+}
+
+void Sphere::compute_rayleigh_an_bn() {
+    an.resize(rayleigh_max_order);
+    bn.resize(rayleigh_max_order);
+
+    const complex128
+        m = this->refractive_index / this->medium_refractive_index,
+        mx = m * size_parameter,
+        j(0, 1);
+
+    const double x = size_parameter;
+
+    // chi_n(x) = -x y_n(x) by upward recurrence, stable for the real argument
+    double chi_nm1 = std::cos(x), chi_n = std::cos(x) / x + std::sin(x);
+
+    for (size_t order = 1; order <= rayleigh_max_order; ++order) {
+        const double n = static_cast<double>(order);
+        complex128 psi_x, psi_x_derivative, psi_mx, psi_mx_derivative;
+
+        get_riccati_bessel_series(order, x, psi_x, psi_x_derivative);
+        get_riccati_bessel_series(order, mx, psi_mx, psi_mx_derivative);
+
+        const complex128
+            xi = psi_x - j * chi_n,
+            xi_derivative = psi_x_derivative - j * (chi_nm1 - n * chi_n / x);
+
+        an[order - 1] = (m * psi_mx * psi_x_derivative - psi_x * psi_mx_derivative) / (m * psi_mx * xi_derivative - xi * psi_mx_derivative);
+        bn[order - 1] = (psi_mx * psi_x_derivative - m * psi_x * psi_mx_derivative) / (psi_mx * xi_derivative - m * xi * psi_mx_derivative);
+
+        const double chi_np1 = (2. * n + 1.) / x * chi_n - chi_nm1;
+        chi_nm1 = chi_n;
+        chi_n = chi_np1;
+    }
+}
+
+double Sphere::get_rayleigh_error_estimate() const {
+    // Share of the last order in the forward (a + b) and backward (-1)^n (a - b) sums, doubled because
+    // Qforward and Qback square them
+    complex128 forward = 0.0, backward = 0.0, forward_last, backward_last;
+    for (size_t it = 0; it < rayleigh_max_order; ++it) {
+        const double sign = (it % 2) ? 1. : -1.;
+        forward_last = (2. * it + 3.) * (this->an[it] + this->bn[it]);
+        backward_last = sign * (2. * it + 3.) * (this->an[it] - this->bn[it]);
+        forward += forward_last;
+        backward += backward_last;
+    }
+
+    return 2. * std::max(std::abs(forward_last) / std::abs(forward), std::abs(backward_last) / std::abs(backward));
+}
+
+double Sphere::get_anomalous_diffraction_error_estimate() const {
+    const complex128 m = this->refractive_index / this->medium_refractive_index;
+    return std::abs(m - 1.) + 2. * std::pow(this->size_parameter, -2. / 3.);
+}
+
+double Sphere::get_anomalous_diffraction_Qext() const {
+    const complex128 m = this->refractive_index / this->medium_refractive_index;
+    return 4. * std::real(get_van_de_hulst_kernel(complex128(0, -2. * this->size_parameter) * (m - 1.)));
+}
+
+double Sphere::get_anomalous_diffraction_Qabs() const {
+    const double k = std::imag(this->refractive_index / this->medium_refractive_index);
+    return 2. * std::real(get_van_de_hulst_kernel(4. * this->size_parameter * k));
+}
+
 void Sphere::compute_cn_dn(size_t _max_order) {
     _max_order = (_max_order == 0 ? this->max_order : _max_order);
 
@@ -78,46 +245,42 @@ void Sphere::compute_cn_dn(size_t _max_order) {
 
     size_t nmx = std::max( _max_order, (size_t) std::abs(z) ) + 16;
 
-    std::vector<complex128>
-        Cnx = std::vector<complex128>(nmx),
-        Cnn, jnx, jnmx, yx, hx, b1x, y1x, hn1x, ax, ahx, numerator,
-        c_denominator, d_denominator;
-
-    b1x.push_back( +sin(x) / x );
-    y1x.push_back( -cos(x) / x );
+    Workspace::Scope scope;
+    std::span<complex128> Cnx = Workspace::allocate<complex128>(nmx);
 
     for (double i = nmx; i > 1; i--)
         Cnx[i-2] = i - z * z / (Cnx[i - 1] + i);
 
+    // Spherical Bessel functions of the previous order, starting from j_0 and y_0
+    complex128
+        b1x = +sin(x) / x,
+        y1x = -cos(x) / x;
+
     for (size_t order = 0; order < _max_order; order++) {
-        Cnn.push_back(Cnx[order]);
-
-        // jnx.push_back(compute_jn(order + 1, x));
-        // jnmx.push_back(1.0 / (compute_jn(order + 1, z)));
-        // yx.push_back(compute_yn(order + 1, x));
-        // hx.push_back(jnx[order] + complex128(0, 1) * yx[order]);
-
-        jnx.push_back(Spherical_::jn(order + 1, x));
-        jnmx.push_back(1.0 / (Spherical_::jn(order + 1, z)));
-        yx.push_back(Spherical_::yn(order + 1, x));
-        hx.push_back(jnx[order] + complex128(0, 1) * yx[order]);
-
-        b1x.push_back(jnx[order]);
-        y1x.push_back(yx[order]);
-        hn1x.push_back(b1x[order] + complex128(0, 1) * y1x[order]);
-
-        ax.push_back(x * b1x[order] - (complex128)(order + 1.0) * jnx[order]);
-        ahx.push_back(x * hn1x[order] - (complex128)(order + 1.0) * hx[order]);
-
-        numerator.push_back( jnx[order] * ahx[order] - hx[order] * ax[order] );
-        c_denominator.push_back( ahx[order] - hx[order] * Cnn[order] );
-        d_denominator.push_back( m * m * ahx[order] - hx[order] * Cnn[order] );
-        cn[order] = jnmx[order] * numerator[order] / c_denominator[order] ;
-        dn[order] = jnmx[order] * m * numerator[order] / d_denominator[order] ;
+        const complex128
+            jnx = Spherical_::jn(order + 1, x),
+            jnmx = 1.0 / (Spherical_::jn(order + 1, z)),
+            yx = Spherical_::yn(order + 1, x),
+            hx = jnx + complex128(0, 1) * yx,
+            hn1x = b1x + complex128(0, 1) * y1x,
+            ax = x * b1x - (complex128)(order + 1.0) * jnx,
+            ahx = x * hn1x - (complex128)(order + 1.0) * hx,
+            numerator = jnx * ahx - hx * ax,
+            c_denominator = ahx - hx * Cnx[order],
+            d_denominator = m * m * ahx - hx * Cnx[order];
+
+        cn[order] = jnmx * numerator / c_denominator ;
+        dn[order] = jnmx * m * numerator / d_denominator ;
+
+        b1x = jnx;
+        y1x = yx;
     }
 }
 
 double Sphere::get_Qsca() const {
+    if (this->regime == ScatteringRegime::AnomalousDiffraction)
+        return this->get_anomalous_diffraction_Qext() - this->get_anomalous_diffraction_Qabs();
+
     double value = 0;
 
     for(size_t it = 0; it < max_order; ++it){
@@ -128,6 +291,9 @@ double Sphere::get_Qsca() const {
 }
 
 double Sphere::get_Qext() const {
+    if (this->regime == ScatteringRegime::AnomalousDiffraction)
+        return this->get_anomalous_diffraction_Qext();
+
     double value = 0;
     for(size_t it = 0; it < max_order; ++it)
     {
@@ -139,6 +305,7 @@ double Sphere::get_Qext() const {
 }
 
 double Sphere::get_Qback() const {
+    this->ensure_coefficients();
     complex128 value = 0;
 
     for(size_t it = 0; it < max_order-1; ++it)
@@ -153,6 +320,7 @@ double Sphere::get_Qback() const {
 }
 
 double Sphere::get_Qforward() const {
+    this->ensure_coefficients();
     complex128 value = 0;
 
     for(size_t it = 0; it < max_order-1; ++it)
@@ -167,6 +335,7 @@ double Sphere::get_Qforward() const {
 }
 
 double Sphere::get_g() const {
+    this->ensure_coefficients();
     double value = 0;
 
       for(size_t it = 0; it < max_order-1; ++it) {
@@ -175,42 +344,27 @@ double Sphere::get_g() const {
           value += ( n * (n + 2.) / (n + 1.) ) * std::real(this->an[it] * std::conj(this->an[it+1]) + this->bn[it] * std::conj(this->bn[it+1]) );
           value += ( (2. * n + 1. ) / ( n * (n + 1.) ) )  * std::real( this->an[it] * std::conj(this->bn[it]) );
       }
-      return value * 4. / ( get_Qsca() * size_parameter_squared );
+
+      // Normalised by the series Qsca, get_Qsca is approximate in the anomalous-diffraction regime
+      double norm = 0;
+      for(size_t it = 0; it < max_order; ++it)
+          norm += (2. * it + 3.) * ( std::norm(this->an[it]) + std::norm(this->bn[it]) );
+
+      return value * 2. / norm;
 }
 
 
 std::tuple<std::vector<complex128>, std::vector<complex128>>
 Sphere::compute_s1s2(const std::vector<double> &phi) const {
-    std::vector<complex128> S1, S2;
-
-    S1.reserve(phi.size());
-    S2.reserve(phi.size());
-
-    std::vector<double> mu, prefactor = get_prefactor();
-
-    mu.reserve(phi.size());
-
-    for (const double phi : phi)
-        mu.push_back( cos( phi - PI / 2.0 ) );
-
-    for (size_t i = 0; i < phi.size(); i++) {
-        auto [pin, taun] = this->get_pi_tau(mu[i], max_order);
-        complex128 S1_temp = 0., S2_temp = 0.;
-
-        for (size_t m = 0; m < max_order ; m++) {
-            S1_temp += prefactor[m] * ( this->an[m] * pin[m] +  this->bn[m] * taun[m] );
-            S2_temp += prefactor[m] * ( this->an[m] * taun[m] + this->bn[m] * pin[m]  );
-        }
-        S1.push_back(S1_temp);
-        S2.push_back(S2_temp);
-    }
-
-    return std::make_tuple(std::move(S1), std::move(S2));
+    this->ensure_coefficients();
+    return this->compute_spherical_s1s2(phi);
 }
 
 std::vector<complex128>
 Sphere::compute_nearfields(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const std::string& field_type)
 {
+    this->ensure_coefficients();
+
     // Validate that we have cn and dn coefficients
     if (cn.empty() || dn.empty())
         throw std::runtime_error("Near-field computation requires cn and dn coefficients. These are not implemented for cylinder scatterers.");
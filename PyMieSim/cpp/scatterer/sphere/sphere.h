@@ -10,6 +10,8 @@ class Sphere: public BaseScatterer
     public:
         double diameter;
         complex128 refractive_index;
+        static constexpr size_t rayleigh_max_order = 4;  // orders kept by the Rayleigh regime, the last one bounds the error
+        static constexpr double anomalous_diffraction_min_size_parameter = 1000.0;
 
         /**
          * @brief Constructs a Sphere object.
@@ -18,9 +20,11 @@ class Sphere: public BaseScatterer
          * @param medium_refractive_index The refractive index of the medium.
          * @param source The light source.
          * @param max_order The maximum order of the scattering coefficients (default is 0, which means it will be computed).
-         * @param compute_cn_dn Whether to compute the cn and dn coefficients (default is false).
+         * @param accuracy_target Largest estimated relative error accepted from the Rayleigh or anomalous-diffraction
+         * approximations (default is 0, which means the exact Mie series is always used).
+         * @note The regime is only selected automatically when max_order is 0.
          */
-        Sphere(const double diameter, const complex128 refractive_index, const double medium_refractive_index, const BaseSource &source, size_t max_order = 0);
+        Sphere(const double diameter, const complex128 refractive_index, const double medium_refractive_index, const BaseSource &source, size_t max_order = 0, const double accuracy_target = 0.0);
 
         /**
          * @brief Computes the size parameter for the sphere.
@@ -40,12 +44,53 @@ class Sphere: public BaseScatterer
          */
         void compute_an_bn(const size_t max_order = 0) override;
 
+        /**
+         * @brief Computes an and bn for a relative index m of type index_type.
+         * @param max_order The maximum order of the coefficients to compute.
+         * @param m The relative refractive index, double for non-absorbing particles or complex128.
+         * @note The double instantiation runs the D_n recurrence and the numerators in real arithmetic.
+         */
+        template<typename index_type>
+        void compute_an_bn_kernel(const size_t max_order, const index_type m);
+
         /**
          * @brief Computes the coefficients cn and dn for a sphere.
          * @param _max_order The maximum order of the coefficients to compute.
          */
         void compute_cn_dn(const size_t max_order = 0) override;
 
+        /**
+         * @brief Computes the first rayleigh_max_order coefficients an and bn from the power series of the
+         * Riccati-Bessel functions, without the logarithmic-derivative recurrence and the AMOS Bessel calls.
+         * @note Only valid for |m x| <= 1, where the series converge in a few terms.
+         */
+        void compute_rayleigh_an_bn();
+
+        /**
+         * @brief Estimates the relative error of the Rayleigh regime.
+         * @return Twice the largest share of the last kept order in the forward and backward partial-wave sums.
+         * @note Must be called after compute_rayleigh_an_bn. The neglected orders are smaller by about x^2.
+         */
+        double get_rayleigh_error_estimate() const;
+
+        /**
+         * @brief Estimates the relative error of the anomalous-diffraction approximation for Qext and Qabs.
+         * @return The sum of the refractive contrast |m - 1| and the edge term 2 x^(-2/3).
+         */
+        double get_anomalous_diffraction_error_estimate() const;
+
+        /**
+         * @brief Selects the cheapest regime whose error estimate is below accuracy_target and computes the
+         * coefficients it needs.
+         */
+        void compute_regime();
+
+        /**
+         * @brief Computes the coefficients an and bn deferred by the anomalous-diffraction regime.
+         * @note DetectorGroup::get_coupling calls it before sharing the scatterer between threads, so the lazy update is done in place.
+         */
+        void ensure_coefficients() const override;
+
         /**
          * @brief Computes the scattering efficiency Qsca for a sphere.
          * @return The scattering efficiency Qsca.
@@ -58,6 +103,18 @@ class Sphere: public BaseScatterer
          */
         double get_Qext() const override;
 
+        /**
+         * @brief Computes the extinction efficiency with van de Hulst's anomalous-diffraction approximation.
+         * @return Qext = 4 Re K(-2 i x (m - 1)), with K(w) = 1/2 + exp(-w)/w + (exp(-w) - 1)/w^2.
+         */
+        double get_anomalous_diffraction_Qext() const;
+
+        /**
+         * @brief Computes the absorption efficiency with van de Hulst's anomalous-diffraction approximation.
+         * @return Qabs = 2 K(4 x Im(m)).
+         */
+        double get_anomalous_diffraction_Qabs() const;
+
         /**
          * @brief Computes the backscattering efficiency Qback for a sphere.
          * @return The backscattering efficiency Qback.
@@ -82,6 +139,8 @@ class Sphere: public BaseScatterer
          * @return A tuple containing two vectors: S1 and S2, which are the scattering amplitudes.
          */
         std::tuple<std::vector<complex128>, std::vector<complex128>> compute_s1s2(const std::vector<double> &phi) const override;
+        std::tuple<std::vector<complex128>, std::vector<complex128>> compute_mesh_s1s2(const std::vector<double> &phi) const override {this->ensure_coefficients(); return this->compute_cached_spherical_s1s2(phi);}
+        bool has_spherical_amplitudes() const override {return true;}
 
         /**
          * @brief Computes the near-field electromagnetic fields for a sphere.
@@ -0,0 +1,167 @@
+#include "./sphere_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <scatterer/base_scatterer/base_scatterer.h>
+#include <utils/workspace.h>
+
+namespace {
+    constexpr size_t W = sphere_batch_width;
+
+    /**
+     * @brief Evaluates one group of at most W spheres. Lanes past n_lanes repeat the first sphere and are dropped.
+     */
+    void compute_group(
+        const size_t *particles, const size_t n_lanes,
+        const std::vector<double>& size_parameter, const std::vector<complex128>& relative_index,
+        const std::vector<size_t>& orders, SphereEfficiencies& output)
+    {
+        double x[W], inv_x[W], m_re[W], m_im[W], inv_m_re[W], inv_m_im[W], inv_mx_re[W], inv_mx_im[W];
+        size_t N[W];
+        size_t n_max = 0, nmx = 0;
+
+        for (size_t l = 0; l < W; ++l) {
+            const size_t p = particles[l < n_lanes ? l : 0];
+            const complex128 m = relative_index[p], inv_m = 1. / m, inv_mx = inv_m / size_parameter[p];
+            x[l] = size_parameter[p];
+            inv_x[l] = 1. / x[l];
+            m_re[l] = m.real(); m_im[l] = m.imag();
+            inv_m_re[l] = inv_m.real(); inv_m_im[l] = inv_m.imag();
+            inv_mx_re[l] = inv_mx.real(); inv_mx_im[l] = inv_mx.imag();
+            N[l] = orders[p];
+            n_max = std::max(n_max, N[l]);
+            nmx = std::max({nmx, N[l], static_cast<size_t>(std::abs(m * x[l])), static_cast<size_t>(x[l])});
+        }
+        nmx += 16;
+
+        // Logarithmic derivatives D_n(m x) and D_n(x) by downward recurrence, laid out [order][lane]
+        Workspace::Scope scope;
+        std::span<double> D_re = Workspace::allocate<double>(nmx * W), D_im = Workspace::allocate<double>(nmx * W), Dx = Workspace::allocate<double>(nmx * W);
+
+        for (size_t n = nmx - 1; n > 0; --n) {
+            double *D_re_n = &D_re[n * W], *D_im_n = &D_im[n * W], *Dx_n = &Dx[n * W];
+            double *D_re_nm1 = D_re_n - W, *D_im_nm1 = D_im_n - W, *Dx_nm1 = Dx_n - W;
+
+            #pragma omp simd
+            for (size_t l = 0; l < W; ++l) {
+                const double t_re = D_re_n[l] + n * inv_mx_re[l], t_im = D_im_n[l] + n * inv_mx_im[l];
+                const double inv_norm = 1. / (t_re * t_re + t_im * t_im);
+                D_re_nm1[l] = n * inv_mx_re[l] - t_re * inv_norm;
+                D_im_nm1[l] = n * inv_mx_im[l] + t_im * inv_norm;
+                Dx_nm1[l] = n * inv_x[l] - 1. / (Dx_n[l] + n * inv_x[l]);
+            }
+        }
+
+        double psi_1[W], psi_2[W], chi_1[W], chi_2[W];
+        double a_re_1[W], a_im_1[W], b_re_1[W], b_im_1[W];
+        double sca[W], ext[W], back_re[W], back_im[W], forward_re[W], forward_im[W], g_sum[W];
+
+        for (size_t l = 0; l < W; ++l) {
+            psi_1[l] = std::sin(x[l]);  psi_2[l] = std::cos(x[l]);   // psi_0, psi_-1
+            chi_1[l] = std::cos(x[l]);  chi_2[l] = -std::sin(x[l]);  // chi_0, chi_-1
+            a_re_1[l] = a_im_1[l] = b_re_1[l] = b_im_1[l] = 0.0;
+            sca[l] = ext[l] = back_re[l] = back_im[l] = forward_re[l] = forward_im[l] = g_sum[l] = 0.0;
+        }
+
+        for (size_t n = 1; n <= n_max; ++n) {
+            const double nu = static_cast<double>(n), weight = 2. * nu + 1., sign = (n % 2) ? -1. : 1.;
+            const double pair_weight = (nu - 1.) * (nu + 1.) / nu, cross_weight = weight / (nu * (nu + 1.));
+            const double *D_re_n = &D_re[n * W], *D_im_n = &D_im[n * W], *Dx_n = &Dx[n * W];
+
+            #pragma omp simd
+            for (size_t l = 0; l < W; ++l) {
+                // psi_n upward while it oscillates, from psi_(n-1) / psi_n = D_n(x) + n / x beyond
+                const double psi_up = (2. * nu - 1.) * inv_x[l] * psi_1[l] - psi_2[l];
+                const double psi_down = psi_1[l] / (Dx_n[l] + nu * inv_x[l]);
+                const double psi = (nu <= x[l]) ? psi_up : psi_down;
+                const double chi = (2. * nu - 1.) * inv_x[l] * chi_1[l] - chi_2[l];
+
+                // xi_n = psi_n - i chi_n
+                const double da_re = D_re_n[l] * inv_m_re[l] - D_im_n[l] * inv_m_im[l] + nu * inv_x[l];
+                const double da_im = D_re_n[l] * inv_m_im[l] + D_im_n[l] * inv_m_re[l];
+                const double db_re = D_re_n[l] * m_re[l] - D_im_n[l] * m_im[l] + nu * inv_x[l];
+                const double db_im = D_re_n[l] * m_im[l] + D_im_n[l] * m_re[l];
+
+                // a_n = (Da psi_n - psi_(n-1)) / (Da xi_n - xi_(n-1)), same for b_n with Db
+                const double an_num_re = da_re * psi - psi_1[l], an_num_im = da_im * psi;
+                const double an_den_re = da_re * psi + da_im * chi - psi_1[l], an_den_im = da_im * psi - da_re * chi + chi_1[l];
+                const double bn_num_re = db_re * psi - psi_1[l], bn_num_im = db_im * psi;
+                const double bn_den_re = db_re * psi + db_im * chi - psi_1[l], bn_den_im = db_im * psi - db_re * chi + chi_1[l];
+
+                const double an_inv = 1. / (an_den_re * an_den_re + an_den_im * an_den_im);
+                const double bn_inv = 1. / (bn_den_re * bn_den_re + bn_den_im * bn_den_im);
+                const double a_re = (an_num_re * an_den_re + an_num_im * an_den_im) * an_inv;
+                const double a_im = (an_num_im * an_den_re - an_num_re * an_den_im) * an_inv;
+                const double b_re = (bn_num_re * bn_den_re + bn_num_im * bn_den_im) * bn_inv;
+                const double b_im = (bn_num_im * bn_den_re - bn_num_re * bn_den_im) * bn_inv;
+
+                const bool in_sum = n <= N[l], in_truncated_sum = n < N[l];
+
+                sca[l] += in_sum ? weight * (a_re * a_re + a_im * a_im + b_re * b_re + b_im * b_im) : 0.0;
+                ext[l] += in_sum ? weight * (a_re + b_re) : 0.0;
+
+                // Qback, Qforward and the cross term of g stop one order early, as in Sphere
+                back_re[l] += in_truncated_sum ? sign * weight * (a_re - b_re) : 0.0;
+                back_im[l] += in_truncated_sum ? sign * weight * (a_im - b_im) : 0.0;
+                forward_re[l] += in_truncated_sum ? weight * (a_re + b_re) : 0.0;
+                forward_im[l] += in_truncated_sum ? weight * (a_im + b_im) : 0.0;
+                g_sum[l] += in_truncated_sum ? cross_weight * (a_re * b_re + a_im * b_im) : 0.0;
+                g_sum[l] += (in_sum && n > 1) ? pair_weight * (a_re_1[l] * a_re + a_im_1[l] * a_im + b_re_1[l] * b_re + b_im_1[l] * b_im) : 0.0;
+
+                a_re_1[l] = a_re; a_im_1[l] = a_im; b_re_1[l] = b_re; b_im_1[l] = b_im;
+                psi_2[l] = psi_1[l]; psi_1[l] = psi;
+                chi_2[l] = chi_1[l]; chi_1[l] = chi;
+            }
+        }
+
+        for (size_t l = 0; l < n_lanes; ++l) {
+            const size_t p = particles[l];
+            const double inv_x_squared = inv_x[l] * inv_x[l];
+            output.Qsca[p] = 2. * sca[l] * inv_x_squared;
+            output.Qext[p] = 2. * ext[l] * inv_x_squared;
+            output.Qback[p] = (back_re[l] * back_re[l] + back_im[l] * back_im[l]) * inv_x_squared;
+            output.Qforward[p] = (forward_re[l] * forward_re[l] + forward_im[l] * forward_im[l]) * inv_x_squared;
+            output.g[p] = 2. * g_sum[l] / sca[l];
+        }
+    }
+}
+
+
+SphereEfficiencies compute_sphere_efficiencies(
+    const std::vector<double>& size_parameter,
+    const std::vector<complex128>& relative_index,
+    const std::vector<size_t>& max_order)
+{
+    const size_t n_particles = size_parameter.size();
+
+    if (relative_index.size() != n_particles || (!max_order.empty() && max_order.size() != n_particles))
+        throw std::invalid_argument("size_parameter, relative_index and max_order must have the same length.");
+
+    std::vector<size_t> orders(n_particles);
+    for (size_t p = 0; p < n_particles; ++p)
+        orders[p] = (max_order.empty() || max_order[p] == 0) ? BaseScatterer::get_wiscombe_criterion(size_parameter[p]) : max_order[p];
+
+    // Particles of similar order share a group so that few lanes idle in the lockstep recurrence
+    std::vector<size_t> permutation(n_particles);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::stable_sort(permutation.begin(), permutation.end(), [&](size_t i, size_t j) {return orders[i] < orders[j];});
+
+    SphereEfficiencies output;
+    output.Qsca.resize(n_particles);
+    output.Qext.resize(n_particles);
+    output.Qback.resize(n_particles);
+    output.Qforward.resize(n_particles);
+    output.g.resize(n_particles);
+
+    const long long n_groups = static_cast<long long>((n_particles + W - 1) / W);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long group = 0; group < n_groups; ++group) {
+        const size_t start = static_cast<size_t>(group) * W;
+        compute_group(&permutation[start], std::min(W, n_particles - start), size_parameter, relative_index, orders, output);
+    }
+
+    return output;
+}
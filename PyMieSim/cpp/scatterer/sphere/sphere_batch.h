@@ -0,0 +1,38 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+using complex128 = std::complex<double>;
+
+constexpr size_t sphere_batch_width = 8;  // particles per lockstep group
+
+
+/**
+ * @brief Scalar efficiencies of many spheres, stored as one array per quantity.
+ */
+struct SphereEfficiencies {
+    std::vector<double> Qsca;
+    std::vector<double> Qext;
+    std::vector<double> Qback;
+    std::vector<double> Qforward;
+    std::vector<double> g;
+};
+
+
+/**
+ * @brief Computes Qsca, Qext, Qback, Qforward and g for a batch of spheres without building Sphere objects.
+ * @param size_parameter The size parameter of each sphere, in the medium.
+ * @param relative_index The refractive index of each sphere relative to the medium.
+ * @param max_order The number of partial waves of each sphere, empty or 0 uses the Wiscombe criterion as Sphere does.
+ * @return The efficiencies of each sphere, in input order.
+ * @note Spheres are sorted by order and processed in groups of sphere_batch_width, with the order recurrences
+ * run in lockstep over the group so that they vectorise across particles. psi_n and chi_n come from upward
+ * recurrences (psi_n from the downward logarithmic derivative once n > x), so no Bessel routine is called.
+ * The sums follow Sphere::get_Qsca, get_Qext, get_Qback, get_Qforward and get_g term by term.
+ */
+SphereEfficiencies compute_sphere_efficiencies(
+    const std::vector<double>& size_parameter,
+    const std::vector<complex128>& relative_index,
+    const std::vector<size_t>& max_order = {}
+);
@@ -31,9 +31,9 @@ class BaseSet{
         }
 
         // Calculate the multi-dimensional indices for the current index
-        std::vector<size_t> calculate_indices(size_t flat_index) const
+        IndexTuple calculate_indices(size_t flat_index) const
         {
-            std::vector<size_t> indices(shape.size());
+            IndexTuple indices(shape.size());
             for (size_t i = shape.size(); i-- > 0;)
             {
                 indices[i] = flat_index % shape[i];
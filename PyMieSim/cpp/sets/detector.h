@@ -2,6 +2,7 @@
 
 #include "./base_set.h"
 #include "../detector/detector.h"
+#include "../detector/detector_group.h"
 
 
 class DetectorSet : public BaseSet
@@ -17,6 +18,7 @@ class DetectorSet : public BaseSet
         std::vector<double> rotation;
         bool coherent;
         bool mean_coupling;
+        std::string quadrature = "fibonacci";
 
         DetectorSet() = default;
 
@@ -30,10 +32,11 @@ class DetectorSet : public BaseSet
             const std::vector<double> &rotation,
             const bool &coherent,
             const bool &mean_coupling,
-            const bool is_sequential
+            const bool is_sequential,
+            const std::string &quadrature = "fibonacci"
         )
         : BaseSet(is_sequential), mode_numbers(mode_numbers), sampling(sampling), NA(NA), cache_NA(cache_NA), phi_offset(phi_offset), gamma_offset(gamma_offset),
-            polarization_filter(polarization_filter), rotation(rotation), coherent(coherent), mean_coupling(mean_coupling)
+            polarization_filter(polarization_filter), rotation(rotation), coherent(coherent), mean_coupling(mean_coupling), quadrature(quadrature)
             {
             this->is_empty = false;
             this->update_shape();
@@ -54,7 +57,7 @@ class DetectorSet : public BaseSet
         }
 
         Detector get_detector_by_index(long long flat_index) const {
-            std::vector<size_t> indices = this->calculate_indices(flat_index);
+            IndexTuple indices = this->calculate_indices(flat_index);
 
             Detector detector(
                 this->mode_numbers[indices[0]],
@@ -66,7 +69,9 @@ class DetectorSet : public BaseSet
                 this->polarization_filter[indices[6]],
                 this->rotation[indices[7]],
                 this->coherent,
-                this->mean_coupling
+                this->mean_coupling,
+                1.0,
+                this->quadrature
             );
 
             detector.indices = indices;
@@ -98,7 +103,50 @@ class DetectorSet : public BaseSet
                 this->polarization_filter[index],
                 this->rotation[index],
                 this->coherent,
-                this->mean_coupling
+                this->mean_coupling,
+                1.0,
+                this->quadrature
             );
         }
 };
+
+
+class DetectorGroupSet : public BaseSet
+{
+    public:
+        std::vector<DetectorSet> detector_sets;
+
+        DetectorGroupSet() = default;
+
+        DetectorGroupSet(const std::vector<DetectorSet> &detector_sets)
+        : BaseSet(false), detector_sets(detector_sets)
+        {
+            for (const DetectorSet& detector_set : this->detector_sets)
+                if (detector_set.is_sequential)
+                    throw std::invalid_argument("Detector groups do not support sequential detector sets.");
+
+            this->is_empty = this->detector_sets.empty();
+            this->update_shape();
+        }
+
+        void update_shape() override {
+            size_t n_detectors = 0;
+            for (const DetectorSet& detector_set : this->detector_sets)
+                n_detectors += detector_set.total_combinations;
+
+            // The detectors of every set are laid along a single axis, in the order of the sets
+            this->shape = {n_detectors};
+            total_combinations = n_detectors;
+        }
+
+        DetectorGroup get_detector_group() const {
+            std::vector<Detector> detectors;
+            detectors.reserve(this->total_combinations);
+
+            for (const DetectorSet& detector_set : this->detector_sets)
+                for (size_t k = 0; k < detector_set.total_combinations; ++k)
+                    detectors.push_back(detector_set.get_detector_by_index(k));
+
+            return DetectorGroup(std::move(detectors));
+        }
+};
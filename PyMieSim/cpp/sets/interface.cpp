@@ -38,6 +38,8 @@ PYBIND11_MODULE(interface_sets, module) {
             py::arg("medium_properties"),
             py::arg("is_sequential"),
             "Initializes a set of spheres with given diameters, refractive indices, and medium refractive index.")
+        .def_readwrite("accuracy_target", &SphereSet::accuracy_target,
+            "Largest estimated relative error accepted from the Rayleigh or anomalous-diffraction regimes, 0 means exact Mie.")
             ;
 
     // Binding for CYLINDER::Set
@@ -66,7 +68,7 @@ PYBIND11_MODULE(interface_sets, module) {
     py::class_<BaseSourceSet>(module, "CppBaseSourceSet");
 
     py::class_<GaussianSourceSet, BaseSourceSet>(module, "CppGaussianSourceSet")
-        .def(py::init<const std::vector<double>&, const std::vector<std::vector<complex128>>&, const std::vector<double>&, const std::vector<double>&, bool>(),
+        .def(py::init<const std::vector<double>&, const std::vector<JonesVector>&, const std::vector<double>&, const std::vector<double>&, bool>(),
             py::arg("wavelength"),
             py::arg("jones_vector"),
             py::arg("NA"),
@@ -76,7 +78,7 @@ PYBIND11_MODULE(interface_sets, module) {
         ;
 
     py::class_<PlaneWaveSourceSet, BaseSourceSet>(module, "CppPlaneWaveSourceSet")
-        .def(py::init<const std::vector<double>&, const std::vector<std::vector<complex128>>&, const std::vector<double>&, bool>(),
+        .def(py::init<const std::vector<double>&, const std::vector<JonesVector>&, const std::vector<double>&, bool>(),
             py::arg("wavelength"),
             py::arg("jones_vector"),
             py::arg("amplitude"),
@@ -86,7 +88,7 @@ PYBIND11_MODULE(interface_sets, module) {
     // Binding for DETECTOR::Set
     py::class_<DetectorSet>(module, "CppDetectorSet")
         .def(py::init<>())
-        .def(py::init<const std::vector<std::string>&, const std::vector<unsigned>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, bool, bool, bool>(),
+        .def(py::init<const std::vector<std::string>&, const std::vector<unsigned>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, const std::vector<double>&, bool, bool, bool, const std::string&>(),
              py::arg("mode_number"),
              py::arg("sampling"),
              py::arg("NA"),
@@ -98,7 +100,15 @@ PYBIND11_MODULE(interface_sets, module) {
              py::arg("coherent"),
              py::arg("mean_coupling"),
              py::arg("is_sequential"),
-             "Initializes a detector set with scalar fields, numerical aperture, offsets, filters, angle, coherence, and coupling type.");
+             py::arg("quadrature") = "fibonacci",
+             "Initializes a detector set with scalar fields, numerical aperture, offsets, filters, angle, coherence, coupling type and detector mesh.")
+        .def_readonly("total_combinations", &DetectorSet::total_combinations, "Number of detectors spanned by the parameters of the set.");
+
+    // Binding for DETECTOR::GroupSet
+    py::class_<DetectorGroupSet>(module, "CppDetectorGroupSet")
+        .def(py::init<const std::vector<DetectorSet>&>(),
+             py::arg("detector_sets"),
+             "Initializes a group of detectors from detector sets, sharing the far field of each scatterer.");
 }
 
 // -
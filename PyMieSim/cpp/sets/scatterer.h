@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <algorithm>
 #include "properties.h"
 #include "base_set.h"
 #include "../scatterer/base_scatterer/base_scatterer.h"
@@ -19,6 +20,41 @@ public:
     virtual std::unique_ptr<BaseScatterer> get_scatterer_ptr_by_index_sequential(const size_t index, const BaseSource& source) const = 0;
     virtual std::unique_ptr<BaseScatterer> get_scatterer_ptr_by_index(const size_t flat_index, const BaseSource& source) const = 0;
 
+    /**
+     * @brief Returns the flat index of the scatterer visited at the given position of a sweep over the set.
+     * @param position The position in the sweep, in [0, total_combinations).
+     * @return The flat index to pass to get_scatterer_ptr_by_index.
+     * @note The refractive-index axes are visited innermost, so consecutive positions share their size parameter
+     * and the threads reuse their last size-parameter table (see SizeParameterTableCache).
+     */
+    size_t get_sweep_index(size_t position) const {
+        IndexTuple indices(shape.size());
+
+        for (size_t i = shape.size(); i-- > 0;)
+            if (is_index_axis(i)) {
+                indices[i] = position % shape[i];
+                position /= shape[i];
+            }
+
+        for (size_t i = shape.size(); i-- > 0;)
+            if (!is_index_axis(i)) {
+                indices[i] = position % shape[i];
+                position /= shape[i];
+            }
+
+        size_t flat_index = 0;
+        for (size_t i = 0; i < shape.size(); ++i)
+            flat_index = flat_index * shape[i] + indices[i];
+
+        return flat_index;
+    }
+
+protected:
+    std::vector<size_t> index_axes;  // axes of shape holding refractive indices of the scatterer
+
+    bool is_index_axis(const size_t axis) const {
+        return std::find(index_axes.begin(), index_axes.end(), axis) != index_axes.end();
+    }
 };
 
 
@@ -32,12 +68,13 @@ public:
     std::vector<double> diameter;
     ScattererProperties property;
     MediumProperties medium_property;
+    double accuracy_target = 0.0;  // forwarded to each Sphere, 0 means exact Mie
 
     SphereSet() = default;
 
     SphereSet(const std::vector<double>& diameter, const ScattererProperties& property, const MediumProperties& medium_property, const bool is_sequential)
         : ScattererSet(is_sequential), diameter(diameter), property(property), medium_property(medium_property)
-        {this->update_shape();}
+        {this->index_axes = {1}; this->update_shape();}
 
     void update_shape() override {
         this->shape = {
@@ -61,7 +98,9 @@ public:
             this->diameter[index],
             this->property.get(index, source.wavelength_index),
             this->medium_property.get(index, source.wavelength_index),
-            source
+            source,
+            0,
+            this->accuracy_target
         );
     }
 
@@ -70,20 +109,24 @@ public:
             this->diameter[index],
             this->property.get(index, source.wavelength_index),
             this->medium_property.get(index, source.wavelength_index),
-            source
+            source,
+            0,
+            this->accuracy_target
         );
 
         return std::make_unique<Sphere>(scatterer);
     }
 
     Sphere get_scatterer_by_index(const size_t flat_index, const BaseSource& source) const {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         Sphere scatterer(
             this->diameter[indices[0]],
             this->property.get(indices[1], source.wavelength_index),
             this->medium_property.get(indices[2], source.wavelength_index),
-            source
+            source,
+            0,
+            this->accuracy_target
         );
 
         scatterer.indices = indices;
@@ -92,19 +135,56 @@ public:
     }
 
     std::unique_ptr<BaseScatterer> get_scatterer_ptr_by_index(const size_t flat_index, const BaseSource& source) const override {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         Sphere scatterer(
             this->diameter[indices[0]],
             this->property.get(indices[1], source.wavelength_index),
             this->medium_property.get(indices[2], source.wavelength_index),
-            source
+            source,
+            0,
+            this->accuracy_target
         );
 
         scatterer.indices = indices;
 
         return std::make_unique<Sphere>(scatterer);
     }
+
+    /**
+     * @brief Returns the size parameter, relative index and cross section of a sphere without computing its coefficients.
+     * @param diameter The diameter of the sphere.
+     * @param refractive_index The refractive index of the sphere.
+     * @param medium_refractive_index The refractive index of the medium.
+     * @param source The light source.
+     * @return A tuple (size_parameter, relative_index, cross_section), as Sphere computes them.
+     */
+    static std::tuple<double, complex128, double> get_batch_parameters(const double diameter, const complex128 refractive_index, const double medium_refractive_index, const BaseSource& source) {
+        return std::make_tuple(
+            source.wavenumber * diameter / 2 * medium_refractive_index,
+            refractive_index / medium_refractive_index,
+            PI * std::pow(diameter / 2.0, 2)
+        );
+    }
+
+    std::tuple<double, complex128, double> get_batch_parameters_by_index(const size_t flat_index, const BaseSource& source) const {
+        IndexTuple indices = calculate_indices(flat_index);
+        return get_batch_parameters(
+            this->diameter[indices[0]],
+            this->property.get(indices[1], source.wavelength_index),
+            this->medium_property.get(indices[2], source.wavelength_index),
+            source
+        );
+    }
+
+    std::tuple<double, complex128, double> get_batch_parameters_by_index_sequential(const size_t index, const BaseSource& source) const {
+        return get_batch_parameters(
+            this->diameter[index],
+            this->property.get(index, source.wavelength_index),
+            this->medium_property.get(index, source.wavelength_index),
+            source
+        );
+    }
 };
 
 
@@ -118,7 +198,7 @@ public:
     CylinderSet() = default;
     CylinderSet(const std::vector<double>& diameter, const ScattererProperties& property, const MediumProperties& medium_property, const bool is_sequential)
         : ScattererSet(is_sequential), diameter(diameter), property(property), medium_property(medium_property)
-        {this->update_shape();}
+        {this->index_axes = {1}; this->update_shape();}
 
     void update_shape() override {
         this->shape = {
@@ -163,7 +243,7 @@ public:
     }
 
     Cylinder get_scatterer_by_index(const size_t flat_index, const BaseSource& source) const {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         Cylinder scatterer(
             diameter[indices[0]],
@@ -179,7 +259,7 @@ public:
 
 
     std::unique_ptr<BaseScatterer> get_scatterer_ptr_by_index(const size_t flat_index, const BaseSource& source) const override {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         Cylinder scatterer = Cylinder(
             diameter[indices[0]],
@@ -215,7 +295,7 @@ public:
         const MediumProperties& medium_property,
         const bool is_sequential)
         : ScattererSet(is_sequential), core_diameter(core_diameter), shell_thickness(shell_thickness), core_property(core_property), shell_property(shell_property), medium_property(medium_property)
-        {this->update_shape();}
+        {this->index_axes = {2, 3}; this->update_shape();}
 
     void update_shape() override {
         this->shape = {
@@ -230,7 +310,7 @@ public:
     }
 
     CoreShell get_scatterer_by_index(const size_t flat_index, const BaseSource& source) const {
-        std::vector<size_t> indices = this->calculate_indices(flat_index);
+        IndexTuple indices = this->calculate_indices(flat_index);
 
         CoreShell scatterer(
             core_diameter[indices[0]],
@@ -247,7 +327,7 @@ public:
     }
 
     std::unique_ptr<BaseScatterer> get_scatterer_ptr_by_index(const size_t flat_index, const BaseSource& source) const override {
-        std::vector<size_t> indices = this->calculate_indices(flat_index);
+        IndexTuple indices = this->calculate_indices(flat_index);
 
         CoreShell scatterer(
             core_diameter[indices[0]],
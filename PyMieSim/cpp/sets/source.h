@@ -9,7 +9,7 @@ using complex128 = std::complex<double>;
 class BaseSourceSet : public BaseSet{  // Abstract Class for Sources
 public:
     std::vector<double> wavelength;
-    std::vector<std::vector<complex128>> jones_vector;
+    std::vector<JonesVector> jones_vector;
     std::vector<double> numerical_aperture;
     std::vector<double> optical_power;
     std::vector<double> amplitude;
@@ -32,7 +32,7 @@ public:
 
     GaussianSourceSet(
         const std::vector<double>& wavelength,
-        const std::vector<std::vector<complex128>>& jones_vector,
+        const std::vector<JonesVector>& jones_vector,
         const std::vector<double>& numerical_aperture,
         const std::vector<double>& optical_power,
         const bool is_sequential)
@@ -49,7 +49,7 @@ public:
 
 
     BaseSource get_source_by_index(const size_t flat_index) const override {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         BaseSource source = Gaussian(
             this->wavelength[indices[0]],
@@ -91,7 +91,7 @@ public:
     PlaneWaveSourceSet() = default;
 
     PlaneWaveSourceSet(const std::vector<double>& wavelength,
-        const std::vector<std::vector<complex128>>& jones_vector,
+        const std::vector<JonesVector>& jones_vector,
         const std::vector<double>& amplitude,
         const bool is_sequential)
     {
@@ -105,7 +105,7 @@ public:
     }
 
     BaseSource get_source_by_index(const size_t flat_index) const override {
-        std::vector<size_t> indices = calculate_indices(flat_index);
+        IndexTuple indices = calculate_indices(flat_index);
 
         BaseSource source = Planewave(
             this->wavelength[indices[0]],
@@ -13,7 +13,7 @@ PYBIND11_MODULE(interface_source, module) {
 
     py::class_<Planewave, BaseSource>(module, "PLANEWAVE")
         .def(
-            py::init<double, std::vector<complex128>, double>(),
+            py::init<double, const JonesVector&, double>(),
             py::arg("wavelength"),
             py::arg("jones_vector"),
             py::arg("amplitude"),
@@ -24,7 +24,7 @@ PYBIND11_MODULE(interface_source, module) {
 
     py::class_<Gaussian, BaseSource>(module, "GAUSSIAN")
         .def(
-            py::init<double, std::vector<complex128>, double, double>(),
+            py::init<double, const JonesVector&, double, double>(),
             py::arg("wavelength"),
             py::arg("jones_vector"),
             py::arg("NA"),
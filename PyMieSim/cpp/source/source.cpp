@@ -3,7 +3,7 @@
 
 // ---------------------- BaseSource Implementation ---------------------------------------
 
-BaseSource::BaseSource(double _wavelength, std::vector<complex128> _jones_vector, double _amplitude)
+BaseSource::BaseSource(double _wavelength, const JonesVector& _jones_vector, double _amplitude)
 : wavelength(_wavelength), jones_vector(_jones_vector), amplitude(_amplitude)
 {
     update_derived_quantities();
@@ -24,13 +24,13 @@ void BaseSource::update_derived_quantities() {
 
 // ---------------------- Planewave Implementation ---------------------------------------
 
-Planewave::Planewave(double _wavelength, std::vector<complex128> _jones_vector, double _amplitude)
+Planewave::Planewave(double _wavelength, const JonesVector& _jones_vector, double _amplitude)
 : BaseSource(_wavelength, _jones_vector, _amplitude)
 {}
 
 // ---------------------- Gaussian Implementation ---------------------------------------
 
-Gaussian::Gaussian(double _wavelength, std::vector<complex128> _jones_vector, double _NA, double _optical_power)
+Gaussian::Gaussian(double _wavelength, const JonesVector& _jones_vector, double _NA, double _optical_power)
 : BaseSource(_wavelength, _jones_vector, compute_amplitude_from_power(_wavelength, _NA, _optical_power)),
   NA(_NA), optical_power(_optical_power)
 {}
@@ -1,27 +1,30 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <complex>
 #include <cmath> // For std::isnan
+#include <utils/index_tuple.h>
 
 #define PI (double)3.14159265358979323846264338
 #define EPSILON0 (double)8.854187817620389e-12
 #define C_ (double)299792458.0
 typedef std::complex<double> complex128;
+typedef std::array<complex128, 2> JonesVector;  // [Ex, Ey]
 
 
 class BaseSource {
     public:
         double wavelength;
-        std::vector<complex128> jones_vector;
+        JonesVector jones_vector;
         double amplitude;
         double wavenumber;
         double angular_frequency;
-        std::vector<size_t> indices;
+        IndexTuple indices;
         size_t wavelength_index;
 
     BaseSource() = default;
-    BaseSource(double wavelength, std::vector<complex128> jones_vector, double amplitude);
+    BaseSource(double wavelength, const JonesVector& jones_vector, double amplitude);
 
     protected:
         /**
@@ -65,7 +68,7 @@ class Planewave: public BaseSource {
          * @param jones_vector Polarization state as Jones vector [Ex, Ey].
          * @param amplitude Electric field amplitude.
          */
-        Planewave(double wavelength, std::vector<complex128> jones_vector, double amplitude);
+        Planewave(double wavelength, const JonesVector& jones_vector, double amplitude);
     };
 
 class Gaussian: public BaseSource {
@@ -83,7 +86,7 @@ class Gaussian: public BaseSource {
          * @param NA Numerical aperture of the Gaussian beam.
          * @param optical_power Optical power in watts.
          */
-        Gaussian(double wavelength, std::vector<complex128> jones_vector, double NA, double optical_power);
+        Gaussian(double wavelength, const JonesVector& jones_vector, double NA, double optical_power);
 
         /**
          * @brief Computes the electric field amplitude from optical power.
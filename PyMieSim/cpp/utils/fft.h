@@ -0,0 +1,59 @@
+#pragma once
+
+#include <complex>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utils/workspace.h>
+
+
+// smallest power of two greater than or equal to n
+inline size_t next_power_of_two(const size_t n) {
+    size_t output = 1;
+    while (output < n)
+        output <<= 1;
+
+    return output;
+}
+
+// in-place iterative radix-2 FFT: data[k] <- sum_j data[j] exp(sign * 2 pi i j k / n), unnormalized, n a power of two
+inline void fft_radix2(const std::span<std::complex<double>> data, const int sign) {
+    const size_t n = data.size();
+
+    if (n == 0 || (n & (n - 1)) != 0)
+        throw std::invalid_argument("FFT size must be a power of two.");
+
+    // bit-reversal permutation
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    constexpr double pi = 3.14159265358979323846264338;
+
+    // twiddles of the largest stage, computed directly to avoid accumulating rounding errors
+    Workspace::Scope scope;
+    std::span<std::complex<double>> twiddle = Workspace::allocate<std::complex<double>>(n / 2);
+    for (size_t k = 0; k < n / 2; ++k) {
+        const double angle = sign * 2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+        twiddle[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    for (size_t length = 2; length <= n; length <<= 1) {
+        const size_t half = length / 2, stride = n / length;
+
+        for (size_t start = 0; start < n; start += length)
+            for (size_t k = 0; k < half; ++k) {
+                const std::complex<double> u = data[start + k];
+                const std::complex<double> v = data[start + k + half] * twiddle[k * stride];
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+    }
+}
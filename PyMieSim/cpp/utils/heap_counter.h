@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <optional>
+
+
+/**
+ * @brief Counter of the heap allocations made through the global operator new, for the tests of the workspace.
+ *
+ * Allocations are only counted in builds configured with PYMIESIM_COUNT_HEAP_ALLOCATIONS=ON, where this header
+ * replaces the global operator new and delete of the binary including it. It must then be included by a single
+ * translation unit of each Python module, and counts the allocations of the C++ code linked into that module.
+ */
+class HeapCounter {
+    public:
+        inline static std::atomic<size_t> allocations{0};
+
+        /**
+         * @brief Returns the number of heap allocations since start-up, or nothing if they are not counted.
+         */
+        static std::optional<size_t> get_allocations() {
+#ifdef PYMIESIM_COUNT_HEAP_ALLOCATIONS
+            return allocations.load(std::memory_order_relaxed);
+#else
+            return std::nullopt;
+#endif
+        }
+};
+
+
+#ifdef PYMIESIM_COUNT_HEAP_ALLOCATIONS
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // the replacements below allocate with malloc on purpose
+#endif
+
+// The aligned and nothrow forms provided by the standard library forward to these or pair with themselves
+void* operator new(std::size_t size) {
+    HeapCounter::allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {return ::operator new(size);}
+void operator delete(void* pointer) noexcept {std::free(pointer);}
+void operator delete[](void* pointer) noexcept {std::free(pointer);}
+void operator delete(void* pointer, std::size_t) noexcept {std::free(pointer);}
+void operator delete[](void* pointer, std::size_t) noexcept {std::free(pointer);}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * @brief Multi-dimensional index of an element within a set, stored inline.
+ *
+ * Sources, scatterers and detectors carry their position in the parameter grid of their set. Keeping it
+ * in fixed storage makes building and copying them in the experiment loop free of heap allocation.
+ */
+class IndexTuple {
+    public:
+        static constexpr size_t capacity = 8;  // largest number of axes of a set (DetectorSet)
+
+        IndexTuple() = default;
+
+        /**
+         * @brief Constructs a tuple of size zero-initialised indices.
+         * @param size The number of axes, at most capacity.
+         */
+        explicit IndexTuple(const size_t size) : count(size) {
+            if (size > capacity)
+                throw std::length_error("IndexTuple holds at most " + std::to_string(capacity) + " axes, " + std::to_string(size) + " requested.");
+        }
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        size_t& operator[](const size_t axis) { return values[axis]; }
+        const size_t& operator[](const size_t axis) const { return values[axis]; }
+
+        const size_t* begin() const { return values.data(); }
+        const size_t* end() const { return values.data() + count; }
+
+    private:
+        std::array<size_t, capacity> values{};
+        size_t count = 0;
+};
@@ -1,5 +1,11 @@
+#pragma once
+
+#include <cmath>
 #include <cstddef>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+#include <algorithm>
 
 // trapz over uniformly spaced samples: y[0..n-1], spacing dx
 inline double trapz(std::vector<double> y, double dx) {
@@ -30,3 +36,78 @@ inline double trapz(std::vector<double> x, std::vector<double> y) {
 
     return s;
 }
+
+// cubic Lagrange interpolation of uniformly spaced samples y[0..n-1] (first abscissa x0, spacing dx) at x, n >= 4
+template <typename T>
+inline T interpolate_cubic(const std::vector<T>& y, const double x0, const double dx, const double x) {
+    const double u = (x - x0) / dx;
+    const long long last = static_cast<long long>(y.size()) - 4;
+
+    // stencil [i - 1, i + 2] around the interval containing x, shifted inwards at the edges
+    const long long i = std::clamp(static_cast<long long>(u) - 1, 0LL, last);
+    const double t = u - static_cast<double>(i);  // position relative to y[i], in [0, 3]
+
+    const double
+        w0 = -(t - 1.) * (t - 2.) * (t - 3.) / 6.,
+        w1 = t * (t - 2.) * (t - 3.) / 2.,
+        w2 = -t * (t - 1.) * (t - 3.) / 2.,
+        w3 = t * (t - 1.) * (t - 2.) / 6.;
+
+    return w0 * y[i] + w1 * y[i + 1] + w2 * y[i + 2] + w3 * y[i + 3];
+}
+
+// Gauss-Legendre rule of n points on [a, b] as (nodes, weights), exact for polynomials of degree 2n - 1
+inline std::pair<std::vector<double>, std::vector<double>> get_gauss_legendre_rule(const size_t n, const double a, const double b) {
+    std::vector<double> nodes(n), weights(n);
+    const double half_length = 0.5 * (b - a), center = 0.5 * (a + b);
+
+    // Roots of P_n by Newton iteration from the asymptotic estimate, the rule being symmetric about 0
+    for (size_t i = 0; i < (n + 1) / 2; ++i) {
+        double x = std::cos(3.14159265358979323846 * (i + 0.75) / (n + 0.5)), derivative = 1.0;
+
+        for (size_t iteration = 0; iteration < 100; ++iteration) {
+            double p_previous = 1.0, p_current = x;  // P_0, P_1
+            for (size_t k = 2; k <= n; ++k) {
+                const double p_next = ((2. * k - 1.) * x * p_current - (k - 1.) * p_previous) / k;
+                p_previous = p_current;
+                p_current = p_next;
+            }
+
+            derivative = n * (x * p_current - p_previous) / (x * x - 1.);
+            const double step = p_current / derivative;
+            x -= step;
+
+            if (std::abs(step) <= 1e-15)
+                break;
+        }
+
+        const double weight = 2. / ((1. - x * x) * derivative * derivative);
+
+        nodes[i] = center + half_length * x;
+        nodes[n - 1 - i] = center - half_length * x;
+        weights[i] = weights[n - 1 - i] = half_length * weight;
+    }
+
+    return std::make_pair(std::move(nodes), std::move(weights));
+}
+
+// Fejer's second rule on [a, b] as (nodes, weights): the n - 1 Chebyshev nodes cos(k pi / n) without the end points.
+// The nodes of n are among those of 2 n, so that the rules of doubling n are nested.
+inline std::pair<std::vector<double>, std::vector<double>> get_fejer_rule(const size_t n, const double a, const double b) {
+    const size_t n_nodes = (n > 1) ? n - 1 : 0;
+    std::vector<double> nodes(n_nodes), weights(n_nodes);
+    const double half_length = 0.5 * (b - a), center = 0.5 * (a + b);
+
+    for (size_t k = 1; k < n; ++k) {
+        const double theta = 3.14159265358979323846 * k / n;
+
+        double sum = 0.0;
+        for (size_t j = 1; j <= n / 2; ++j)
+            sum += std::sin((2. * j - 1.) * theta) / (2. * j - 1.);
+
+        nodes[k - 1] = center + half_length * std::cos(theta);
+        weights[k - 1] = half_length * 4. / n * std::sin(theta) * sum;
+    }
+
+    return std::make_pair(std::move(nodes), std::move(weights));
+}
@@ -61,6 +61,27 @@ template <class Owner, class dtype> inline pybind11::array_t<dtype> vector_as_nu
 }
 
 
+/*
+    @brief Creates a read-only zero-copy NumPy array view of a const std::vector.
+    @tparam Owner The type of the owner object that manages the lifetime of the vector.
+    @tparam dtype The data type of the elements in the vector and NumPy array.
+    @param owner The owner object that manages the lifetime of the vector.
+    @param vector The std::vector to be viewed as a NumPy array.
+    @return A non-writeable NumPy array that is a zero-copy view of the input vector.
+    @note Used for data shared between several objects, which must be replaced through a setter rather than modified in place.
+*/
+template <class Owner, class dtype> inline pybind11::array_t<dtype> vector_as_numpy_view(
+    Owner& owner,
+    const std::vector<dtype>& vector
+) {
+    const int64_t n = static_cast<int64_t>(vector.size());
+    const int64_t stride = static_cast<int64_t>(sizeof(dtype));
+
+    pybind11::array_t<dtype> array({n}, {stride}, vector.data(), pybind11::cast(&owner));
+    pybind11::detail::array_proxy(array.ptr())->flags &= ~pybind11::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return array;
+}
+
 /*
     @brief Assigns data from a NumPy array to a std::vector.
     @tparam dtype The data type of the elements in the vector and NumPy array.
@@ -0,0 +1,41 @@
+#pragma once
+
+
+/**
+ * @brief Process-wide instance of T, shared by every Python module linking the code that uses it.
+ *
+ * The C++ libraries are linked statically into each Python module, so each module holds its own copy of their
+ * static objects. The modules call share_instance (utils/shared_instance_interface.h) on import: the first one
+ * registers its instance and the following ones point at it. Outside Python, get returns the instance of the
+ * current binary.
+ * @note T declares SharedInstance<T> a friend when its constructor is private.
+ */
+template <typename T>
+class SharedInstance {
+    public:
+        /**
+         * @brief Returns the instance used by this binary.
+         */
+        static T& get() {return *get_pointer();}
+
+        /**
+         * @brief Returns the instance owned by this binary, whether or not it is the one in use.
+         */
+        static T& get_local() {
+            static T instance;
+            return instance;
+        }
+
+        /**
+         * @brief Makes this binary use the given instance from now on.
+         * @param instance The instance, owned by another module and living until the end of the process.
+         * @note Called on import, before any computation of the module.
+         */
+        static void set(T& instance) {get_pointer() = &instance;}
+
+    private:
+        static T*& get_pointer() {
+            static T* pointer = &get_local();
+            return pointer;
+        }
+};
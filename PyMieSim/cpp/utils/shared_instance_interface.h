@@ -0,0 +1,21 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <utils/shared_instance.h>
+
+
+/**
+ * @brief Shares the instance of T between the Python modules, to be called on import of every module using it.
+ * @param name Key of the instance in the data pybind11 shares between modules.
+ * @note The first module imported registers its own instance, the following ones use it.
+ */
+template <typename T>
+void share_instance(const char* name)
+{
+    void* instance = pybind11::get_shared_data(name);
+
+    if (instance == nullptr)
+        instance = pybind11::set_shared_data(name, &SharedInstance<T>::get_local());
+
+    SharedInstance<T>::set(*static_cast<T*>(instance));
+}
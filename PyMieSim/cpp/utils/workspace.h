@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+
+/**
+ * @brief Per-thread bump allocator for the scratch buffers of scatterer evaluations.
+ *
+ * Buffers are carved out of blocks owned by the calling thread and released in stack order by
+ * Workspace::Scope. Once the blocks have grown to the largest evaluation seen, the loop over the
+ * points of an experiment takes its scratch memory without touching the heap. Blocks are only
+ * returned to the system when the thread exits.
+ */
+class Workspace {
+    public:
+        static constexpr size_t alignment = 64;          // bytes, one cache line
+        static constexpr size_t min_block_size = 1 << 16; // bytes
+
+        struct Statistics {
+            size_t block_allocations;  // blocks allocated by all the threads since start-up
+            size_t reserved_bytes;     // bytes held by the blocks of all the threads
+        };
+
+        /**
+         * @brief Marks the current position of this thread's workspace and rewinds to it on destruction,
+         * releasing every buffer allocated in between.
+         */
+        class Scope {
+            public:
+                Scope() : workspace(Workspace::get_thread_instance()), block(workspace.current_block), offset(workspace.offset) {}
+                ~Scope() { workspace.current_block = block; workspace.offset = offset; }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                Workspace& workspace;
+                size_t block;
+                size_t offset;
+        };
+
+        /**
+         * @brief Returns the workspace of the calling thread.
+         */
+        static Workspace& get_thread_instance() {
+            thread_local Workspace workspace;
+            return workspace;
+        }
+
+        /**
+         * @brief Takes a buffer from the calling thread's workspace.
+         * @param size The number of elements.
+         * @param value The value every element is initialised to.
+         * @return A span valid until the innermost enclosing Scope is destroyed.
+         */
+        template<typename T>
+        static std::span<T> allocate(const size_t size, const T& value = T()) {
+            static_assert(std::is_trivially_destructible_v<T>, "Workspace buffers are released without destruction.");
+
+            T* data = static_cast<T*>(get_thread_instance().take(size * sizeof(T)));
+            std::uninitialized_fill_n(data, size, value);
+            return std::span<T>(data, size);
+        }
+
+        /**
+         * @brief Returns the block counters summed over all the threads.
+         * @note Only the blocks of the workspaces are counted, see HeapCounter (utils/heap_counter.h) for every heap allocation.
+         */
+        static Statistics get_statistics() {
+            return Statistics{total_block_allocations.load(), total_reserved_bytes.load()};
+        }
+
+        ~Workspace() {
+            for (const Block& block : blocks)
+                total_reserved_bytes -= block.size;
+        }
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        std::vector<Block> blocks;
+        size_t current_block = 0;
+        size_t offset = 0;
+
+        inline static std::atomic<size_t> total_block_allocations{0};
+        inline static std::atomic<size_t> total_reserved_bytes{0};
+
+        Workspace() = default;
+
+        void* take(const size_t bytes) {
+            for (;; ++current_block, offset = 0) {
+                if (current_block == blocks.size()) {
+                    // No block left with enough room, the next one at least doubles the reservation
+                    const size_t size = std::max({bytes + alignment, min_block_size, blocks.empty() ? size_t(0) : 2 * blocks.back().size});
+                    blocks.push_back(Block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+                    total_block_allocations += 1;
+                    total_reserved_bytes += size;
+                }
+
+                std::byte* base = blocks[current_block].data.get();
+                const size_t misalignment = reinterpret_cast<std::uintptr_t>(base + offset) % alignment;
+                const size_t start = offset + (misalignment == 0 ? 0 : alignment - misalignment);
+
+                if (start + bytes <= blocks[current_block].size) {
+                    offset = start + bytes;
+                    return base + start;
+                }
+            }
+        }
+};
@@ -1,2 +1,3 @@
 from .photodiode import Photodiode
 from .coherent_mode import CoherentMode
+from .group import DetectorGroup
@@ -36,6 +36,8 @@ class BaseDetector:
         The sampling rate of the detector. If not specified, defaults to 200.
     polarization_filter : Optional[Angle]
         The polarization filter angle (in degrees). Defaults to NaN if not provided.
+    quadrature : str
+        The mesh of the detectors, 'fibonacci' (default) or 'gauss_legendre'.
 
     Methods
     -------
@@ -160,6 +162,7 @@ class BaseDetector:
             "is_sequential": self.is_sequential,
             "coherent": self.coherent,
             "mean_coupling": self.mean_coupling,
+            "quadrature": self.quadrature,
         }
 
         self.set = CppDetectorSet(
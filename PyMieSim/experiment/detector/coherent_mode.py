@@ -39,6 +39,8 @@ class CoherentMode(BaseDetector, Sequential):
         Whether mean coupling is used. Defaults to False.
     coherent : bool
         Specifies if the detection is coherent. Defaults to True.
+    quadrature : str
+        Mesh of the detectors, 'fibonacci' (default) or 'gauss_legendre'.
     """
 
     mode_number: Union[List[str], str]
@@ -52,3 +54,4 @@ class CoherentMode(BaseDetector, Sequential):
     cache_NA: Dimensionless = (0.0,) * ureg.AU
     sampling: Optional[Dimensionless] = (200,) * ureg.AU
     polarization_filter: Optional[Angle] = (numpy.nan,) * ureg.degree
+    quadrature: str = "fibonacci"
@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+from pydantic.dataclasses import dataclass
+from typing import List, Union, Optional
+
+from PyMieSim.binary.interface_sets import CppDetectorGroupSet
+from PyMieSim.experiment.detector.photodiode import Photodiode
+from PyMieSim.experiment.detector.coherent_mode import CoherentMode
+from PyMieSim.utils import config_dict
+
+
+@dataclass(config=config_dict)
+class DetectorGroup:
+    """
+    Group of detectors collecting the light scattered by the same particles, such as the forward scatter, side scatter
+    and ring of photodiodes of an angle-resolved instrument.
+
+    The far field of each scatterer is evaluated once, on the union of the meshes of the detectors, and all the couplings
+    are returned together. The detectors of the group are laid along a single axis of the results, each member adding
+    one entry per combination of its own parameters. Only the coupling can be measured with a group.
+
+    Parameters
+    ----------
+    detectors : List[Union[Photodiode, CoherentMode]]
+        The detectors of the group, which cannot be sequential.
+    names : Optional[List[str]]
+        One name per detector, labelling the results. Defaults to the position of the detectors in the group.
+    """
+
+    detectors: List[Union[Photodiode, CoherentMode]]
+    names: Optional[List[str]] = None
+
+    def __post_init__(self):
+        if self.names is not None and len(self.names) != len(self.detectors):
+            raise ValueError(f"Expected one name per detector, got {len(self.names)} names for {len(self.detectors)} detectors.")
+
+    def _generate_binding(self) -> None:
+        """
+        Initializes the C++ binding of every detector and groups their sets.
+        """
+        for detector in self.detectors:
+            detector._generate_binding()
+
+        self.set = CppDetectorGroupSet(detector_sets=[detector.set for detector in self.detectors])
+
+    def _generate_mapping(self) -> None:
+        """
+        Labels the detector axis of the results with the name of each detector, followed by the index of the
+        combination of its parameters when it holds more than one.
+        """
+        names = self.names if self.names is not None else [str(index) for index in range(len(self.detectors))]
+
+        labels = []
+        for name, detector in zip(names, self.detectors):
+            n_combinations = detector.set.total_combinations
+
+            labels.extend([name] if n_combinations == 1 else [f"{name}:{index}" for index in range(n_combinations)])
+
+        self.mapping = {"detector:group": labels}
@@ -37,6 +37,8 @@ class Photodiode(BaseDetector, Sequential):
         Indicates if the detection is coherent. Defaults to False.
     mode_number : str
         Mode number of the detector. Defaults to 'NC00'.
+    quadrature : str
+        Mesh of the detectors, 'fibonacci' (default) or 'gauss_legendre'.
     """
 
     NA: Dimensionless
@@ -49,6 +51,7 @@ class Photodiode(BaseDetector, Sequential):
     polarization_filter: Optional[Angle | None] = (numpy.nan,) * ureg.degree
     mode_number: Tuple[str] = field(default_factory=lambda: ["NC00"], init=True)
     rotation: Angle = field(default=(0,) * ureg.degree, init=True)
+    quadrature: str = "fibonacci"
 
     coherent: bool = field(default=False, init=False)
     mean_coupling: bool = field(default=False, init=False)
@@ -31,12 +31,17 @@ class Sphere(BaseScatterer, Sequential):
         Refractive index or indices of the spherical scatterers themselves.
     medium_property : List, optional
         BaseMaterial(s) defining the medium, used if `medium_index` is not provided.
+    accuracy_target : float, optional
+        Largest estimated relative error accepted from the Rayleigh or anomalous-diffraction approximations.
+        Default is 0, which always uses the exact Mie series. The "regime" measure reports the regime used
+        for each point (0: Mie, 1: Rayleigh, 2: anomalous diffraction).
     """
 
     source: BaseSource
     diameter: Length
     property: List[BaseMaterial] | List[RefractiveIndex]
     medium_property: List[BaseMaterial] | List[RefractiveIndex]
+    accuracy_target: float = 0.0
 
     available_measure_list = [
         "Qsca",
@@ -60,6 +65,7 @@ class Sphere(BaseScatterer, Sequential):
         "b2",
         "b3",
         "g",
+        "regime",
         "coupling",
     ]
 
@@ -95,3 +101,5 @@ class Sphere(BaseScatterer, Sequential):
                 for k, v in self.binding_kwargs.items()
             }
         )
+
+        self.set.accuracy_target = self.accuracy_target
@@ -9,7 +9,7 @@ from TypedUnit import ureg
 
 from PyMieSim.binary.interface_experiment import EXPERIMENT
 from PyMieSim.experiment.scatterer import Sphere, Cylinder, CoreShell
-from PyMieSim.experiment.detector import Photodiode, CoherentMode
+from PyMieSim.experiment.detector import Photodiode, CoherentMode, DetectorGroup
 from PyMieSim.experiment.source import Gaussian, PlaneWave
 from PyMieSim.experiment.dataframe_subclass import PyMieSimDataFrame
 from PyMieSim.binary.interface_sets import CppDetectorSet
@@ -39,8 +39,9 @@ class Setup(EXPERIMENT):
         Configuration for the scatterer in the experiment. Defines the physical properties of the particle being studied.
     source : Union[Gaussian, PlaneWave]
         Configuration for the light source. Specifies the characteristics of the light (e.g., wavelength, polarization) illuminating the scatterer.
-    detector : Union[Photodiode, CoherentMode, None], optional
-        Configuration for the detector, if any. Details the method of detection for scattered light, including positional and analytical parameters. Defaults to None.
+    detector : Union[Photodiode, CoherentMode, DetectorGroup, None], optional
+        Configuration for the detector, if any. Details the method of detection for scattered light, including positional and analytical parameters.
+        A DetectorGroup evaluates the far field of each scatterer once for all its detectors, and only measures the coupling. Defaults to None.
 
     Methods provide functionality for initializing bindings, generating parameter tables for visualization,
     and executing the simulation to compute and retrieve specified measures.
@@ -48,7 +49,7 @@ class Setup(EXPERIMENT):
 
     scatterer: Union[Sphere, Cylinder, CoreShell]
     source: Union[Gaussian, PlaneWave]
-    detector: Optional[Union[Photodiode, CoherentMode]] = EmptyDetector()
+    detector: Optional[Union[Photodiode, CoherentMode, DetectorGroup]] = EmptyDetector()
 
     def __post_init__(self):
         """
@@ -96,6 +97,37 @@ class Setup(EXPERIMENT):
             detector_set=self.detector.set,
         )
 
+    def get_adaptive_coupling(self, tolerance: float, max_sampling: int = 100_000) -> tuple:
+        """
+        Computes the coupling on detector meshes refined until it converges, the `sampling` of the detector being ignored.
+        Each point of the sweep stops refining as soon as its own coupling has converged.
+
+        Parameters
+        ----------
+        tolerance : float
+            Relative change of the coupling between two refinements below which it is considered converged.
+        max_sampling : int
+            Largest number of mesh points. Default is 100000.
+
+        Returns
+        -------
+        tuple of numpy.ndarray
+            The couplings in watts, their relative error estimates and the number of mesh points used.
+        """
+        assert (
+            not isinstance(self.detector, EmptyDetector)
+        ), "To compute the coupling power the detector has to be provided to Setup class"
+
+        coupling, error, sampling = self._get_adaptive_coupling(
+            scatterer_set=self.scatterer.set,
+            source_set=self.source.set,
+            detector_set=self.detector.set,
+            tolerance=tolerance,
+            max_sampling=max_sampling,
+        )
+
+        return coupling.squeeze() * ureg.watt, error.squeeze(), sampling.squeeze()
+
     def get(
         self,
         *measures,
@@ -132,6 +164,10 @@ class Setup(EXPERIMENT):
                 self.detector is not None
             ), "To compute the coupling power the detector has to be provided to Setup class"
 
+        if isinstance(self.detector, DetectorGroup) and measures != {"coupling"}:
+            unsupported = sorted(measures - {"coupling"})
+            raise ValueError(f"A DetectorGroup only measures the coupling, got {unsupported}. Use a single detector for the other measures.")
+
         if as_numpy:
             return self._get_measure_array(measures)
 
@@ -67,6 +67,34 @@ class BaseDetector:
         """
         return self._cpp_get_coupling(scatterer) * ureg.watt
 
+    def get_adaptive_coupling(self, scatterer: BaseScatterer, tolerance: float, max_sampling: int = 100_000) -> tuple:
+        r"""
+        Compute the coupling on detector meshes refined until it converges, instead of the mesh of `sampling` points.
+
+        The meshes are nested, each level doubling the rings and the points per ring so that the far field already
+        computed is reused. The refinement stops once the coupling changes by less than `tolerance`, or before the
+        mesh would exceed `max_sampling` points.
+
+        Parameters
+        ----------
+        scatterer : BaseScatterer
+            The scatterer object that interacts with the incident light, producing the scattered field.
+        tolerance : float
+            Relative change of the coupling between two refinements below which it is considered converged.
+        max_sampling : int
+            Largest number of mesh points. Default is 100000.
+
+        Returns
+        -------
+        tuple
+            The coupling in watts, its relative error estimate and the number of mesh points used. The error is
+            above `tolerance` when the refinement was capped, zero when the coupling is integrated exactly and
+            `nan` for the mean coherent coupling, which depends on the sampling and is computed on the detector mesh.
+        """
+        coupling, error, sampling = self._cpp_get_adaptive_coupling(scatterer, tolerance=tolerance, max_sampling=max_sampling)
+
+        return coupling * ureg.watt, error, sampling
+
     def get_footprint(self, scatterer: BaseScatterer) -> Footprint:
         r"""
         Generate the footprint of the scattered light coupling with the detector.
@@ -50,6 +50,9 @@ class CoherentMode(DETECTOR, BaseDetector):
         The refractive index of the medium in which the detector operates. This is important for
         determining the acceptance cone of light.
         Default is 1.0 (vacuum or air).
+    quadrature : str
+        Mesh over which the far field is integrated: 'fibonacci' (default), the golden spiral where every point covers
+        the same solid angle, or 'gauss_legendre', a product rule that converges with far fewer points for smooth fields.
     """
 
     mode_number: str
@@ -62,6 +65,7 @@ class CoherentMode(DETECTOR, BaseDetector):
     mean_coupling: bool = False
     rotation: Angle = 90 * ureg.degree
     medium_refractive_index: RefractiveIndex = 1.0 * ureg.RIU
+    quadrature: str = "fibonacci"
 
     def __post_init__(self):
         """
@@ -92,6 +96,7 @@ class CoherentMode(DETECTOR, BaseDetector):
             is_coherent=True,
             mean_coupling=self.mean_coupling,
             medium_refractive_index=self.medium_refractive_index.to(ureg.RIU).magnitude,
+            quadrature=self.quadrature,
         )
 
 
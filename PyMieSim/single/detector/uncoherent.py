@@ -38,6 +38,9 @@ class Photodiode(DETECTOR, BaseDetector):
         The refractive index of the medium in which the detector operates. This is important for
         determining the acceptance cone of light.
         Default is 1.0 (vacuum or air).
+    quadrature : str
+        Mesh over which the far field is integrated: 'fibonacci' (default), the golden spiral where every point covers
+        the same solid angle, or 'gauss_legendre', a product rule that converges with far fewer points for smooth fields.
     """
 
     NA: Dimensionless
@@ -48,6 +51,7 @@ class Photodiode(DETECTOR, BaseDetector):
     cache_NA: Optional[Dimensionless] = 0 * ureg.AU
     mean_coupling: bool = False
     medium_refractive_index: RefractiveIndex = 1.0 * ureg.RIU
+    quadrature: str = "fibonacci"
 
     def __post_init__(self):
         """
@@ -65,6 +69,7 @@ class Photodiode(DETECTOR, BaseDetector):
             rotation=0,
             is_coherent=False,
             medium_refractive_index=self.medium_refractive_index.to(ureg.RIU).magnitude,
+            quadrature=self.quadrature,
         )
 
 
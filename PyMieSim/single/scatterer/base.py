@@ -24,6 +24,11 @@ class BaseScatterer:
         table = tabulate(property_dict, headers="keys")
         print(table)
 
+    @property
+    def regime(self) -> str:
+        """Returns the regime used to evaluate the scatterer: 'mie', 'rayleigh' or 'anomalous_diffraction'."""
+        return ("mie", "rayleigh", "anomalous_diffraction")[self._cpp_regime]
+
     @property
     def size_parameter(self) -> Dimensionless:
         """Returns the size parameter of the scatterer."""
@@ -28,12 +28,17 @@ class Sphere(SPHERE, BaseScatterer):
         Defines either the refractive index (`Quantity`) or material (`BaseMaterial`) of the surrounding medium. Only one can be provided.
     source : BaseSource
         The source object associated with the scatterer.
+    accuracy_target : float, optional
+        Largest estimated relative error accepted from the Rayleigh (x << 1) or anomalous-diffraction (x >= 1000,
+        extinction-type quantities only) approximations. Default is 0, which always uses the exact Mie series.
+        The regime actually used is reported by `regime`.
     """
 
     diameter: Length
     property: RefractiveIndex | BaseMaterial
     medium_property: RefractiveIndex | BaseMaterial
     source: BaseSource
+    accuracy_target: float = 0.0
 
     property_names = [
         "size_parameter",
@@ -69,6 +74,7 @@ class Sphere(SPHERE, BaseScatterer):
             refractive_index=self.index.to(ureg.RIU).magnitude,
             medium_refractive_index=self.medium_index.to(ureg.RIU).magnitude,
             source=self.source,
+            accuracy_target=self.accuracy_target,
         )
 
     @property
@@ -0,0 +1,53 @@
+"""
+Benchmark: fast Legendre transform crossover
+============================================
+
+Times the direct and the fast Legendre transform evaluations of S1 and S2 for
+large spheres over a range of angle counts, and prints where the fast path
+starts paying off. The automatic selection in ``compute_spherical_s1s2`` uses
+the fast path for max_order >= 512 and at least max_order / 2 angles.
+"""
+
+# %%
+# Importing the package dependencies: numpy, PyMieSim
+import timeit
+import numpy as np
+from TypedUnit import ureg
+
+from PyMieSim.single.scatterer import Sphere
+from PyMieSim.single.source import PlaneWave
+
+source = PlaneWave(
+    wavelength=1000 * ureg.nanometer,
+    polarization=0 * ureg.degree,
+    amplitude=1 * ureg.volt / ureg.meter,
+)
+
+for diameter in [30, 300, 3000] * ureg.micrometer:
+    scatterer = Sphere(
+        diameter=diameter,
+        property=(1.33 + 1e-6j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    max_order = scatterer.an.size
+    crossover = None
+
+    for sampling in [100, 300, 1_000, 3_000, 10_000, 30_000, 100_000]:
+        phi = np.linspace(-np.pi / 2, np.pi / 2, sampling)
+
+        timing = {
+            method: min(timeit.repeat(lambda: scatterer._cpp_get_spherical_s1s2(phi=phi, method=method), number=1, repeat=3))
+            for method in ['direct', 'fast']
+        }
+
+        if crossover is None and timing['fast'] < timing['direct']:
+            crossover = sampling
+
+        print(
+            f"size parameter: {scatterer.size_parameter.magnitude:8.1f}  max order: {max_order:6d}  sampling: {sampling:7d}  "
+            f"direct: {timing['direct'] * 1e3:9.2f} ms  fast: {timing['fast'] * 1e3:9.2f} ms"
+        )
+
+    print(f"--> fast path faster from {crossover} angles (max_order / 2 = {max_order // 2})\n")
@@ -0,0 +1,66 @@
+"""
+Benchmark: Gauss-Legendre and Fibonacci detector meshes
+=======================================================
+
+Compares the convergence of the coupling of an offset detector with the
+number of mesh points, for the Fibonacci spiral and the Gauss-Legendre
+product rule, along with the time of a coupling evaluation. The reference
+is the product rule on 40 000 points.
+"""
+
+# %%
+# Importing the package dependencies: numpy, PyMieSim
+import timeit
+from TypedUnit import ureg
+
+from PyMieSim.single.scatterer import Sphere, Cylinder
+from PyMieSim.single.source import PlaneWave
+from PyMieSim.single.detector import CoherentMode, Photodiode
+
+source = PlaneWave(
+    wavelength=1000 * ureg.nanometer,
+    polarization=40 * ureg.degree,
+    amplitude=1 * ureg.volt / ureg.meter,
+)
+
+
+def get_detector(mode_number, sampling, quadrature):
+    if mode_number == 'NC00':
+        return Photodiode(NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree, sampling=sampling, quadrature=quadrature)
+
+    return CoherentMode(
+        mode_number=mode_number,
+        NA=0.5 * ureg.AU,
+        gamma_offset=10 * ureg.degree,
+        phi_offset=20 * ureg.degree,
+        rotation=0 * ureg.degree,
+        sampling=sampling,
+        quadrature=quadrature,
+    )
+
+
+for scatterer_type in [Sphere, Cylinder]:
+    for diameter in [2, 10] * ureg.micrometer:
+        scatterer = scatterer_type(
+            diameter=diameter,
+            property=(1.5 + 0.01j) * ureg.RIU,
+            medium_property=1.0 * ureg.RIU,
+            source=source,
+        )
+
+        for mode_number in ['NC00', 'LP11', 'LG11']:
+            reference = get_detector(mode_number, 40_000, 'gauss_legendre').get_coupling(scatterer)
+
+            print(f"{scatterer_type.__name__}  diameter: {diameter:~P}  mode: {mode_number}")
+
+            for sampling in [100, 300, 1_000, 3_000, 10_000]:
+                line = f"    sampling: {sampling:6d}"
+
+                for quadrature in ['fibonacci', 'gauss_legendre']:
+                    detector = get_detector(mode_number, sampling, quadrature)
+                    error = abs((detector.get_coupling(scatterer) / reference).to(ureg.AU).magnitude - 1)
+                    duration = min(timeit.repeat(lambda: detector.get_coupling(scatterer), number=1, repeat=5))
+
+                    line += f"  {quadrature}: error {error:8.2e} time {duration * 1e3:6.2f} ms"
+
+                print(line)
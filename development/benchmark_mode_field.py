@@ -0,0 +1,39 @@
+"""
+Benchmark: Mode field sampling
+==============================
+
+Times the construction of coherent detectors on large meshes, dominated by
+the sampling of their mode field. The geometry cache is cleared before each
+construction so that the mode field is evaluated every time.
+"""
+
+# %%
+# Importing the package dependencies: PyMieSim
+import timeit
+from TypedUnit import ureg
+
+from PyMieSim.single.detector import CoherentMode
+from PyMieSim.binary.interface_detector import DETECTOR
+
+sampling = 200_000
+repetitions = 5
+
+
+def build_detector(mode_number):
+    DETECTOR.clear_geometry_cache()
+    return CoherentMode(
+        mode_number=mode_number,
+        NA=0.9 * ureg.AU,
+        gamma_offset=0 * ureg.degree,
+        phi_offset=0 * ureg.degree,
+        sampling=sampling,
+        rotation=0 * ureg.degree,
+        mean_coupling=False,
+    )
+
+
+# %%
+# Timing the construction of each mode
+for mode_number in ['LP01', 'LP11', 'LP21', 'LP13', 'LP54', 'HG32', 'LG31']:
+    duration = timeit.timeit(lambda: build_detector(mode_number), number=repetitions) / repetitions
+    print(f"{mode_number}: {duration * 1e3:.1f} ms for {sampling} points")
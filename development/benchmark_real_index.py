@@ -0,0 +1,47 @@
+"""
+Benchmark: real versus complex refractive index
+===============================================
+
+Times the construction of ``single.scatterer.Sphere`` and ``single.scatterer.CoreShell``
+over an index sweep, for a purely real index and for the same index with a vanishing
+imaginary part. Non-absorbing particles take the real instantiation of the coefficient
+kernels, which runs the logarithmic-derivative recurrences in real arithmetic and, for
+core-shell particles, replaces the AMOS calls of the shell by Riccati-Bessel recurrences.
+"""
+
+# %%
+# Importing the package dependencies: numpy, PyMieSim
+import timeit
+import numpy as np
+from TypedUnit import ureg
+
+from PyMieSim import single
+
+source = single.source.PlaneWave(wavelength=1000 * ureg.nanometer, polarization=0 * ureg.degree, amplitude=1 * ureg.volt / ureg.meter)
+indices = np.linspace(1.35, 1.65, 200)
+
+
+def sweep_sphere(imaginary: float):
+    for diameter in [1, 5, 20] * ureg.micrometer:
+        for index in indices:
+            single.scatterer.Sphere(diameter=diameter, property=(index + imaginary) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)._cpp_Qsca
+
+
+def sweep_coreshell(imaginary: float):
+    for diameter in [1, 5] * ureg.micrometer:
+        for index in indices:
+            single.scatterer.CoreShell(
+                core_diameter=diameter,
+                shell_thickness=diameter / 5,
+                core_property=(index + imaginary) * ureg.RIU,
+                shell_property=1.45 * ureg.RIU,
+                medium_property=1.33 * ureg.RIU,
+                source=source
+            )._cpp_Qsca
+
+
+for name, sweep in [('Sphere', sweep_sphere), ('CoreShell', sweep_coreshell)]:
+    real = min(timeit.repeat(lambda: sweep(0.0), number=1, repeat=3))
+    complex_ = min(timeit.repeat(lambda: sweep(1e-12j), number=1, repeat=3))
+
+    print(f"{name:10s} real index: {real * 1e3:8.1f} ms  complex index: {complex_ * 1e3:8.1f} ms  speedup: {complex_ / real:5.2f}")
@@ -0,0 +1,40 @@
+"""
+Benchmark: S1/S2 angular kernel
+===============================
+
+Times the evaluation of the S1 and S2 scattering amplitudes of spheres on
+10^4 to 10^6 angles, for a small and a large size parameter.
+"""
+
+# %%
+# Importing the package dependencies: numpy, PyMieSim
+import timeit
+import numpy as np
+from TypedUnit import ureg
+
+from PyMieSim.single.scatterer import Sphere
+from PyMieSim.single.source import PlaneWave
+
+source = PlaneWave(
+    wavelength=1000 * ureg.nanometer,
+    polarization=0 * ureg.degree,
+    amplitude=1 * ureg.volt / ureg.meter,
+)
+
+for diameter in [1, 10] * ureg.micrometer:
+    scatterer = Sphere(
+        diameter=diameter,
+        property=(1.5 + 0.001j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    for sampling in [10_000, 100_000, 1_000_000]:
+        phi = np.linspace(-np.pi / 2, np.pi / 2, sampling)
+
+        duration = min(timeit.repeat(lambda: scatterer._cpp_get_s1s2(phi=phi), number=1, repeat=5))
+
+        print(
+            f"diameter: {diameter:~P}  size parameter: {scatterer.size_parameter.magnitude:6.1f}  "
+            f"sampling: {sampling:8d}  time: {duration * 1e3:8.2f} ms"
+        )
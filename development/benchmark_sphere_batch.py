@@ -0,0 +1,40 @@
+"""
+Benchmark: batched sphere efficiencies
+======================================
+
+Times ``Setup.get`` for scalar sphere measures, which goes through the batched
+structure-of-arrays kernel, against building one ``single.scatterer.Sphere``
+per diameter. Scalar efficiencies of spheres (Q*, C* and g) use the batch
+kernel unless a regime ``accuracy_target`` is set on the scatterer.
+"""
+
+# %%
+# Importing the package dependencies: numpy, PyMieSim
+import timeit
+import numpy as np
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+wavelength = 1000 * ureg.nanometer
+
+for n_diameter in [100, 1_000, 10_000]:
+    diameters = np.geomspace(10, 10_000, n_diameter) * ureg.nanometer
+
+    source = experiment.source.PlaneWave(wavelength=wavelength, polarization=0 * ureg.degree, amplitude=1 * ureg.volt / ureg.meter)
+    scatterer = experiment.scatterer.Sphere(diameter=diameters, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source)
+    setup = Setup(scatterer=scatterer, source=source)
+
+    batch = min(timeit.repeat(lambda: setup.get('Qsca', 'Qext', 'g', as_numpy=True), number=1, repeat=3))
+
+    single_source = single.source.PlaneWave(wavelength=wavelength, polarization=0 * ureg.degree, amplitude=1 * ureg.volt / ureg.meter)
+
+    def per_sphere():
+        for diameter in diameters[:100]:
+            sphere = single.scatterer.Sphere(diameter=diameter, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=single_source)
+            sphere._cpp_Qsca, sphere._cpp_Qext, sphere._cpp_g
+
+    objects = min(timeit.repeat(per_sphere, number=1, repeat=3)) * n_diameter / 100
+
+    print(f"spheres: {n_diameter:6d}  batched: {batch * 1e3:9.2f} ms  one object per sphere (extrapolated): {objects * 1e3:9.2f} ms")
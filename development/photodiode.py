@@ -1,3 +1,4 @@
+import numpy
 from TypedUnit import ureg
 
 from PyMieSim.single.detector import CoherentMode
@@ -14,7 +15,10 @@ detector = CoherentMode(
 # print(detector._cpp_mesh.spherical.phi.shape)
 
 
-detector._cpp_scalar_field[:200] *= 0
+# The samples are shared by identical detectors, they are replaced rather than modified in place
+scalar_field = numpy.array(detector._cpp_scalar_field)
+scalar_field[:200] = 0
+detector._cpp_scalar_field = scalar_field
 
 
 field = detector.get_structured_scalarfield(sampling=10)
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+
+source = single.source.Gaussian(wavelength=1000 * ureg.nanometer, polarization=40 * ureg.degree, optical_power=1 * ureg.watt, NA=0.3 * ureg.AU)
+
+scatterers = [
+    single.scatterer.Sphere(diameter=4000 * ureg.nanometer, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source),
+    single.scatterer.Cylinder(diameter=4000 * ureg.nanometer, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source),
+]
+
+# Detector classes with their parameters, the sampling being set by each test
+detectors = [
+    (single.detector.CoherentMode, dict(
+        mode_number='LP11', NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree,
+        rotation=10 * ureg.degree, mean_coupling=False, quadrature='gauss_legendre'
+    )),
+    (single.detector.CoherentMode, dict(
+        mode_number='LG11', NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree,
+        rotation=10 * ureg.degree, mean_coupling=False, quadrature='gauss_legendre'
+    )),
+    (single.detector.Photodiode, dict(
+        NA=0.5 * ureg.AU, gamma_offset=20 * ureg.degree, phi_offset=10 * ureg.degree, quadrature='gauss_legendre'
+    )),
+]
+
+
+@pytest.mark.parametrize('detector_class, parameters', detectors, ids=['LP11', 'LG11', 'Photodiode'])
+@pytest.mark.parametrize('scatterer', scatterers, ids=[f"Scatterer:{s.__class__.__name__}" for s in scatterers])
+def test_adaptive_coupling_converges(scatterer, detector_class, parameters):
+    reference = detector_class(**parameters, sampling=60000).get_coupling(scatterer).to(ureg.watt).magnitude
+
+    coupling, error, sampling = detector_class(**parameters, sampling=500).get_adaptive_coupling(scatterer, tolerance=1e-4)
+
+    assert error <= 1e-4, "The refinement should stop once the coupling has converged."
+    assert sampling <= 100_000, "The refinement should not exceed the largest mesh."
+    assert numpy.isclose(coupling.to(ureg.watt).magnitude, reference, rtol=1e-3, atol=0), "The adaptive coupling should match a dense mesh."
+
+
+def test_adaptive_coupling_is_capped():
+    detector_class, parameters = detectors[0]
+
+    coupling, error, sampling = detector_class(**parameters, sampling=500).get_adaptive_coupling(scatterers[1], tolerance=1e-12, max_sampling=3000)
+
+    assert sampling <= 3000, "The refinement should stop before exceeding the largest mesh."
+    assert error > 1e-12, "A capped refinement should report an error above the tolerance."
+
+
+def test_coupling_tolerance_switches_get_coupling():
+    scatterer = scatterers[0]
+    detector_class, parameters = detectors[0]
+    detector = detector_class(**parameters, sampling=500)
+
+    coupling, _, _ = detector.get_adaptive_coupling(scatterer, tolerance=1e-6)
+
+    detector.coupling_tolerance = 1e-6
+    assert detector.get_coupling(scatterer) == coupling, "A positive coupling tolerance should make get_coupling adaptive."
+
+
+def test_mean_coupling_uses_detector_mesh():
+    scatterer = scatterers[0]
+    detector = single.detector.CoherentMode(
+        mode_number='LP01', NA=0.5 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=0 * ureg.degree, sampling=500, mean_coupling=True
+    )
+
+    coupling, error, sampling = detector.get_adaptive_coupling(scatterer, tolerance=1e-6)
+
+    assert numpy.isnan(error) and sampling == 500, "The mean coupling depends on the sampling and should not be refined."
+    assert coupling == detector.get_coupling(scatterer)
+
+
+def test_sweep_points_stop_independently():
+    diameters = numpy.geomspace(200, 8000, 6) * ureg.nanometer
+
+    experiment_source = experiment.source.Gaussian(
+        wavelength=1000 * ureg.nanometer, polarization=40 * ureg.degree, optical_power=1 * ureg.watt, NA=0.3 * ureg.AU
+    )
+    scatterer = experiment.scatterer.Sphere(diameter=diameters, property=1.5 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=experiment_source)
+    detector = experiment.detector.CoherentMode(
+        mode_number='LP11', NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree,
+        rotation=10 * ureg.degree, sampling=500 * ureg.AU, mean_coupling=False,
+    )
+
+    setup = Setup(scatterer=scatterer, source=experiment_source, detector=detector)
+    coupling, error, sampling = setup.get_adaptive_coupling(tolerance=1e-4)
+
+    assert numpy.all(error <= 1e-4), "Every point of the sweep should converge."
+    assert sampling[0] < sampling[-1], "Small particles should converge on coarser meshes than large ones."
+
+    single_detector = single.detector.CoherentMode(
+        mode_number='LP11', NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree,
+        rotation=10 * ureg.degree, sampling=500, mean_coupling=False,
+    )
+    for diameter, value in zip(diameters, coupling.to(ureg.watt).magnitude):
+        single_scatterer = single.scatterer.Sphere(diameter=diameter, property=1.5 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+        reference, _, _ = single_detector.get_adaptive_coupling(single_scatterer, tolerance=1e-4)
+
+        assert numpy.isclose(value, reference.to(ureg.watt).magnitude, rtol=1e-12, atol=0), "The sweep should match the single detector."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single
+from PyMieSim.binary.interface_experiment import EXPERIMENT
+from PyMieSim.experiment.scatterer import Sphere, CoreShell
+from PyMieSim.experiment.source import Gaussian
+from PyMieSim.experiment.detector import Photodiode
+from PyMieSim.experiment import Setup
+
+
+@pytest.fixture
+def source():
+    return Gaussian(
+        wavelength=numpy.linspace(600, 1000, 5) * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        optical_power=1e-3 * ureg.watt,
+        NA=0.2 * ureg.AU,
+    )
+
+
+@pytest.fixture
+def detector():
+    return Photodiode(
+        NA=0.4 * ureg.AU,
+        phi_offset=[0, 45] * ureg.degree,
+        gamma_offset=0 * ureg.degree,
+        sampling=500 * ureg.AU,
+        polarization_filter=None,
+    )
+
+
+def get_sphere(source):
+    return Sphere(
+        diameter=numpy.linspace(100, 8000, 20) * ureg.nanometer,
+        property=(1.5 + 0.01j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+
+def get_coreshell(source):
+    return CoreShell(
+        core_diameter=numpy.linspace(100, 3000, 10) * ureg.nanometer,
+        shell_thickness=200 * ureg.nanometer,
+        core_property=1.6 * ureg.RIU,
+        shell_property=(1.4 + 0.1j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+
+@pytest.mark.parametrize('get_scatterer', [get_sphere, get_coreshell], ids=['sphere', 'coreshell'])
+def test_angular_basis_cache_coupling(get_scatterer, source, detector):
+    setup = Setup(scatterer=get_scatterer(source), source=source, detector=detector)
+
+    EXPERIMENT.set_angular_basis_cache(enabled=False)
+    reference = setup.get('coupling', add_units=False).values.squeeze()
+
+    try:
+        EXPERIMENT.set_angular_basis_cache(enabled=True)
+        cached = setup.get('coupling', add_units=False).values.squeeze()
+    finally:
+        EXPERIMENT.set_angular_basis_cache(enabled=False)
+
+    # The cached tables hold the values of the recurrence, the couplings are bit-identical
+    assert numpy.array_equal(cached, reference), "Mismatch between cached and direct angular functions."
+
+
+def test_angular_basis_cache_single_detector():
+    source = single.source.Gaussian(wavelength=1000 * ureg.nanometer, polarization=0 * ureg.degree, optical_power=1e-3 * ureg.watt, NA=0.2 * ureg.AU)
+    scatterer = single.scatterer.Sphere(diameter=3000 * ureg.nanometer, property=1.5 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+    detector = single.detector.CoherentMode(
+        mode_number='LP11', NA=0.3 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=0 * ureg.degree,
+        rotation=0 * ureg.degree, sampling=500 * ureg.AU, mean_coupling=False
+    )
+
+    EXPERIMENT.set_angular_basis_cache(enabled=False)
+    reference = detector.get_coupling(scatterer)
+
+    try:
+        # The cache configured through EXPERIMENT is the one the single detectors use
+        EXPERIMENT.set_angular_basis_cache(enabled=True)
+        first = detector.get_coupling(scatterer)
+        second = detector.get_coupling(scatterer)
+        statistics = EXPERIMENT.get_angular_basis_cache_statistics()
+    finally:
+        EXPERIMENT.set_angular_basis_cache(enabled=False)
+
+    assert statistics['misses'] == 1 and statistics['hits'] == 1, "The single detector should build the table once and reuse it."
+    assert first == reference and second == reference, "Mismatch between cached and direct angular functions."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
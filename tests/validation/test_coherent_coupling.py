@@ -0,0 +1,144 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+EPSILON0 = 8.854187817620389e-12
+LIGHT_SPEED = 299792458.0
+
+
+def get_mesh_coupling(detector, scatterer, mean_coupling=False):
+    """Coherent coupling summed over the detector mesh from the projected far fields, as done before the coherent weights."""
+    mesh = detector._cpp_mesh
+    S2_field, S1_field = scatterer._cpp_get_farfields(phi=mesh.spherical.phi, theta=mesh.spherical.theta, distance=1.0)
+    scalar_field = numpy.asarray(detector._cpp_scalar_field)
+
+    horizontal = scalar_field * (S1_field * mesh.horizontal_to_perpendicular + S2_field * mesh.horizontal_to_parallel)
+    vertical = scalar_field * (S1_field * mesh.vertical_to_perpendicular + S2_field * mesh.vertical_to_parallel)
+
+    if mean_coupling:
+        coupling = numpy.sum(abs(horizontal) ** 2) + numpy.sum(abs(vertical) ** 2)
+        return 0.5 * EPSILON0 * LIGHT_SPEED * coupling * mesh._cpp_d_omega / mesh._cpp_omega
+
+    coupling = abs(numpy.sum(horizontal)) ** 2 + abs(numpy.sum(vertical)) ** 2
+    return 0.5 * EPSILON0 * LIGHT_SPEED * coupling * mesh._cpp_d_omega
+
+
+@pytest.mark.parametrize('polarization', [0, 50] * ureg.degree, ids=['horizontal', 'oblique'])
+@pytest.mark.parametrize('mode_number', ['LP01', 'LP11', 'HG12'])
+@pytest.mark.parametrize('scatterer_type', ['sphere', 'coreshell'])
+def test_coherent_weights_match_mesh(scatterer_type, mode_number, polarization):
+    source = single.source.Gaussian(
+        wavelength=800 * ureg.nanometer,
+        polarization=polarization,
+        optical_power=1 * ureg.watt,
+        NA=0.3 * ureg.AU,
+    )
+
+    detector = single.detector.CoherentMode(
+        mode_number=mode_number,
+        NA=0.6 * ureg.AU,
+        gamma_offset=10 * ureg.degree,
+        phi_offset=30 * ureg.degree,
+        sampling=2000,
+        rotation=20 * ureg.degree,
+        mean_coupling=False,
+    )
+
+    for diameter in [200, 3000, 12000] * ureg.nanometer:
+        if scatterer_type == 'sphere':
+            scatterer = single.scatterer.Sphere(diameter=diameter, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source)
+        else:
+            scatterer = single.scatterer.CoreShell(
+                core_diameter=diameter, shell_thickness=100 * ureg.nanometer, core_property=1.5 * ureg.RIU,
+                shell_property=(1.6 + 0.02j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source
+            )
+
+        coupling = detector.get_coupling(scatterer).to(ureg.watt).magnitude
+        reference = get_mesh_coupling(detector, scatterer)
+
+        assert numpy.isclose(coupling, reference, rtol=1e-9, atol=0), f"Mismatch between weighted and mesh coherent coupling for {diameter}."
+
+
+@pytest.mark.parametrize('mean_coupling', [False, True], ids=['point', 'mean'])
+@pytest.mark.parametrize('mode_number', ['LP11', 'LG11'], ids=['real_mode', 'complex_mode'])
+@pytest.mark.parametrize('scatterer_type', ['sphere', 'cylinder'])
+def test_fused_mesh_coupling_matches_mesh(scatterer_type, mode_number, mean_coupling):
+    source = single.source.Gaussian(
+        wavelength=1000 * ureg.nanometer,
+        polarization=40 * ureg.degree,
+        optical_power=1 * ureg.watt,
+        NA=0.3 * ureg.AU,
+    )
+
+    detector = single.detector.CoherentMode(
+        mode_number=mode_number,
+        NA=0.5 * ureg.AU,
+        gamma_offset=5 * ureg.degree,
+        phi_offset=20 * ureg.degree,
+        sampling=1500,
+        rotation=10 * ureg.degree,
+        mean_coupling=mean_coupling,
+    )
+
+    for diameter in [300, 2000] * ureg.nanometer:
+        if scatterer_type == 'sphere':
+            scatterer = single.scatterer.Sphere(diameter=diameter, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+        else:
+            scatterer = single.scatterer.Cylinder(diameter=diameter, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+
+        coupling = detector.get_coupling(scatterer).to(ureg.watt).magnitude
+        reference = get_mesh_coupling(detector, scatterer, mean_coupling=mean_coupling)
+
+        assert numpy.isclose(coupling, reference, rtol=1e-9, atol=0), f"Mismatch between fused and mesh coherent coupling for {diameter}."
+
+
+def test_shared_detector_matches_single():
+    diameters = numpy.geomspace(100, 15000, 12) * ureg.nanometer
+
+    source = experiment.source.Gaussian(
+        wavelength=700 * ureg.nanometer,
+        polarization=30 * ureg.degree,
+        optical_power=1 * ureg.watt,
+        NA=0.2 * ureg.AU,
+    )
+
+    scatterer = experiment.scatterer.Sphere(
+        diameter=diameters,
+        property=1.45 * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    detector = experiment.detector.CoherentMode(
+        mode_number='LP11',
+        NA=0.4 * ureg.AU,
+        gamma_offset=0 * ureg.degree,
+        phi_offset=45 * ureg.degree,
+        rotation=0 * ureg.degree,
+        sampling=1000 * ureg.AU,
+        mean_coupling=False,
+    )
+
+    # The weights of the shared detector grow with the largest sphere seen so far
+    coupling = Setup(scatterer=scatterer, source=source, detector=detector).get('coupling', as_numpy=True)
+
+    single_source = single.source.Gaussian(wavelength=700 * ureg.nanometer, polarization=30 * ureg.degree, optical_power=1 * ureg.watt, NA=0.2 * ureg.AU)
+
+    for diameter, value in zip(diameters, coupling):
+        single_detector = single.detector.CoherentMode(
+            mode_number='LP11', NA=0.4 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=45 * ureg.degree,
+            rotation=0 * ureg.degree, sampling=1000, mean_coupling=False,
+        )
+        single_scatterer = single.scatterer.Sphere(diameter=diameter, property=1.45 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=single_source)
+
+        assert numpy.isclose(value, single_detector.get_coupling(single_scatterer).to(ureg.watt).magnitude, rtol=1e-10, atol=0), "Shared detector should match a fresh one."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
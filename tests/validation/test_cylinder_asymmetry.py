@@ -0,0 +1,55 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim.single.scatterer import Cylinder
+from PyMieSim.single.source import PlaneWave
+
+
+@pytest.mark.parametrize('polarization', [0, 45, 90] * ureg.degree, ids=['0deg', '45deg', '90deg'])
+@pytest.mark.parametrize('diameter', [100, 1000, 10000] * ureg.nanometer, ids=['100nm', '1um', '10um'])
+@pytest.mark.parametrize('property', [1.5, 1.4 + 0.3j] * ureg.RIU, ids=['dielectric', 'absorbing'])
+def test_cylinder_g_vs_angular_integral(polarization, diameter, property):
+    source = PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=polarization,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+    scatterer = Cylinder(
+        diameter=diameter,
+        property=property,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    integral = scatterer._cpp_get_g_with_angular_integral(sampling=2_000)
+
+    assert numpy.isclose(scatterer.g.magnitude, integral, rtol=1e-10, atol=1e-12), "Mismatch between analytic and integrated asymmetry factor."
+
+
+def test_cylinder_Qpr_non_absorbing():
+    source = PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+    scatterer = Cylinder(
+        diameter=1000 * ureg.nanometer,
+        property=1.5 * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    Qsca, Qext, g = scatterer.Qsca.magnitude, scatterer.Qext.magnitude, scatterer.g.magnitude
+
+    assert numpy.isclose(Qext, Qsca, rtol=1e-10), "Extinction and scattering efficiencies differ for a non-absorbing cylinder."
+    assert numpy.isclose(scatterer.Qpr.magnitude, Qsca * (1 - g), rtol=1e-10), "Radiation pressure efficiency does not match Qsca (1 - g)."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
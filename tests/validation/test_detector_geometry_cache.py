@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+from PyMieSim.binary.interface_detector import DETECTOR
+
+
+# Zero offsets convert to the same radians in the single detectors and the experiment sets, their keys then match
+parameters = dict(
+    NA=0.3 * ureg.AU,
+    gamma_offset=0 * ureg.degree,
+    phi_offset=0 * ureg.degree,
+    rotation=0 * ureg.degree,
+    mean_coupling=False,
+)
+
+
+@pytest.fixture
+def geometry_cache():
+    DETECTOR.clear_geometry_cache()
+    yield
+    DETECTOR.set_geometry_cache(capacity=64)
+    DETECTOR.clear_geometry_cache()
+
+
+def test_identical_detectors_share_geometry(geometry_cache):
+    first = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+    second = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+
+    statistics = DETECTOR.get_geometry_cache_statistics()
+    assert statistics['misses'] == 1 and statistics['hits'] == 1, "The second detector should reuse the geometry of the first."
+
+    assert numpy.array_equal(first._cpp_mesh.spherical.phi, second._cpp_mesh.spherical.phi)
+    assert numpy.array_equal(first._cpp_scalar_field, second._cpp_scalar_field)
+
+
+def test_setup_shares_geometry_with_single_detectors(geometry_cache):
+    source = experiment.source.Gaussian(
+        wavelength=[1000] * ureg.nanometer, polarization=[0] * ureg.degree, optical_power=[1] * ureg.watt, NA=[0.2] * ureg.AU
+    )
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[500, 1500] * ureg.nanometer, property=[1.5] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+    detector = experiment.detector.CoherentMode(
+        mode_number=['LP11'], NA=[0.3] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[0] * ureg.degree,
+        rotation=[0] * ureg.degree, sampling=[800] * ureg.AU, mean_coupling=False
+    )
+
+    Setup(scatterer=scatterer, source=source, detector=detector).get('coupling', as_numpy=True)
+
+    statistics = DETECTOR.get_geometry_cache_statistics()
+    assert statistics['misses'] == 1 and statistics['hits'] == 0, "The geometry built by Setup should be held by the cache DETECTOR reports."
+
+    Setup(scatterer=scatterer, source=source, detector=detector).get('coupling', as_numpy=True)
+    single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+
+    statistics = DETECTOR.get_geometry_cache_statistics()
+    assert statistics['misses'] == 1 and statistics['hits'] == 2, "Other Setup objects and single detectors should reuse that geometry."
+
+
+def test_least_recently_used_eviction(geometry_cache):
+    DETECTOR.set_geometry_cache(capacity=2)
+
+    for sampling in [300, 400, 500, 300]:
+        single.detector.CoherentMode(mode_number='LP11', sampling=sampling, **parameters)
+
+    statistics = DETECTOR.get_geometry_cache_statistics()
+    assert statistics['size'] == 2, "The cache should not hold more geometries than its capacity."
+    assert statistics['evictions'] == 2 and statistics['misses'] == 4, "The oldest geometry should have been evicted before being requested again."
+
+
+def test_scalar_field_setter_is_private_to_detector(geometry_cache):
+    source = single.source.Gaussian(wavelength=1000 * ureg.nanometer, polarization=0 * ureg.degree, optical_power=1 * ureg.watt, NA=0.2 * ureg.AU)
+    scatterer = single.scatterer.Sphere(diameter=1500 * ureg.nanometer, property=1.5 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+
+    modified = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+    untouched = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+    reference = untouched.get_coupling(scatterer)
+
+    with pytest.raises(ValueError):
+        modified._cpp_scalar_field[0] = 0  # shared samples are read-only
+
+    scalar_field = numpy.array(modified._cpp_scalar_field)
+    scalar_field[: scalar_field.size // 2] = 0
+    modified._cpp_scalar_field = scalar_field
+
+    cached = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)
+
+    assert modified.get_coupling(scatterer) != reference, "The new scalar field should change the coupling."
+    assert untouched.get_coupling(scatterer) == reference, "Detectors sharing the geometry should keep the original scalar field."
+    assert cached.get_coupling(scatterer) == reference, "The cached geometry should keep the original scalar field."
+
+
+def test_mesh_copy_leaves_shared_mesh_untouched(geometry_cache):
+    first = single.detector.CoherentMode(mode_number='LP01', sampling=800, **parameters)
+    second = single.detector.CoherentMode(mode_number='LP11', sampling=800, **parameters)  # same geometry, other mode: the mesh is shared
+
+    reference = numpy.array(second._cpp_mesh.cartesian.x)
+
+    mesh = first._cpp_mesh
+    mesh.cartesian.x[:] = 0
+    mesh._cpp_d_omega = 0
+
+    assert numpy.array_equal(second._cpp_mesh.cartesian.x, reference), "Writes to a mesh copy should not reach the other modes."
+    assert numpy.array_equal(first._cpp_mesh.cartesian.x, reference), "Writes to a mesh copy should not reach the cached mesh."
+    assert first._cpp_mesh._cpp_d_omega != 0, "The cached solid angles should be untouched."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import experiment
+from PyMieSim.experiment import Setup
+
+
+forward = experiment.detector.Photodiode(
+    NA=[0.2] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[0] * ureg.degree, sampling=[800] * ureg.AU
+)
+side = experiment.detector.Photodiode(
+    NA=[0.3] * ureg.AU, gamma_offset=[20] * ureg.degree, phi_offset=[0, 30, 60, 90] * ureg.degree, sampling=[600] * ureg.AU
+)
+mode = experiment.detector.CoherentMode(
+    mode_number=['LP11', 'LP01'], NA=[0.3] * ureg.AU, gamma_offset=[5] * ureg.degree, phi_offset=[10] * ureg.degree,
+    rotation=[20] * ureg.degree, sampling=[900] * ureg.AU, mean_coupling=False, quadrature='gauss_legendre'
+)
+
+detectors = [forward, side, mode]
+
+
+@pytest.mark.parametrize('interpolation_tolerance', [0.0, 1e-8], ids=['exact', 'interpolated'])
+@pytest.mark.parametrize('scatterer_class', [experiment.scatterer.Sphere, experiment.scatterer.Cylinder], ids=['Sphere', 'Cylinder'])
+def test_group_matches_independent_detectors(scatterer_class, interpolation_tolerance):
+    source = experiment.source.PlaneWave(
+        wavelength=[600, 1000] * ureg.nanometer, polarization=[30] * ureg.degree, amplitude=[1] * ureg.volt / ureg.meter
+    )
+    scatterer = scatterer_class(
+        diameter=[300, 2000, 6000] * ureg.nanometer, property=[1.5 + 0.01j] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+
+    group = experiment.detector.DetectorGroup(detectors=detectors, names=['forward', 'side', 'mode'])
+
+    setup = Setup(scatterer=scatterer, source=source, detector=group)
+    setup.interpolation_tolerance = interpolation_tolerance
+    coupling = setup.get('coupling', as_numpy=True)
+
+    assert coupling.shape[-1] == 1 + 4 + 2, "The detectors of the group should be laid along the last axis."
+
+    references = []
+    for detector in detectors:
+        single_setup = Setup(scatterer=scatterer, source=source, detector=detector)
+        single_setup.interpolation_tolerance = interpolation_tolerance
+        references.append(single_setup.get('coupling', as_numpy=True).reshape(coupling.shape[:-1] + (-1,)))
+
+    reference = numpy.concatenate(references, axis=-1)
+    rtol = 1e-12 if interpolation_tolerance == 0 else 1e-6
+
+    assert numpy.allclose(coupling, reference, rtol=rtol, atol=0), "The group should match the detectors evaluated one by one."
+
+
+def test_group_shares_deferred_coefficients():
+    # A single particle in the anomalous-diffraction regime: the group runs its detectors in parallel on it while its
+    # coefficients are still deferred
+    source = experiment.source.PlaneWave(
+        wavelength=[1000] * ureg.nanometer, polarization=[0] * ureg.degree, amplitude=[1] * ureg.volt / ureg.meter
+    )
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[1] * ureg.millimeter, property=[1.01] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source, accuracy_target=0.1
+    )
+
+    particle_detectors = [
+        experiment.detector.Photodiode(
+            NA=[0.01] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[0, 1, 2, 3] * ureg.degree, sampling=[300] * ureg.AU
+        ),
+    ]
+    particle_detectors += [
+        experiment.detector.CoherentMode(
+            mode_number=[mode_number], NA=[0.01] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[1] * ureg.degree,
+            rotation=[0] * ureg.degree, sampling=[300] * ureg.AU, mean_coupling=False
+        ) for mode_number in ['LP01', 'LP11', 'LP21']
+    ]
+
+    group = experiment.detector.DetectorGroup(detectors=particle_detectors)
+
+    # The single detectors build a scatterer of their own per coupling
+    reference = numpy.concatenate([
+        Setup(scatterer=scatterer, source=source, detector=detector).get('coupling', as_numpy=True).ravel() for detector in particle_detectors
+    ])
+
+    for _ in range(5):
+        coupling = Setup(scatterer=scatterer, source=source, detector=group).get('coupling', as_numpy=True).ravel()
+
+        assert numpy.allclose(coupling, reference, rtol=1e-12, atol=0), "The deferred coefficients should be filled once for the whole group."
+
+
+def test_group_dataframe_labels():
+    source = experiment.source.Gaussian(
+        wavelength=[800] * ureg.nanometer, polarization=[0] * ureg.degree, optical_power=[1] * ureg.watt, NA=[0.2] * ureg.AU
+    )
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[500, 1000] * ureg.nanometer, property=[1.5] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+
+    group = experiment.detector.DetectorGroup(detectors=detectors, names=['forward', 'side', 'mode'])
+    dataframe = Setup(scatterer=scatterer, source=source, detector=group).get('coupling')
+
+    labels = list(dataframe.index.get_level_values('detector:group').unique())
+    assert labels == ['forward', 'side:0', 'side:1', 'side:2', 'side:3', 'mode:0', 'mode:1']
+
+
+def test_group_names_must_match_detectors():
+    with pytest.raises(ValueError):
+        experiment.detector.DetectorGroup(detectors=detectors, names=['forward'])
+
+
+def test_group_only_measures_coupling():
+    source = experiment.source.Gaussian(
+        wavelength=[800] * ureg.nanometer, polarization=[0] * ureg.degree, optical_power=[1] * ureg.watt, NA=[0.2] * ureg.AU
+    )
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[500] * ureg.nanometer, property=[1.5] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+
+    group = experiment.detector.DetectorGroup(detectors=detectors)
+    setup = Setup(scatterer=scatterer, source=source, detector=group)
+
+    with pytest.raises(ValueError, match="DetectorGroup"):
+        setup.get('Qsca', as_numpy=True)
+
+    with pytest.raises(ValueError, match="DetectorGroup"):
+        setup.get('coupling', 'Qsca')
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim.single.scatterer import Sphere, CoreShell
+from PyMieSim.single.source import PlaneWave
+
+
+@pytest.fixture
+def source():
+    return PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+
+def get_reference_s1s2(scatterer, phi):
+    """Direct partial-wave sum of S1 and S2 with numpy, independent of the C++ kernels."""
+    an, bn = numpy.asarray(scatterer.an), numpy.asarray(scatterer.bn)
+    mu = numpy.cos(phi - numpy.pi / 2)
+
+    S1 = numpy.zeros(mu.size, dtype=complex)
+    S2 = numpy.zeros(mu.size, dtype=complex)
+    pi_previous, pi_current = numpy.zeros_like(mu), numpy.ones_like(mu)
+
+    for index in range(an.size):
+        n = index + 1
+        if n > 1:
+            pi_previous, pi_current = pi_current, ((2 * n - 1) * mu * pi_current - n * pi_previous) / (n - 1)
+
+        tau = n * mu * pi_current - (n + 1) * pi_previous
+        prefactor = (2 * n + 1) / (n * (n + 1))
+
+        S1 += prefactor * (an[index] * pi_current + bn[index] * tau)
+        S2 += prefactor * (an[index] * tau + bn[index] * pi_current)
+
+    return S1, S2
+
+
+@pytest.mark.parametrize('diameter', [5, 100, 600] * ureg.micrometer, ids=['x~15', 'x~300', 'x~1900'])
+def test_fast_legendre_sphere(source, diameter):
+    scatterer = Sphere(
+        diameter=diameter,
+        property=(1.33 + 1e-4j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    phi = numpy.linspace(-numpy.pi / 2, numpy.pi / 2, 3_001)
+
+    reference_S1, reference_S2 = get_reference_s1s2(scatterer, phi)
+
+    for method in ['direct', 'fast', 'auto']:
+        S1, S2 = scatterer._cpp_get_spherical_s1s2(phi=phi, method=method)
+        scale = numpy.abs(reference_S1).max()
+
+        assert numpy.abs(S1 - reference_S1).max() < 1e-9 * scale, f"S1 mismatch with the direct sum for method '{method}'."
+        assert numpy.abs(S2 - reference_S2).max() < 1e-9 * scale, f"S2 mismatch with the direct sum for method '{method}'."
+
+
+def test_fast_legendre_coreshell(source):
+    scatterer = CoreShell(
+        core_diameter=200 * ureg.micrometer,
+        shell_thickness=5 * ureg.micrometer,
+        core_property=1.5 * ureg.RIU,
+        shell_property=(1.4 + 1e-3j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    phi = numpy.linspace(-numpy.pi / 2, numpy.pi / 2, 2_001)
+
+    direct_S1, direct_S2 = scatterer._cpp_get_spherical_s1s2(phi=phi, method='direct')
+    fast_S1, fast_S2 = scatterer._cpp_get_spherical_s1s2(phi=phi, method='fast')
+
+    scale = numpy.abs(direct_S1).max()
+    assert numpy.abs(fast_S1 - direct_S1).max() < 1e-9 * scale, "S1 mismatch between fast and direct methods."
+    assert numpy.abs(fast_S2 - direct_S2).max() < 1e-9 * scale, "S2 mismatch between fast and direct methods."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+
+from PyMieSim.binary.interface_detector import FIBONACCIMESH
+
+
+def get_spiral_reference(sampling, max_angle, min_angle):
+    """Points of the full-sphere golden spiral falling in the cap or annulus, selected one by one."""
+    solid_angle = 2 * numpy.pi * abs(numpy.cos(min_angle) - numpy.cos(max_angle))
+    n_spiral = int(sampling * 4 * numpy.pi / solid_angle)
+
+    index = numpy.arange(n_spiral)
+    z = 1 - 2. * index / (n_spiral - 1)
+    index = index[numpy.pi / 2 - numpy.arcsin(z) >= min_angle][:sampling]
+
+    z = 1 - 2. * index / (n_spiral - 1)
+    theta = numpy.pi * (3. - numpy.sqrt(5.)) * index
+    radius = numpy.sqrt(1 - z * z)
+
+    return numpy.cos(theta) * radius, numpy.sin(theta) * radius, z
+
+
+@pytest.mark.parametrize('max_angle, min_angle', [(0.05, 0.0), (0.6, 0.3), (1.2, 1.15), (2.5, 1.0)], ids=['narrow_cap', 'annulus', 'thin_annulus', 'wide_annulus'])
+def test_annulus_matches_spiral_selection(max_angle, min_angle):
+    sampling = 2000
+    mesh = FIBONACCIMESH(sampling=sampling, max_angle=max_angle, min_angle=min_angle, phi_offset=0.0, gamma_offset=0.0, rotation_angle=0.0)
+
+    x, y, z = get_spiral_reference(sampling, max_angle, min_angle)
+
+    assert len(mesh.base_cartesian.z) == sampling, "The mesh should hold one point per sample."
+    assert numpy.allclose(mesh.base_cartesian.x, x, rtol=0, atol=1e-12)
+    assert numpy.allclose(mesh.base_cartesian.y, y, rtol=0, atol=1e-12)
+    assert numpy.allclose(mesh.base_cartesian.z, z, rtol=0, atol=1e-12)
+
+    # The spiral length is rounded down, the last points may step past max_angle by a fraction of the spacing
+    polar_angle = numpy.arccos(numpy.clip(mesh.base_cartesian.z, -1, 1))
+    assert numpy.all(polar_angle >= min_angle) and numpy.all(polar_angle <= max_angle + 1e-3), "Points should lie in the annulus."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+from PyMieSim.binary.interface_detector import GAUSSLEGENDREMESH
+
+
+@pytest.fixture
+def source():
+    return single.source.Gaussian(wavelength=1000 * ureg.nanometer, polarization=40 * ureg.degree, optical_power=1 * ureg.watt, NA=0.2 * ureg.AU)
+
+
+def test_product_rule_integrates_polynomials():
+    max_angle, min_angle = 0.6, 0.1
+    mesh = GAUSSLEGENDREMESH(sampling=1000, max_angle=max_angle, min_angle=min_angle, phi_offset=0.2, gamma_offset=0.3, rotation_angle=0.4)
+
+    weights = mesh._cpp_quadrature_weights
+    assert weights.size == mesh._cpp_polar_sampling * mesh._cpp_azimuthal_sampling == mesh.cartesian.x.size
+    assert numpy.isclose(weights.sum(), mesh._cpp_omega, rtol=1e-13, atol=0), "The weights should add up to the solid angle."
+
+    # Integral of z^4 x^2 over the annulus around the detector axis
+    x, z = mesh.base_cartesian.x, mesh.base_cartesian.z
+    mu_max, mu_min = numpy.cos(min_angle), numpy.cos(max_angle)
+    exact = numpy.pi * ((mu_max ** 5 - mu_min ** 5) / 5 - (mu_max ** 7 - mu_min ** 7) / 7)
+    assert numpy.isclose(numpy.sum(weights * z ** 4 * x ** 2), exact, rtol=1e-12, atol=0)
+
+
+@pytest.mark.parametrize('mode_number', ['LP11', 'LG11', 'NC00'])
+def test_coupling_converges_with_few_points(source, mode_number):
+    scatterer = single.scatterer.Sphere(diameter=5000 * ureg.nanometer, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+
+    def get_coupling(sampling, quadrature):
+        if mode_number == 'NC00':
+            detector = single.detector.Photodiode(NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree, sampling=sampling, quadrature=quadrature)
+        else:
+            detector = single.detector.CoherentMode(
+                mode_number=mode_number, NA=0.5 * ureg.AU, gamma_offset=10 * ureg.degree, phi_offset=20 * ureg.degree,
+                sampling=sampling, rotation=0 * ureg.degree, quadrature=quadrature
+            )
+
+        return detector.get_coupling(scatterer).to(ureg.watt).magnitude
+
+    reference = get_coupling(10000, 'gauss_legendre')
+
+    assert numpy.isclose(get_coupling(1500, 'gauss_legendre'), reference, rtol=1e-8, atol=0), "The product rule should have converged."
+    assert numpy.isclose(get_coupling(20000, 'fibonacci'), reference, rtol=1e-3, atol=0), "The Fibonacci mesh should converge to the same coupling."
+
+
+def test_energy_flow_matches_on_axis_integral(source):
+    scatterer = single.scatterer.Sphere(diameter=3000 * ureg.nanometer, property=1.5 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+
+    detector = single.detector.Photodiode(NA=0.5 * ureg.AU, cache_NA=0.1 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=0 * ureg.degree, sampling=2000, quadrature='gauss_legendre')
+
+    # The coupling of an on-axis photodiode is integrated exactly, the energy flow on the mesh
+    coupling = detector.get_coupling(scatterer).to(ureg.watt).magnitude
+    energy_flow = detector.get_energy_flow(scatterer, distance=1 * ureg.meter).to(ureg.watt).magnitude
+
+    assert numpy.isclose(energy_flow, coupling, rtol=1e-8, atol=0)
+
+
+def test_experiment_matches_single():
+    diameters = numpy.geomspace(500, 8000, 5) * ureg.nanometer
+
+    source = experiment.source.Gaussian(wavelength=800 * ureg.nanometer, polarization=0 * ureg.degree, optical_power=1 * ureg.watt, NA=0.2 * ureg.AU)
+    scatterer = experiment.scatterer.Sphere(diameter=diameters, property=1.45 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source)
+    detector = experiment.detector.CoherentMode(
+        mode_number='LP11', NA=0.4 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=30 * ureg.degree,
+        rotation=0 * ureg.degree, sampling=800 * ureg.AU, mean_coupling=False, quadrature='gauss_legendre',
+    )
+
+    setup = Setup(scatterer=scatterer, source=source, detector=detector)
+    coupling = setup.get('coupling', as_numpy=True)
+
+    single_source = single.source.Gaussian(wavelength=800 * ureg.nanometer, polarization=0 * ureg.degree, optical_power=1 * ureg.watt, NA=0.2 * ureg.AU)
+    single_detector = single.detector.CoherentMode(
+        mode_number='LP11', NA=0.4 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=30 * ureg.degree,
+        rotation=0 * ureg.degree, sampling=800, quadrature='gauss_legendre',
+    )
+
+    for diameter, value in zip(diameters, coupling):
+        single_scatterer = single.scatterer.Sphere(diameter=diameter, property=1.45 * ureg.RIU, medium_property=1.0 * ureg.RIU, source=single_source)
+        assert numpy.isclose(value, single_detector.get_coupling(single_scatterer).to(ureg.watt).magnitude, rtol=1e-10, atol=0)
+
+    # Far fields are evaluated on the product mesh like on a Fibonacci mesh
+    mesh = GAUSSLEGENDREMESH(sampling=600, max_angle=0.5, min_angle=0.0, phi_offset=0.0, gamma_offset=0.0, rotation_angle=0.0)
+    farfields = setup._get_farfields(scatterer_set=setup.scatterer.set, source_set=setup.source.set, mesh=mesh)
+    assert farfields.shape[-1] == mesh.cartesian.x.size
+
+
+def test_invalid_quadrature(source):
+    with pytest.raises(ValueError):
+        single.detector.Photodiode(NA=0.5 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=0 * ureg.degree, quadrature='simpson')
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
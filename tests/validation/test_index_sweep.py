@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+from PyMieSim.binary.interface_experiment import EXPERIMENT
+
+indices = numpy.linspace(1.3, 1.7, 25) * ureg.RIU
+diameters = [800, 3000] * ureg.nanometer
+media = [1.0, 1.33] * ureg.RIU
+
+source = experiment.source.PlaneWave(
+    wavelength=1000 * ureg.nanometer,
+    polarization=0 * ureg.degree,
+    amplitude=1 * ureg.volt / ureg.meter,
+)
+
+single_source = single.source.PlaneWave(
+    wavelength=1000 * ureg.nanometer,
+    polarization=0 * ureg.degree,
+    amplitude=1 * ureg.volt / ureg.meter,
+)
+
+scatterer_types = ['Sphere', 'Cylinder']
+
+
+@pytest.mark.parametrize('scatterer_type', scatterer_types, ids=scatterer_types)
+def test_index_sweep_matches_single(scatterer_type):
+    scatterer = getattr(experiment.scatterer, scatterer_type)(
+        diameter=diameters,
+        property=indices,
+        medium_property=media,
+        source=source,
+    )
+
+    setup = Setup(scatterer=scatterer, source=source)
+    setup.use_sphere_batch = False  # spheres are evaluated as Sphere objects, which share the size-parameter tables
+
+    EXPERIMENT.clear_size_parameter_cache()
+
+    values = setup.get('Qsca', as_numpy=True).squeeze()
+
+    statistics = EXPERIMENT.get_size_parameter_cache_statistics()
+
+    n_size_parameters = len(diameters) * len(media)
+    assert statistics['misses'] == n_size_parameters, "The tables should be computed once per size parameter, whatever the thread schedule."
+    assert statistics['hits'] == n_size_parameters * (len(indices) - 1), "The other indices should reuse the tables of their size parameter."
+
+    # The points are visited grouped by size parameter and reuse a shared table, they must still match isolated scatterers
+    for i, diameter in enumerate(diameters):
+        for j, medium in enumerate(media):
+            reference = [
+                getattr(single.scatterer, scatterer_type)(
+                    diameter=diameter, property=index, medium_property=medium, source=single_source
+                ).Qsca.magnitude
+                for index in indices
+            ]
+
+            assert numpy.allclose(values[i, :, j], reference, rtol=1e-12, atol=0), f"Index sweep of {scatterer_type} differs from single scatterers."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
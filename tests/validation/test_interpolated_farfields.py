@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+
+@pytest.fixture
+def source_single():
+    return single.source.Gaussian(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        optical_power=1 * ureg.watt,
+        NA=0.3 * ureg.AU,
+    )
+
+
+@pytest.mark.parametrize('diameter', [500, 5000, 20000] * ureg.nanometer, ids=['small', 'medium', 'large'])
+@pytest.mark.parametrize('mode_number', ['NC00', 'LP01'])
+def test_interpolated_coupling_single(source_single, diameter, mode_number):
+    scatterer = single.scatterer.Sphere(
+        diameter=diameter,
+        property=(1.5 + 0.01j) * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source_single,
+    )
+
+    detector = single.detector.CoherentMode(
+        mode_number=mode_number,
+        NA=0.8 * ureg.AU,
+        gamma_offset=0 * ureg.degree,
+        phi_offset=30 * ureg.degree,
+        sampling=50_000,
+    )
+
+    reference = detector.get_coupling(scatterer).to(ureg.watt).magnitude
+
+    detector.interpolation_tolerance = 1e-8
+    interpolated = detector.get_coupling(scatterer).to(ureg.watt).magnitude
+
+    assert numpy.isclose(interpolated, reference, rtol=1e-6, atol=0), "Mismatch between interpolated and exact coupling."
+
+
+def test_interpolated_coupling_experiment():
+    source = experiment.source.Gaussian(
+        wavelength=numpy.linspace(600, 1000, 5) * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        optical_power=1e-3 * ureg.watt,
+        NA=0.2 * ureg.AU,
+    )
+
+    scatterer = experiment.scatterer.Sphere(
+        diameter=numpy.linspace(100, 10000, 10) * ureg.nanometer,
+        property=1.4 * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    # Off axis, on-axis photodiodes integrate spheres exactly without the mesh
+    detector = experiment.detector.Photodiode(
+        NA=0.5 * ureg.AU,
+        phi_offset=20 * ureg.degree,
+        gamma_offset=0 * ureg.degree,
+        sampling=20_000 * ureg.AU,
+        polarization_filter=None,
+    )
+
+    setup = Setup(scatterer=scatterer, source=source, detector=detector)
+    reference = setup.get('coupling', add_units=False).values.squeeze()
+
+    setup.interpolation_tolerance = 1e-8
+    interpolated = setup.get('coupling', add_units=False).values.squeeze()
+
+    assert numpy.allclose(interpolated, reference, rtol=1e-6, atol=0), "Mismatch between interpolated and exact coupling."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,162 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from PyOptik import Material
+from TypedUnit import ureg
+
+from PyMieSim import single
+
+wavelength = 500 * ureg.nanometer
+
+
+def downward_dn(z: complex, n_max: int, n_start: int) -> numpy.ndarray:
+    """D_n(z) for n = 0 to n_max from a zero start far above n_max, the reference the Lentz start must reproduce."""
+    dn = numpy.zeros(n_start + 1, dtype=complex)
+    for n in range(n_start, 0, -1):
+        dn[n - 1] = n / z - 1 / (dn[n] + n / z)
+    return dn[:n_max + 1]
+
+
+def reference_efficiencies(x: float, m: complex) -> tuple:
+    """Qext and Qsca of a sphere written out from Bohren and Huffman, with the same number of orders as Sphere."""
+    n_max = int(2 + x + 4 * numpy.cbrt(x)) + 16
+    n_start = n_max + int(4 * abs(m * x)) + 200
+
+    dn = downward_dn(m * x, n_max, n_start)
+    dx = downward_dn(x, n_max, n_start).real
+
+    psi_1, psi_2, chi_1, chi_2 = numpy.sin(x), numpy.cos(x), numpy.cos(x), -numpy.sin(x)
+    ext = sca = 0
+    for n in range(1, n_max + 1):
+        psi = (2 * n - 1) / x * psi_1 - psi_2 if n <= x else psi_1 / (dx[n] + n / x)
+        chi = (2 * n - 1) / x * chi_1 - chi_2
+        xi, xi_1 = psi - 1j * chi, psi_1 - 1j * chi_1
+
+        da, db = dn[n] / m + n / x, dn[n] * m + n / x
+        a = (da * psi - psi_1) / (da * xi - xi_1)
+        b = (db * psi - psi_1) / (db * xi - xi_1)
+
+        ext += (2 * n + 1) * (a + b).real
+        sca += (2 * n + 1) * (abs(a) ** 2 + abs(b) ** 2)
+
+        psi_2, psi_1, chi_2, chi_1 = psi_1, psi, chi_1, chi
+
+    return 2 * ext / x ** 2, 2 * sca / x ** 2
+
+
+def hankel_asymptotic(nu: int, x: float, n_terms: int = 30) -> tuple:
+    """J_nu(x) and Y_nu(x) of a large real argument from the Hankel expansions."""
+    mu = 4 * nu ** 2
+    P = Q = 0
+    term = 1
+    for k in range(n_terms):
+        term = term * (mu - (2 * k - 1) ** 2) / (8 * k * x) if k > 0 else 1
+        sign = -1 if k % 4 in (2, 3) else 1
+        P, Q = (P + sign * term, Q) if k % 2 == 0 else (P, Q + sign * term)
+
+    chi = x - (nu / 2 + 0.25) * numpy.pi
+    scale = numpy.sqrt(2 / (numpy.pi * x))
+    return scale * (P * numpy.cos(chi) - Q * numpy.sin(chi)), scale * (P * numpy.sin(chi) + Q * numpy.cos(chi))
+
+
+def reference_cylinder_efficiencies(x: float, m: complex) -> tuple:
+    """Qext and Qsca of a cylinder at normal incidence for the two polarizations, from the coefficients of Cylinder."""
+    n_max = int(2 + x + 4 * numpy.cbrt(x)) + 16
+
+    # J_n(x) by Miller's downward recurrence, scaled to the asymptotic J_0 or J_1, and Y_n(x) by the upward one
+    j0, y0 = hankel_asymptotic(0, x)
+    j1, y1 = hankel_asymptotic(1, x)
+
+    f = numpy.zeros(n_max + 402)
+    f[-2] = 1e-300
+    for n in range(n_max + 400, 0, -1):
+        f[n - 1] = 2 * n / x * f[n] - f[n + 1]
+        if abs(f[n - 1]) > 1e250:
+            f *= 1e-250
+
+    J = f[:n_max + 1] * (j0 / f[0] if abs(j0) > abs(j1) else j1 / f[1])
+    Y = numpy.zeros(n_max + 1)
+    Y[0], Y[1] = y0, y1
+    for n in range(1, n_max):
+        Y[n + 1] = 2 * n / x * Y[n] - Y[n - 1]
+
+    H = J + 1j * Y
+    n = numpy.arange(1, n_max)
+    Jp = numpy.concatenate([[-J[1]], J[n - 1] - n / x * J[n]])
+    Hp = numpy.concatenate([[-H[1]], H[n - 1] - n / x * H[n]])
+
+    # D_n(mx) = J_n'(mx) / J_n(mx) from a zero start far above |mx|
+    z = m * x
+    n_start = n_max + int(4 * abs(z)) + 200
+    dn = numpy.zeros(n_start + 1, dtype=complex)
+    for k in range(n_start, 0, -1):
+        dn[k - 1] = (k - 1) / z - 1 / (dn[k] + k / z)
+    dn, J, H = dn[:n_max], J[:n_max], H[:n_max]
+
+    a = (m * Jp - dn * J) / (m * Hp - dn * H)
+    b = (Jp - m * dn * J) / (Hp - m * dn * H)
+    weight = numpy.where(numpy.arange(n_max) == 0, 1, 2)
+
+    Qext = [2 / x * numpy.sum(weight * c.real) for c in (a, b)]
+    Qsca = [2 / x * numpy.sum(weight * abs(c) ** 2) for c in (a, b)]
+    return Qext, Qsca
+
+
+@pytest.mark.parametrize('material', [Material.gold, Material.silver], ids=['gold', 'silver'])
+@pytest.mark.parametrize('diameter', [20, 150, 1000, 8000] * ureg.nanometer, ids=['20nm', '150nm', '1um', '8um'])
+def test_metal_sphere_coefficients(material, diameter):
+    source = single.source.PlaneWave(wavelength=wavelength, polarization=0 * ureg.degree, amplitude=1 * ureg.volt / ureg.meter)
+    sphere = single.scatterer.Sphere(diameter=diameter, property=material, medium_property=1.0 * ureg.RIU, source=source)
+
+    m = complex(numpy.atleast_1d(material.compute_refractive_index(wavelength.to('meter').magnitude))[0])
+    x = numpy.pi * diameter.to('meter').magnitude / wavelength.to('meter').magnitude
+
+    Qext, Qsca = reference_efficiencies(x, m)
+
+    assert numpy.isclose(sphere.Qext.magnitude, Qext, rtol=1e-9, atol=0), "Qext of a metal sphere differs from the reference recurrence."
+    assert numpy.isclose(sphere.Qsca.magnitude, Qsca, rtol=1e-9, atol=0), "Qsca of a metal sphere differs from the reference recurrence."
+
+
+@pytest.mark.parametrize('material', [Material.gold, Material.silver], ids=['gold', 'silver'])
+def test_metal_cylinder_and_coreshell(material):
+    source = single.source.PlaneWave(wavelength=wavelength, polarization=0 * ureg.degree, amplitude=1 * ureg.volt / ureg.meter)
+
+    # A gold or silver shell of zero thickness reduces to the bare silica core
+    core = single.scatterer.Sphere(diameter=400 * ureg.nanometer, property=Material.fused_silica, medium_property=1.0 * ureg.RIU, source=source)
+    coreshell = single.scatterer.CoreShell(
+        core_diameter=400 * ureg.nanometer,
+        shell_thickness=0 * ureg.nanometer,
+        core_property=Material.fused_silica,
+        shell_property=material,
+        medium_property=1.0 * ureg.RIU,
+        source=source
+    )
+    assert numpy.isclose(coreshell.Qsca.magnitude, core.Qsca.magnitude, rtol=1e-8, atol=0), "Zero-thickness metal shell should not change the core."
+
+    # Metal cylinders take D_n(mx) from the continued fraction instead of J_n(mx) and J_n'(mx)
+    for diameter in [50, 500, 5000] * ureg.nanometer:
+        cylinder = single.scatterer.Cylinder(diameter=diameter, property=material, medium_property=1.0 * ureg.RIU, source=source)
+        assert 0 < cylinder.Qsca.magnitude <= cylinder.Qext.magnitude, "Metal cylinder violates Qsca <= Qext."
+
+
+@pytest.mark.parametrize('polarization', [0, 90] * ureg.degree, ids=['0deg', '90deg'])
+def test_large_weakly_absorbing_cylinder(polarization):
+    # At x = 3000 a start at max_order + 16 misses D_n(mx) by tens of percent and the efficiencies by up to 1 %
+    x, m = 3000, 2 + 1e-4j
+
+    source = single.source.PlaneWave(wavelength=wavelength, polarization=polarization, amplitude=1 * ureg.volt / ureg.meter)
+    cylinder = single.scatterer.Cylinder(
+        diameter=x * wavelength / numpy.pi, property=m * ureg.RIU, medium_property=1.0 * ureg.RIU, source=source
+    )
+
+    Qext, Qsca = reference_cylinder_efficiencies(x, m)
+    index = 0 if polarization.magnitude == 0 else 1
+
+    assert numpy.isclose(cylinder.Qext.magnitude, Qext[index], rtol=1e-9, atol=0), "Qext of a large cylinder differs from the reference recurrence."
+    assert numpy.isclose(cylinder.Qsca.magnitude, Qsca[index], rtol=1e-9, atol=0), "Qsca of a large cylinder differs from the reference recurrence."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single
+
+# A vanishing absorption sends the same particle through the complex-index kernel
+perturbation = 1e-12j
+measures = ['Qsca', 'Qext', 'Qback', 'g']
+
+
+@pytest.fixture
+def source():
+    return single.source.PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+
+@pytest.mark.parametrize('diameter', [50, 800, 5000, 30_000] * ureg.nanometer, ids=['50nm', '800nm', '5um', '30um'])
+def test_sphere_real_index_path(source, diameter):
+    kwargs = dict(diameter=diameter, medium_property=1.33 * ureg.RIU, source=source)
+    real = single.scatterer.Sphere(property=1.59 * ureg.RIU, **kwargs)
+    complex_ = single.scatterer.Sphere(property=(1.59 + perturbation) * ureg.RIU, **kwargs)
+
+    for measure in measures:
+        value, reference = getattr(real, measure).magnitude, getattr(complex_, measure).magnitude
+        assert numpy.isclose(value, reference, rtol=1e-8, atol=0), f"Real-index sphere kernel mismatch on {measure}."
+
+
+@pytest.mark.parametrize('diameter', [100, 1000, 8000] * ureg.nanometer, ids=['100nm', '1um', '8um'])
+def test_coreshell_real_index_path(source, diameter):
+    kwargs = dict(core_diameter=diameter, shell_thickness=diameter / 5, shell_property=1.45 * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source)
+    real = single.scatterer.CoreShell(core_property=1.59 * ureg.RIU, **kwargs)
+    complex_ = single.scatterer.CoreShell(core_property=(1.59 + perturbation) * ureg.RIU, **kwargs)
+
+    # The real kernel builds the shell Riccati-Bessel functions from recurrences instead of AMOS
+    for measure in measures:
+        value, reference = getattr(real, measure).magnitude, getattr(complex_, measure).magnitude
+        assert numpy.isclose(value, reference, rtol=1e-7, atol=0), f"Real-index core-shell kernel mismatch on {measure}."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single
+
+
+def bessel_j(order, x):
+    # Integral representation of J_n, the periodic trapezoidal rule converging geometrically
+    tau = numpy.linspace(0, numpy.pi, 401)
+    integrand = numpy.cos(order * tau[:, None] - numpy.sin(tau[:, None]) * numpy.atleast_1d(x)[None, :])
+    return numpy.trapezoid(integrand, tau, axis=0) / numpy.pi
+
+
+def bessel_zero(order, rank):
+    x = numpy.linspace(order + 0.5, order + 4 * rank + 4, 4000)
+    values = bessel_j(order, x)
+    lower = x[numpy.flatnonzero(numpy.sign(values[:-1]) != numpy.sign(values[1:]))[rank - 1]]
+    upper = lower + x[1] - x[0]
+
+    for _ in range(60):
+        middle = 0.5 * (lower + upper)
+        if numpy.sign(bessel_j(order, middle)[0]) == numpy.sign(bessel_j(order, lower)[0]):
+            lower = middle
+        else:
+            upper = middle
+
+    return 0.5 * (lower + upper)
+
+
+@pytest.mark.parametrize('mode_number', ['LP01', 'LP11', 'LP21', 'LP02', 'LP13', 'LP41'])
+def test_lp_field_matches_bessel_profile(mode_number):
+    azimuthal_number, radial_number = int(mode_number[2]), int(mode_number[3])
+
+    detector = single.detector.CoherentMode(
+        mode_number=mode_number, NA=0.3 * ureg.AU, gamma_offset=0 * ureg.degree, phi_offset=0 * ureg.degree,
+        sampling=2000, rotation=0 * ureg.degree, mean_coupling=False
+    )
+
+    x = numpy.asarray(detector._cpp_mesh.base_cartesian.x)
+    y = numpy.asarray(detector._cpp_mesh.base_cartesian.y)
+    r = numpy.hypot(x, y) / numpy.hypot(x, y).max()
+
+    reference = bessel_j(azimuthal_number, r * bessel_zero(azimuthal_number, radial_number)) * numpy.cos(azimuthal_number * numpy.arctan2(y, x))
+    reference /= numpy.linalg.norm(reference)
+
+    scalar_field = numpy.asarray(detector._cpp_scalar_field)
+
+    assert numpy.all(scalar_field.imag == 0), "The LP modes should be real."
+    assert numpy.allclose(scalar_field.real, reference, rtol=0, atol=1e-10), "The LP mode should follow J_n(j r) cos(n phi)."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import experiment
+from PyMieSim.experiment import Setup
+
+mode_numbers = ['LP01', 'LP11', 'LP21', 'LP02', 'LP31', 'LP12', 'HG11', 'LG22']
+
+
+# Parameters shared by the multi-mode detector and its single-mode references
+parameters = dict(
+    NA=[0.3] * ureg.AU, gamma_offset=[10] * ureg.degree, phi_offset=[20] * ureg.degree, rotation=[10] * ureg.degree,
+    sampling=[1500] * ureg.AU, polarization_filter=[numpy.nan, 40] * ureg.degree
+)
+
+
+@pytest.mark.parametrize('interpolation_tolerance', [0.0, 1e-8], ids=['exact', 'interpolated'])
+@pytest.mark.parametrize('mean_coupling', [False, True], ids=['point', 'mean'])
+@pytest.mark.parametrize('scatterer_class', [experiment.scatterer.Sphere, experiment.scatterer.Cylinder], ids=['Sphere', 'Cylinder'])
+def test_modes_match_single_mode_detectors(scatterer_class, mean_coupling, interpolation_tolerance):
+    source = experiment.source.PlaneWave(
+        wavelength=[600, 1000] * ureg.nanometer, polarization=[30] * ureg.degree, amplitude=[1] * ureg.volt / ureg.meter
+    )
+    scatterer = scatterer_class(
+        diameter=[500, 3000] * ureg.nanometer, property=[1.5 + 0.01j] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+
+    detector = experiment.detector.CoherentMode(mode_number=mode_numbers, mean_coupling=mean_coupling, **parameters)
+
+    setup = Setup(scatterer=scatterer, source=source, detector=detector)
+    setup.interpolation_tolerance = interpolation_tolerance
+    coupling = setup.get('coupling', as_numpy=True)
+
+    for index, mode_number in enumerate(mode_numbers):
+        single_detector = experiment.detector.CoherentMode(mode_number=[mode_number], mean_coupling=mean_coupling, **parameters)
+        single_setup = Setup(scatterer=scatterer, source=source, detector=single_detector)
+        single_setup.interpolation_tolerance = interpolation_tolerance
+        reference = single_setup.get('coupling', as_numpy=True)
+
+        # The mode is the first detector axis, the polarization filter the only other one of several values
+        value = coupling.reshape(-1, len(mode_numbers), 2)[:, index, :]
+
+        assert numpy.allclose(value, reference.reshape(-1, 2), rtol=1e-10, atol=0), \
+            f"The coupling of {mode_number} should not depend on the other modes of the detector."
+
+
+def test_modes_share_deferred_coefficients():
+    # A single particle in the anomalous-diffraction regime: its modes couple in parallel while its coefficients are deferred
+    source = experiment.source.PlaneWave(
+        wavelength=[1000] * ureg.nanometer, polarization=[0] * ureg.degree, amplitude=[1] * ureg.volt / ureg.meter
+    )
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[1] * ureg.millimeter, property=[1.01] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source, accuracy_target=0.1
+    )
+
+    modes = ['LP01', 'LP11', 'LP21', 'LP02']
+
+    detector = experiment.detector.CoherentMode(
+        mode_number=modes, NA=[0.01] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[1] * ureg.degree,
+        rotation=[0] * ureg.degree, sampling=[300] * ureg.AU, mean_coupling=False
+    )
+
+    reference = numpy.concatenate([
+        Setup(
+            scatterer=scatterer,
+            source=source,
+            detector=experiment.detector.CoherentMode(
+                mode_number=[mode_number], NA=[0.01] * ureg.AU, gamma_offset=[0] * ureg.degree, phi_offset=[1] * ureg.degree,
+                rotation=[0] * ureg.degree, sampling=[300] * ureg.AU, mean_coupling=False
+            )
+        ).get('coupling', as_numpy=True).ravel() for mode_number in modes
+    ])
+
+    for _ in range(5):
+        coupling = Setup(scatterer=scatterer, source=source, detector=detector).get('coupling', as_numpy=True).ravel()
+
+        assert numpy.allclose(coupling, reference, rtol=1e-12, atol=0), "The deferred coefficients should be filled once for every mode."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
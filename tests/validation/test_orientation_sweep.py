@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import experiment
+from PyMieSim.experiment import Setup
+
+phi_offsets = numpy.linspace(-90, 90, 7) * ureg.degree
+gamma_offsets = [0, 20] * ureg.degree
+
+# Detector classes with their parameters, the orientations being set by each test
+detectors = [
+    (experiment.detector.Photodiode, dict(NA=[0.2] * ureg.AU, sampling=[800] * ureg.AU)),
+    (experiment.detector.CoherentMode, dict(
+        mode_number=['LP11'], NA=[0.2] * ureg.AU, rotation=[10] * ureg.degree, sampling=[800] * ureg.AU, mean_coupling=False
+    )),
+]
+
+
+@pytest.mark.parametrize('detector_class, parameters', detectors, ids=['Photodiode', 'LP11'])
+@pytest.mark.parametrize('scatterer_class', [experiment.scatterer.Sphere, experiment.scatterer.Cylinder], ids=['Sphere', 'Cylinder'])
+def test_sweep_matches_single_orientations(scatterer_class, detector_class, parameters):
+    source = experiment.source.PlaneWave(
+        wavelength=[800] * ureg.nanometer, polarization=[30] * ureg.degree, amplitude=[1] * ureg.volt / ureg.meter
+    )
+    scatterer = scatterer_class(
+        diameter=[500, 3000] * ureg.nanometer, property=[1.5 + 0.01j] * ureg.RIU, medium_property=[1.0] * ureg.RIU, source=source
+    )
+
+    detector = detector_class(**parameters, phi_offset=phi_offsets, gamma_offset=gamma_offsets)
+
+    setup = Setup(scatterer=scatterer, source=source, detector=detector)
+    setup.interpolation_tolerance = 1e-8
+    coupling = setup.get('coupling', as_numpy=True)
+    coupling = coupling.reshape(coupling.shape[:-2] + (len(phi_offsets), len(gamma_offsets)))
+
+    for i, phi_offset in enumerate(phi_offsets):
+        for j, gamma_offset in enumerate(gamma_offsets):
+            single_detector = detector_class(
+                **parameters, phi_offset=[phi_offset.to(ureg.degree).magnitude] * ureg.degree, gamma_offset=[gamma_offset.to(ureg.degree).magnitude] * ureg.degree
+            )
+            reference = Setup(scatterer=scatterer, source=source, detector=single_detector).get('coupling', as_numpy=True)
+
+            assert numpy.allclose(coupling[..., i, j], reference.reshape(coupling.shape[:-2]), rtol=1e-6, atol=0), \
+                "The sweep should match the orientations evaluated one by one."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single
+
+
+@pytest.fixture
+def source():
+    return single.source.Gaussian(
+        wavelength=700 * ureg.nanometer,
+        polarization=30 * ureg.degree,
+        optical_power=1 * ureg.watt,
+        NA=0.2 * ureg.AU,
+    )
+
+
+def get_scatterer(scatterer_type, diameter, source):
+    if scatterer_type == 'sphere':
+        return single.scatterer.Sphere(diameter=diameter, property=(1.5 + 0.01j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source)
+
+    return single.scatterer.CoreShell(
+        core_diameter=diameter, shell_thickness=200 * ureg.nanometer, core_property=1.5 * ureg.RIU,
+        shell_property=(1.6 + 0.02j) * ureg.RIU, medium_property=1.33 * ureg.RIU, source=source
+    )
+
+
+@pytest.mark.parametrize('NA, cache_NA', [(0.2, 0.0), (0.9, 0.3), (1.5, 0.5)], ids=['forward', 'annulus', 'wide'])
+@pytest.mark.parametrize('scatterer_type', ['sphere', 'coreshell'])
+def test_on_axis_coupling_is_sampling_independent(source, scatterer_type, NA, cache_NA):
+    scatterer = get_scatterer(scatterer_type, 2000 * ureg.nanometer, source)
+
+    couplings = [
+        single.detector.Photodiode(
+            NA=NA * ureg.AU,
+            cache_NA=cache_NA * ureg.AU,
+            gamma_offset=0 * ureg.degree,
+            phi_offset=0 * ureg.degree,
+            sampling=sampling,
+        ).get_coupling(scatterer).to(ureg.watt).magnitude
+        for sampling in [50, 500, 5000]
+    ]
+
+    assert numpy.allclose(couplings, couplings[0], rtol=1e-12, atol=0), "On-axis photodiode coupling should not depend on the sampling."
+
+
+@pytest.mark.parametrize('diameter', [100, 2000, 8000] * ureg.nanometer, ids=['small', 'medium', 'large'])
+def test_on_axis_coupling_is_the_mesh_limit(source, diameter):
+    scatterer = get_scatterer('sphere', diameter, source)
+
+    def get_coupling(phi_offset):
+        detector = single.detector.Photodiode(
+            NA=0.9 * ureg.AU,
+            cache_NA=0.3 * ureg.AU,
+            gamma_offset=0 * ureg.degree,
+            phi_offset=phi_offset,
+            sampling=100_000,
+        )
+        return detector.get_coupling(scatterer).to(ureg.watt).magnitude
+
+    # A vanishing offset keeps the geometry but goes through the mesh
+    exact = get_coupling(0 * ureg.degree)
+    mesh = get_coupling(1e-9 * ureg.degree)
+
+    assert numpy.isclose(mesh, exact, rtol=1e-3, atol=0), "Mesh coupling should converge to the on-axis integral."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+
+@pytest.fixture
+def source_single():
+    return single.source.PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+
+def get_spheres(source, diameter, index, accuracy_target):
+    kwargs = dict(diameter=diameter, property=index, medium_property=1.0 * ureg.RIU, source=source)
+    exact = single.scatterer.Sphere(**kwargs)
+    approximate = single.scatterer.Sphere(**kwargs, accuracy_target=accuracy_target)
+    return exact, approximate
+
+
+@pytest.mark.parametrize('index', [1.5, 1.4 + 0.01j, 0.2 + 3.5j] * ureg.RIU, ids=['dielectric', 'absorbing', 'metal'])
+@pytest.mark.parametrize('diameter', [5, 20, 50] * ureg.nanometer, ids=['5nm', '20nm', '50nm'])
+def test_rayleigh_regime(source_single, diameter, index):
+    exact, rayleigh = get_spheres(source_single, diameter, index, accuracy_target=1e-6)
+
+    assert exact.regime == 'mie'
+    assert rayleigh.regime == 'rayleigh'
+
+    for measure in ['Qsca', 'Qext', 'Qback', 'g']:
+        value, reference = getattr(rayleigh, measure).magnitude, getattr(exact, measure).magnitude
+        assert numpy.isclose(value, reference, rtol=1e-6, atol=0), f"Mismatch on {measure} in the Rayleigh regime."
+
+    atol = 1e-6 * exact.Qext.magnitude
+    assert numpy.isclose(rayleigh.Qabs.magnitude, exact.Qabs.magnitude, rtol=1e-6, atol=atol), "Mismatch on Qabs in the Rayleigh regime."
+
+    assert numpy.isclose(abs(rayleigh.an[0]), abs(exact.an[0]), rtol=1e-9, atol=0), "Mismatch on a1 in the Rayleigh regime."
+
+
+@pytest.mark.parametrize('index', [1.01, 1.05 + 0.001j, 1.02 + 0.01j] * ureg.RIU, ids=['dielectric', 'weakly_absorbing', 'absorbing'])
+def test_anomalous_diffraction_regime(source_single, index):
+    exact, ada = get_spheres(source_single, 1 * ureg.millimeter, index, accuracy_target=0.1)
+
+    assert ada.regime == 'anomalous_diffraction'
+
+    for measure in ['Qext', 'Qsca']:
+        value, reference = getattr(ada, measure).magnitude, getattr(exact, measure).magnitude
+        assert numpy.isclose(value, reference, rtol=2e-2, atol=0), f"Mismatch on {measure} in the anomalous-diffraction regime."
+
+    # Quantities without an anomalous-diffraction form fall back to the exact coefficients
+    assert numpy.isclose(ada.g.magnitude, exact.g.magnitude, rtol=1e-12, atol=0), "Asymmetry factor should use the exact coefficients."
+
+
+def test_regime_falls_back_to_mie(source_single):
+    _, sphere = get_spheres(source_single, 500 * ureg.nanometer, 1.5 * ureg.RIU, accuracy_target=1e-6)
+    assert sphere.regime == 'mie'
+
+    _, sphere = get_spheres(source_single, 1 * ureg.millimeter, 1.5 * ureg.RIU, accuracy_target=1e-3)
+    assert sphere.regime == 'mie'
+
+
+def test_regime_measure_experiment():
+    source = experiment.source.PlaneWave(
+        wavelength=1000 * ureg.nanometer,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[10, 500, 2_000_000] * ureg.nanometer,
+        property=1.01 * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+        accuracy_target=0.05,
+    )
+
+    setup = Setup(scatterer=scatterer, source=source)
+    regime = setup.get('regime', add_units=False).values.squeeze()
+
+    assert numpy.array_equal(regime, [1, 0, 2]), "Unexpected regime for each point."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import single, experiment
+from PyMieSim.experiment import Setup
+
+measures = ['Qsca', 'Qext', 'Qback', 'Qforward', 'g', 'Cext']
+
+
+@pytest.mark.parametrize('index', [1.5, 1.4 + 0.02j, 0.2 + 3.5j] * ureg.RIU, ids=['dielectric', 'absorbing', 'metal'])
+def test_batch_matches_single(index):
+    diameters = numpy.geomspace(20, 20_000, 60) * ureg.nanometer
+    wavelength = 800 * ureg.nanometer
+
+    source = experiment.source.PlaneWave(
+        wavelength=wavelength,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+    scatterer = experiment.scatterer.Sphere(
+        diameter=diameters,
+        property=index,
+        medium_property=1.33 * ureg.RIU,
+        source=source,
+    )
+
+    setup = Setup(scatterer=scatterer, source=source)
+    batch = setup.get(*measures, add_units=False)
+
+    single_source = single.source.PlaneWave(
+        wavelength=wavelength,
+        polarization=0 * ureg.degree,
+        amplitude=1 * ureg.volt / ureg.meter,
+    )
+
+    for measure in measures:
+        values = batch[measure].values.squeeze()
+
+        reference = [
+            getattr(
+                single.scatterer.Sphere(diameter=diameter, property=index, medium_property=1.33 * ureg.RIU, source=single_source),
+                measure
+            ).to_base_units().magnitude
+            for diameter in diameters
+        ]
+
+        assert numpy.allclose(values, reference, rtol=1e-8, atol=0), f"Mismatch between batched and single-sphere {measure}."
+
+
+def test_batch_layout_with_detector():
+    source = experiment.source.Gaussian(
+        wavelength=[600, 1000] * ureg.nanometer,
+        polarization=[0, 90] * ureg.degree,
+        optical_power=1e-3 * ureg.watt,
+        NA=0.2 * ureg.AU,
+    )
+
+    scatterer = experiment.scatterer.Sphere(
+        diameter=[100, 500, 2000] * ureg.nanometer,
+        property=[1.4, 1.6] * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    )
+
+    detector = experiment.detector.Photodiode(
+        NA=[0.1, 0.2] * ureg.AU,
+        phi_offset=0 * ureg.degree,
+        gamma_offset=0 * ureg.degree,
+        sampling=100 * ureg.AU,
+        polarization_filter=None,
+    )
+
+    with_detector = Setup(scatterer=scatterer, source=source, detector=detector).get('Qsca', as_numpy=True)
+    without_detector = Setup(scatterer=scatterer, source=source).get('Qsca', as_numpy=True)
+
+    # The detector NA is the last axis, every detector sees the same scatterer efficiency
+    for index in range(2):
+        assert numpy.array_equal(with_detector[..., index], without_detector), "Batched values should be repeated along the detector axes."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import numpy
+import pytest
+from TypedUnit import ureg
+
+from PyMieSim import experiment
+from PyMieSim.experiment import Setup
+from PyMieSim.binary.interface_experiment import EXPERIMENT
+
+source = experiment.source.Gaussian(
+    wavelength=[600] * ureg.nanometer,
+    polarization=0 * ureg.degree,
+    optical_power=1e-3 * ureg.watt,
+    NA=0.2 * ureg.AU,
+)
+
+# Size parameters above 3000: the scratch of a single evaluation exceeds the smallest workspace block
+scatterers = [
+    experiment.scatterer.Sphere(
+        diameter=[650] * ureg.micrometer,
+        property=[1.5, 1.4 + 0.01j] * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    ),
+    experiment.scatterer.Cylinder(
+        diameter=[650] * ureg.micrometer,
+        property=[1.5, 1.4 + 0.01j] * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    ),
+    experiment.scatterer.CoreShell(
+        core_diameter=[650] * ureg.micrometer,
+        shell_thickness=200 * ureg.nanometer,
+        core_property=[1.5, 1.4 + 0.01j] * ureg.RIU,
+        shell_property=1.6 * ureg.RIU,
+        medium_property=1.0 * ureg.RIU,
+        source=source,
+    ),
+]
+
+
+@pytest.mark.parametrize('scatterer', scatterers, ids=[f"Scatterer:{s.__class__.__name__}" for s in scatterers])
+def test_grown_blocks_are_reused(scatterer):
+    # Off axis, the photodiode integrates S1 and S2 from at least 4 scratch arrays of max_order > 3000 doubles
+    detector = experiment.detector.Photodiode(
+        NA=0.3 * ureg.AU,
+        phi_offset=30 * ureg.degree,
+        gamma_offset=0 * ureg.degree,
+        sampling=300 * ureg.AU,
+        polarization_filter=None,
+    )
+
+    setup = Setup(scatterer=scatterer, source=source, detector=detector)
+
+    first = setup.get('coupling', as_numpy=True)
+    statistics = EXPERIMENT.get_workspace_statistics()
+
+    assert statistics['reserved_bytes'] >= 4 * 3000 * 8 > 1 << 16, "The workspace of some thread should have grown past its first block."
+
+    second = setup.get('coupling', as_numpy=True)
+
+    assert EXPERIMENT.get_workspace_statistics()['block_allocations'] == statistics['block_allocations'], \
+        "Repeated evaluations should reuse the grown workspace blocks."
+    assert numpy.array_equal(first, second), "Results should not depend on the state of the workspace."
+
+
+def get_heap_allocations(setup):
+    setup.get('coupling', as_numpy=True)  # grows the workspaces and caches the detector geometry
+
+    before = EXPERIMENT.get_workspace_statistics()['heap_allocations']
+    setup.get('coupling', as_numpy=True)
+    return EXPERIMENT.get_workspace_statistics()['heap_allocations'] - before
+
+
+@pytest.mark.skipif(
+    EXPERIMENT.get_workspace_statistics()['heap_allocations'] is None,
+    reason="Heap allocations are only counted in builds configured with PYMIESIM_COUNT_HEAP_ALLOCATIONS=ON."
+)
+def test_heap_allocations_do_not_scale_with_scatterer():
+    # Same number of points: orders and mesh points only size the scratch buffers, which come from the workspaces
+    setups = [
+        Setup(
+            scatterer=experiment.scatterer.Sphere(
+                diameter=[diameter] * ureg.micrometer,
+                property=numpy.linspace(1.4, 1.6, 8) * ureg.RIU,
+                medium_property=1.0 * ureg.RIU,
+                source=source,
+            ),
+            source=source,
+            detector=experiment.detector.Photodiode(
+                NA=0.3 * ureg.AU,
+                phi_offset=30 * ureg.degree,
+                gamma_offset=0 * ureg.degree,
+                sampling=sampling * ureg.AU,
+                polarization_filter=None,
+            ),
+        )
+        for diameter, sampling in [(2, 300), (650, 3000)]
+    ]
+
+    small, large = [get_heap_allocations(setup) for setup in setups]
+
+    assert small == large, f"Heap allocations per sweep grow with the scatterer and the mesh: {small} against {large}."
+
+
+if __name__ == "__main__":
+    pytest.main(["-W error", __file__])